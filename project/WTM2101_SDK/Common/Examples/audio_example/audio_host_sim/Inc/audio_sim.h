@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    audio_sim.h
+  * @brief   Header for audio_sim.c module.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+#ifndef AUDIO_SIM_H
+#define AUDIO_SIM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "wtm2101_config.h"
+
+/*
+ * file backed stand-in of the audio, dma and interrupt layer under hal_audio,
+ * on a virtual cpu clock.
+ *
+ * each audio channel captures the pcm of the input file at its sample rate
+ * from the moment it is enabled, two samples per word, and zeros after the
+ * end. in ram mode the words go round the ram of Buffer_Ram_Depth words and
+ * the frame valid interrupt comes every Buffer_Ram_Frame_Move words, a read
+ * of RAMxDATA gets the word that is in the ram at that cycle, so a late dma
+ * reads newer data the way the hardware does. in fifo mode the words go into
+ * the 8 word fifo, the half full interrupt asks for 4 and the words that
+ * find it full are lost. a dma transfer moves one word every dma_word_cycles.
+ *
+ * an interrupt is taken irq_entry plus up to irq_jitter cycles after its
+ * event, outside __disable_irq, outside a running handler and outside the
+ * stall windows, at the stand-in calls and in audio_sim_run. a handler takes
+ * isr_cycles. a dma start on the audio ram from thread mode runs the clock
+ * to the end of its interrupt, as hal_audio_read spins on it there.
+ *
+ * the buffers the dma writes to go through 32 bits addresses, the harness
+ * is linked -no-pie and pvPortMalloc takes from a static pool, so they are
+ * all under 4 GB.
+ */
+
+#define AUDIO_SIM_CHANNELS              (3)             /*AUDIO_CHANNEL0..2*/
+#define AUDIO_SIM_FIFO_DEPTH            (8)             /*words*/
+
+typedef struct{
+  uint32_t core_hz;                     /*the virtual cpu clock, __get_rv_cycle counts it*/
+  uint32_t irq_entry;                   /*cycles from the event to the handler*/
+  uint32_t irq_jitter;                  /*up to these cycles more, random for each interrupt*/
+  uint32_t isr_cycles;                  /*cycles a handler takes*/
+  uint32_t dma_word_cycles;             /*cycles for each word the dma moves*/
+  uint32_t stall_period;                /*every stall_period cycles the interrupts are held off for stall_cycles,*/
+  uint32_t stall_cycles;                /*a long critical section or a higher priority task, 0 none*/
+  uint32_t seed;                        /*of the jitter*/
+  FunctionalState realtime;             /*ENABLE to pace the virtual clock with the wall clock*/
+}Audio_Sim_Config;
+
+typedef struct{
+  uint64_t irqs;                        /*handlers run*/
+  uint64_t irq_delay_max;               /*cycles from an event to its handler*/
+  uint32_t fifo_high_water[AUDIO_SIM_CHANNELS];   /*words*/
+  uint32_t fifo_overflow[AUDIO_SIM_CHANNELS];     /*words lost, the fifo was full*/
+  uint32_t ram_high_water[AUDIO_SIM_CHANNELS];    /*words, from a word read to the newest one captured*/
+  uint32_t ram_overwritten[AUDIO_SIM_CHANNELS];   /*words read after the capture came round over them*/
+  uint32_t ram_missed[AUDIO_SIM_CHANNELS];        /*frame valid events with the last one not cleared*/
+}Audio_Sim_Stats;
+
+/**
+* @brief  Set up the stand-in, before hal_audio_init
+* @param  config: NULL for the defaults, 24.576 MHz, 40 cycles entry, no jitter, 200 cycles handlers, 4 cycles a word
+* @param  pcm: the input, interleaved. audio channel 1 takes pcm channel 1 when there is one, the others pcm channel 0
+* @param  frames: the input frames
+* @param  channels: the input channels
+* @param  sample_rate: the capture rate
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int audio_sim_init(const Audio_Sim_Config *config,const int16_t *pcm,uint32_t frames,uint32_t channels,uint32_t sample_rate);
+
+/**
+* @brief  Called at the end of each handler, in the interrupt, e.g. to sample the buffer levels
+*/
+extern void audio_sim_set_irq_hook(void(*hook)(void));
+
+/**
+* @brief  The application works for cycles, the interrupts are taken as they come due
+*/
+extern void audio_sim_run(uint32_t cycles);
+
+/**
+* @brief  The cycle the sample was captured at
+* @param  channel: AUDIO_CHANNEL0..2
+* @param  sample: the sample since the channel was enabled
+*/
+extern uint64_t audio_sim_sample_cycle(uint8_t channel,uint32_t sample);
+
+/**
+* @brief  The samples captured by the channel since it was enabled
+*/
+extern uint32_t audio_sim_captured(uint8_t channel);
+
+extern void audio_sim_get_stats(Audio_Sim_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
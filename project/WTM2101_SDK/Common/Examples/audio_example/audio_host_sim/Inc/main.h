@@ -0,0 +1,36 @@
+/**
+  ******************************************************************************
+  * @file    main.h
+  * @brief   Header for main.c module.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+#ifndef __MAIN_H__
+#define __MAIN_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wtm2101_config.h"
+#include "hal_audio.h"
+
+#include "audio_sim.h"
+#include "wav_file.h"
+
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
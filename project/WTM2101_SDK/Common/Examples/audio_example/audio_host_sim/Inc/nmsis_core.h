@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    nmsis_core.h
+  * @brief   Host stand-in for the N307 core header, for the audio host harness.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+#ifndef __NMSIS_CORE_H__
+#define __NMSIS_CORE_H__
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* WTM2101.h includes this header after the peripheral declarations, the
+   peripherals the audio path touches are moved into host memory here and
+   the driver functions on them are the file backed stand-ins of audio_sim.c */
+#undef AUD
+#undef DMA
+#undef PMU
+#undef RCC
+#undef GPIOA
+
+extern AUD_TypeDef audio_sim_aud;
+extern DMA_TypeDef audio_sim_dma;
+extern PMU_TypeDef audio_sim_pmu;
+extern RCC_TypeDef audio_sim_rcc;
+extern GPIO_TypeDef audio_sim_gpio;
+
+#define AUD                             (&audio_sim_aud)
+#define DMA                             (&audio_sim_dma)
+#define PMU                             (&audio_sim_pmu)
+#define RCC                             (&audio_sim_rcc)
+#define GPIOA                           (&audio_sim_gpio)
+
+typedef enum ECLIC_TRIGGER {
+    ECLIC_LEVEL_TRIGGER = 0x0,
+    ECLIC_POSTIVE_EDGE_TRIGGER = 0x1,
+    ECLIC_NEGTIVE_EDGE_TRIGGER = 0x3,
+    ECLIC_MAX_TRIGGER = 0x3
+} ECLIC_TRIGGER_Type;
+
+extern void ECLIC_EnableIRQ(IRQn_Type IRQn);
+extern void ECLIC_DisableIRQ(IRQn_Type IRQn);
+extern void ECLIC_SetPendingIRQ(IRQn_Type IRQn);
+extern void ECLIC_ClearPendingIRQ(IRQn_Type IRQn);
+extern void ECLIC_SetTrigIRQ(IRQn_Type IRQn, uint32_t trig);
+extern void ECLIC_SetPriorityIRQ(IRQn_Type IRQn, uint8_t pri);
+extern void ECLIC_SetLevelIRQ(IRQn_Type IRQn, uint8_t lvl_abs);
+
+/* the interrupts are taken at the stand-in calls and in audio_sim_run */
+extern void __enable_irq(void);
+extern void __disable_irq(void);
+extern void __WFI(void);
+extern uint64_t __get_rv_cycle(void);
+
+/* only MSTATUS.MIE is modelled, it is the mask of __disable_irq */
+typedef unsigned long rv_csr_t;
+
+#define CSR_MSTATUS                     0x300
+#define MSTATUS_MIE                     0x00000008
+
+extern rv_csr_t audio_sim_mstatus_read_clear(rv_csr_t val);
+extern void audio_sim_mstatus_set(rv_csr_t val);
+
+#define __RV_CSR_READ_CLEAR(csr,val)    audio_sim_mstatus_read_clear(val)
+#define __RV_CSR_CLEAR(csr,val)         ((void)audio_sim_mstatus_read_clear(val))
+#define __RV_CSR_SET(csr,val)           audio_sim_mstatus_set(val)
+
+#define __enable_mcycle_counter()
+#define __NOP()
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NMSIS_CORE_H__ */
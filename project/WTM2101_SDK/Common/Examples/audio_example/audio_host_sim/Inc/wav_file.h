@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    wav_file.h
+  * @brief   Header for wav_file.c module.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+#ifndef WAV_FILE_H
+#define WAV_FILE_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include <stdint.h>
+
+/**
+* @brief  Read a 16 bits pcm wav
+* @param  path: the file
+* @param  pcm: the samples, interleaved, in a buffer from malloc the caller frees
+* @param  frames: the frames read
+* @param  channels: the channels of the file
+* @param  sample_rate: the rate of the file
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int wav_file_read(const char *path,int16_t **pcm,uint32_t *frames,uint32_t *channels,uint32_t *sample_rate);
+
+/**
+* @brief  Write a 16 bits pcm wav
+* @param  pcm: the samples, interleaved
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int wav_file_write(const char *path,const int16_t *pcm,uint32_t frames,uint32_t channels,uint32_t sample_rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,26 @@
+/**
+  ******************************************************************************
+  * @file    WTM2101_config.h
+  * @brief   Library configuration file.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef __WTM2101_CONFIG_H
+#define __WTM2101_CONFIG_H
+
+/* Includes ------------------------------------------------------------------*/
+/* Only the drivers of the capture path, audio_sim.c stands in for them */
+#include "WTM2101.h"
+
+#include "audio.h"
+#include "dma.h"
+#include "gpio.h"
+#include "pmu.h"
+#include "rcc.h"
+
+#endif /* __WTM2101_CONFIG_H */
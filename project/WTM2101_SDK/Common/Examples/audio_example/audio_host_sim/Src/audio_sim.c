@@ -0,0 +1,819 @@
+/**
+  ******************************************************************************
+  * @file    audio_sim.c
+  * @brief   File backed stand-in of the audio, dma and interrupt layer for the
+  *          audio host harness.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio_sim.h"
+#include "wtm2101_mmap.h"
+
+#define AUDIO_SIM_DMA_CHANNELS          (6)
+#define AUDIO_SIM_FIFO_HALF             (AUDIO_SIM_FIFO_DEPTH / 2)
+#define AUDIO_SIM_HEAP_SIZE             (512 * 1024)
+#define AUDIO_SIM_NEVER                 (~(uint64_t)0)
+
+extern void AUDIO_IRQHandler(void);
+extern void DMA_IRQHandler(void);
+
+AUD_TypeDef audio_sim_aud;
+DMA_TypeDef audio_sim_dma;
+PMU_TypeDef audio_sim_pmu;
+RCC_TypeDef audio_sim_rcc;
+GPIO_TypeDef audio_sim_gpio;
+
+typedef struct{
+  FunctionalState enable;
+  uint8_t mode;                                 /*AUDIO_CHANNEL_TRANSMIT_RAM_MODE or AUDIO_CHANNEL_TRANSMIT_FIFO_MODE*/
+  uint64_t start;                               /*the cycle the channel was enabled*/
+  uint32_t words;                               /*captured since then*/
+  uint32_t depth,frame_move,length;             /*ram, words*/
+  FunctionalState ram_irq,fifo_irq;
+  uint32_t ram_status;
+  uint32_t ram_read;                            /*the word RAMxDATA reads next*/
+  uint32_t fifo[AUDIO_SIM_FIFO_DEPTH];          /*the captured words in the fifo*/
+  uint32_t fifo_head,fifo_count;
+}Audio_Sim_Channel;
+
+typedef struct{
+  FunctionalState enable;                       /*a transfer is running*/
+  FunctionalState int_en;
+  uint32_t src,dst,block;
+  uint64_t begin,end;
+}Audio_Sim_Dma;
+
+typedef struct{
+  FunctionalState enable;
+  uint8_t pending;
+  uint64_t event;                               /*the cycle of the event*/
+  uint64_t due;                                 /*the first cycle the handler may run*/
+}Audio_Sim_Irq;
+
+typedef enum{
+  AUDIO_SIM_EVENT_NONE = 0,
+  AUDIO_SIM_EVENT_WORD,
+  AUDIO_SIM_EVENT_DMA,
+  AUDIO_SIM_EVENT_IRQ,
+}Audio_Sim_Event;
+
+static const int audio_sim_irqs[] = {DMA_IRQn,AUDIO_IRQn};
+
+static Audio_Sim_Config sim_config;
+static const int16_t *sim_pcm;
+static uint32_t sim_frames,sim_pcm_channels,sim_rate;
+static uint64_t sim_now;
+static uint32_t sim_rand;
+static FunctionalState sim_masked;
+static FunctionalState sim_in_isr;
+static Audio_Sim_Channel sim_channel[AUDIO_SIM_CHANNELS];
+static Audio_Sim_Dma sim_dma[AUDIO_SIM_DMA_CHANNELS];
+static uint32_t sim_dma_status;
+static Audio_Sim_Irq sim_irq[SOC_INT_MAX];
+static void(*sim_irq_hook)(void);
+static Audio_Sim_Stats sim_stats;
+static struct timespec sim_wall;
+static uint8_t sim_heap[AUDIO_SIM_HEAP_SIZE] __attribute__((aligned(8)));
+static uint32_t sim_heap_used;
+
+static int sim_channel_index(uint8_t channel)
+{
+    if(channel == AUDIO_CHANNEL0)
+        return 0;
+    if(channel == AUDIO_CHANNEL1)
+        return 1;
+    if(channel == AUDIO_CHANNEL2)
+        return 2;
+    return -1;
+}
+
+static Audio_Sim_Channel* sim_channel_get(uint8_t channel)
+{
+    int index = sim_channel_index(channel);
+
+    return index < 0 ? NULL : &sim_channel[index];
+}
+
+static Audio_Sim_Dma* sim_dma_get(uint8_t chl)
+{
+    for(int i = 0;i < AUDIO_SIM_DMA_CHANNELS;i++)
+    {
+        if(chl == (1 << i))
+            return &sim_dma[i];
+    }
+    return NULL;
+}
+
+/*the channel whose ram the address reads, -1 for memory*/
+static int sim_ram_source(uint32_t addr)
+{
+    if(addr == (uint32_t)(uintptr_t)&audio_sim_aud.RAM0DATA)
+        return 0;
+    if(addr == (uint32_t)(uintptr_t)&audio_sim_aud.RAM1DATA)
+        return 1;
+    return -1;
+}
+
+static int16_t sim_sample(int index,uint32_t n)
+{
+    uint32_t c = (index == 1 && sim_pcm_channels > 1) ? 1 : 0;
+
+    if(n >= sim_frames)
+        return 0;
+    return sim_pcm[(size_t)n * sim_pcm_channels + c];
+}
+
+/*two samples a word, the first one in the low half*/
+static uint32_t sim_word(int index,uint32_t w)
+{
+    return (uint16_t)sim_sample(index,2 * w) | ((uint32_t)(uint16_t)sim_sample(index,2 * w + 1) << 16);
+}
+
+static uint64_t sim_sample_end(const Audio_Sim_Channel *ch,uint64_t n)
+{
+    return ch->start + ((n + 1) * sim_config.core_hz + sim_rate - 1) / sim_rate;
+}
+
+static uint32_t sim_words_at(const Audio_Sim_Channel *ch,uint64_t t)
+{
+    if(!ch->enable || t < ch->start)
+        return 0;
+    return (uint32_t)((t - ch->start) * sim_rate / sim_config.core_hz / 2);
+}
+
+static uint32_t sim_random(void)
+{
+    sim_rand ^= sim_rand << 13;
+    sim_rand ^= sim_rand >> 17;
+    sim_rand ^= sim_rand << 5;
+    return sim_rand;
+}
+
+/*the first cycle from t outside the stall windows*/
+static uint64_t sim_unstalled(uint64_t t)
+{
+    if(sim_config.stall_cycles && sim_config.stall_period)
+    {
+        uint64_t ofs = t % sim_config.stall_period;
+
+        if(ofs < sim_config.stall_cycles)
+            t += sim_config.stall_cycles - ofs;
+    }
+    return t;
+}
+
+static void sim_raise(int irqn)
+{
+    Audio_Sim_Irq *irq = &sim_irq[irqn];
+
+    if(irq->pending)
+        return;
+    irq->pending = 1;
+    irq->event = sim_now;
+    irq->due = sim_now + sim_config.irq_entry;
+    if(sim_config.irq_jitter)
+        irq->due += sim_random() % (sim_config.irq_jitter + 1);
+}
+
+/*the word the ram holds at cycle t in the place of word r*/
+static uint32_t sim_ram_read(int index,uint32_t r,uint64_t t)
+{
+    Audio_Sim_Channel *ch = &sim_channel[index];
+    uint32_t written = sim_words_at(ch,t);
+
+    if(written <= r)
+    {
+        /*not captured yet, the ram still has the round before*/
+        sim_stats.ram_overwritten[index]++;
+        return r >= ch->depth ? sim_word(index,r - ch->depth) : 0;
+    }
+    if(written - r > sim_stats.ram_high_water[index])
+        sim_stats.ram_high_water[index] = written - r;
+    if(written - r > ch->depth)
+    {
+        sim_stats.ram_overwritten[index]++;
+        return sim_word(index,r + (written - r - 1) / ch->depth * ch->depth);
+    }
+    return sim_word(index,r);
+}
+
+static void sim_capture_word(int index)
+{
+    Audio_Sim_Channel *ch = &sim_channel[index];
+    uint32_t w = ch->words++;
+
+    if(ch->mode == AUDIO_CHANNEL_TRANSMIT_RAM_MODE)
+    {
+        if(ch->words >= ch->length && (ch->words - ch->length) % ch->frame_move == 0)
+        {
+            if(ch->ram_status & AUDIO_RAM_FRAME_VLD_INTERRUPT)
+                sim_stats.ram_missed[index]++;
+            ch->ram_status |= AUDIO_RAM_FRAME_VLD_INTERRUPT;
+            ch->ram_read = ch->words - ch->length;
+            if(ch->ram_irq == ENABLE)
+                sim_raise(AUDIO_IRQn);
+        }
+    }
+    else
+    {
+        if(ch->fifo_count == AUDIO_SIM_FIFO_DEPTH)
+        {
+            sim_stats.fifo_overflow[index]++;
+            return;
+        }
+        ch->fifo[(ch->fifo_head + ch->fifo_count) % AUDIO_SIM_FIFO_DEPTH] = w;
+        ch->fifo_count++;
+        if(ch->fifo_count > sim_stats.fifo_high_water[index])
+            sim_stats.fifo_high_water[index] = ch->fifo_count;
+        if(ch->fifo_count == AUDIO_SIM_FIFO_HALF && ch->fifo_irq == ENABLE)
+            sim_raise(AUDIO_IRQn);
+    }
+}
+
+static void sim_dma_finish(Audio_Sim_Dma *d)
+{
+    int index = sim_ram_source(d->src);
+
+    for(uint32_t k = 0;k < d->block;k++)
+    {
+        uint32_t word;
+
+        if(index >= 0)
+            word = sim_ram_read(index,sim_channel[index].ram_read++,d->begin + (uint64_t)k * sim_config.dma_word_cycles);
+        else
+            memcpy(&word,(const uint8_t *)(uintptr_t)d->src + k * 4,4);
+        memcpy((uint8_t *)(uintptr_t)d->dst + k * 4,&word,4);
+    }
+    d->enable = DISABLE;
+    sim_dma_status |= 1u << (d - sim_dma);
+    if(d->int_en == ENABLE)
+        sim_raise(DMA_IRQn);
+}
+
+static uint64_t sim_irq_time(int irqn)
+{
+    Audio_Sim_Irq *irq = &sim_irq[irqn];
+
+    if(!irq->pending || irq->enable != ENABLE)
+        return AUDIO_SIM_NEVER;
+    return sim_unstalled(irq->due > sim_now ? irq->due : sim_now);
+}
+
+static void sim_step(uint64_t target,FunctionalState irqs);
+
+static void sim_take_irq(int irqn)
+{
+    Audio_Sim_Irq *irq = &sim_irq[irqn];
+
+    irq->pending = 0;
+    sim_stats.irqs++;
+    if(sim_now - irq->event > sim_stats.irq_delay_max)
+        sim_stats.irq_delay_max = sim_now - irq->event;
+
+    sim_in_isr = ENABLE;
+    if(irqn == AUDIO_IRQn)
+        AUDIO_IRQHandler();
+    else if(irqn == DMA_IRQn)
+        DMA_IRQHandler();
+    if(sim_irq_hook != NULL)
+        sim_irq_hook();
+    sim_step(sim_now + sim_config.isr_cycles,DISABLE);
+    sim_in_isr = DISABLE;
+
+    /*the half full is a level, it stays up while the fifo has 4 words*/
+    for(int i = 0;i < AUDIO_SIM_CHANNELS;i++)
+    {
+        Audio_Sim_Channel *ch = &sim_channel[i];
+
+        if(ch->enable == ENABLE && ch->mode == AUDIO_CHANNEL_TRANSMIT_FIFO_MODE &&
+           ch->fifo_irq == ENABLE && ch->fifo_count >= AUDIO_SIM_FIFO_HALF)
+            sim_raise(AUDIO_IRQn);
+    }
+}
+
+static uint64_t sim_next_event(FunctionalState irqs,Audio_Sim_Event *kind,int *which)
+{
+    uint64_t next = AUDIO_SIM_NEVER;
+
+    *kind = AUDIO_SIM_EVENT_NONE;
+    for(int i = 0;i < AUDIO_SIM_CHANNELS;i++)
+    {
+        if(sim_channel[i].enable == ENABLE)
+        {
+            uint64_t t = sim_sample_end(&sim_channel[i],2 * (uint64_t)sim_channel[i].words + 1);
+
+            if(t < next)
+            {
+                next = t;
+                *kind = AUDIO_SIM_EVENT_WORD;
+                *which = i;
+            }
+        }
+    }
+    for(int i = 0;i < AUDIO_SIM_DMA_CHANNELS;i++)
+    {
+        if(sim_dma[i].enable == ENABLE && sim_dma[i].end < next)
+        {
+            next = sim_dma[i].end;
+            *kind = AUDIO_SIM_EVENT_DMA;
+            *which = i;
+        }
+    }
+    if(irqs == ENABLE && sim_masked == DISABLE && sim_in_isr == DISABLE)
+    {
+        for(int i = 0;i < (int)(sizeof(audio_sim_irqs) / sizeof(audio_sim_irqs[0]));i++)
+        {
+            uint64_t t = sim_irq_time(audio_sim_irqs[i]);
+
+            if(t < next)
+            {
+                next = t;
+                *kind = AUDIO_SIM_EVENT_IRQ;
+                *which = audio_sim_irqs[i];
+            }
+        }
+    }
+    return next;
+}
+
+/*the events up to the target cycle in order, irqs DISABLE leaves the interrupts pending*/
+static void sim_step(uint64_t target,FunctionalState irqs)
+{
+    for(;;)
+    {
+        Audio_Sim_Event kind;
+        int which = 0;
+        uint64_t t = sim_next_event(irqs,&kind,&which);
+
+        if(kind == AUDIO_SIM_EVENT_NONE || (t > target && t > sim_now))
+            break;
+        if(t > sim_now)
+            sim_now = t;
+
+        if(kind == AUDIO_SIM_EVENT_WORD)
+            sim_capture_word(which);
+        else if(kind == AUDIO_SIM_EVENT_DMA)
+            sim_dma_finish(&sim_dma[which]);
+        else
+            sim_take_irq(which);
+    }
+    if(sim_now < target)
+        sim_now = target;
+}
+
+/*a stand-in call from thread mode, the interrupts due now are taken*/
+static void sim_poll(void)
+{
+    if(sim_in_isr == DISABLE && sim_masked == DISABLE)
+        sim_step(sim_now,ENABLE);
+}
+
+int audio_sim_init(const Audio_Sim_Config *config,const int16_t *pcm,uint32_t frames,uint32_t channels,uint32_t sample_rate)
+{
+    if(pcm == NULL || frames == 0 || channels == 0 || sample_rate == 0)
+        return -1;
+
+    if(config != NULL)
+    {
+        sim_config = *config;
+    }
+    else
+    {
+        memset(&sim_config,0,sizeof(sim_config));
+        sim_config.core_hz = 24576000;
+        sim_config.irq_entry = 40;
+        sim_config.isr_cycles = 200;
+        sim_config.dma_word_cycles = 4;
+        sim_config.seed = 1;
+    }
+    if(sim_config.core_hz < sample_rate)
+        return -2;
+
+    sim_pcm = pcm;
+    sim_frames = frames;
+    sim_pcm_channels = channels;
+    sim_rate = sample_rate;
+    sim_now = 0;
+    sim_rand = sim_config.seed ? sim_config.seed : 1;
+    sim_masked = DISABLE;
+    sim_in_isr = DISABLE;
+    memset(sim_channel,0,sizeof(sim_channel));
+    for(int i = 0;i < AUDIO_SIM_CHANNELS;i++)
+    {
+        sim_channel[i].depth = 1;
+        sim_channel[i].frame_move = 1;
+        sim_channel[i].length = 1;
+    }
+    memset(sim_dma,0,sizeof(sim_dma));
+    sim_dma_status = 0;
+    memset(sim_irq,0,sizeof(sim_irq));
+    memset(&sim_stats,0,sizeof(sim_stats));
+    sim_heap_used = 0;
+    clock_gettime(CLOCK_MONOTONIC,&sim_wall);
+
+    return 1;
+}
+
+void audio_sim_set_irq_hook(void(*hook)(void))
+{
+    sim_irq_hook = hook;
+}
+
+void audio_sim_run(uint32_t cycles)
+{
+    sim_step(sim_now + cycles,ENABLE);
+
+    if(sim_config.realtime == ENABLE)
+    {
+        struct timespec now;
+        int64_t ahead_ns;
+
+        clock_gettime(CLOCK_MONOTONIC,&now);
+        ahead_ns = (int64_t)(sim_now * 1000000000.0 / sim_config.core_hz) -
+                   ((int64_t)(now.tv_sec - sim_wall.tv_sec) * 1000000000 + (now.tv_nsec - sim_wall.tv_nsec));
+        if(ahead_ns > 0)
+        {
+            struct timespec wait = {ahead_ns / 1000000000, ahead_ns % 1000000000};
+
+            nanosleep(&wait,NULL);
+        }
+    }
+}
+
+uint64_t audio_sim_sample_cycle(uint8_t channel,uint32_t sample)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    return ch == NULL ? 0 : sim_sample_end(ch,sample);
+}
+
+uint32_t audio_sim_captured(uint8_t channel)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    return ch == NULL ? 0 : ch->words * 2;
+}
+
+void audio_sim_get_stats(Audio_Sim_Stats *stats)
+{
+    *stats = sim_stats;
+}
+
+/* ------------------------------- the core ------------------------------- */
+
+void __disable_irq(void)
+{
+    if(sim_in_isr == DISABLE)
+        sim_masked = ENABLE;
+}
+
+void __enable_irq(void)
+{
+    if(sim_in_isr == DISABLE)
+    {
+        sim_masked = DISABLE;
+        sim_poll();
+    }
+}
+
+rv_csr_t audio_sim_mstatus_read_clear(rv_csr_t val)
+{
+    rv_csr_t mstatus = (sim_in_isr == DISABLE && sim_masked == DISABLE) ? MSTATUS_MIE : 0;
+
+    if(val & MSTATUS_MIE)
+        __disable_irq();
+    return mstatus;
+}
+
+void audio_sim_mstatus_set(rv_csr_t val)
+{
+    if(val & MSTATUS_MIE)
+        __enable_irq();
+}
+
+/*sleeps to the first interrupt that can be taken, it is taken after __enable_irq*/
+void __WFI(void)
+{
+    for(;;)
+    {
+        Audio_Sim_Event kind;
+        int which;
+        uint64_t t;
+
+        for(int i = 0;i < (int)(sizeof(audio_sim_irqs) / sizeof(audio_sim_irqs[0]));i++)
+        {
+            t = sim_irq_time(audio_sim_irqs[i]);
+            if(t != AUDIO_SIM_NEVER)
+            {
+                sim_step(t,DISABLE);
+                return;
+            }
+        }
+
+        t = sim_next_event(DISABLE,&kind,&which);
+        if(kind == AUDIO_SIM_EVENT_NONE)
+            return;
+        sim_step(t,DISABLE);
+    }
+}
+
+uint64_t __get_rv_cycle(void)
+{
+    return sim_now;
+}
+
+void ECLIC_EnableIRQ(IRQn_Type IRQn)
+{
+    sim_irq[IRQn].enable = ENABLE;
+    sim_poll();
+}
+
+void ECLIC_DisableIRQ(IRQn_Type IRQn)
+{
+    sim_irq[IRQn].enable = DISABLE;
+}
+
+void ECLIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+    sim_raise(IRQn);
+}
+
+void ECLIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+    sim_irq[IRQn].pending = 0;
+}
+
+void ECLIC_SetTrigIRQ(IRQn_Type IRQn,uint32_t trig)
+{
+}
+
+void ECLIC_SetPriorityIRQ(IRQn_Type IRQn,uint8_t pri)
+{
+}
+
+void ECLIC_SetLevelIRQ(IRQn_Type IRQn,uint8_t lvl_abs)
+{
+}
+
+/* ------------------------------- the audio ------------------------------ */
+
+void AUDIO_Set_Channel_Transmit_Cmd(AUD_TypeDef *audio,uint8_t channel,FunctionalState newstatus)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch == NULL)
+        return;
+    sim_poll();
+    if(newstatus == ENABLE && ch->enable == DISABLE)
+    {
+        ch->start = sim_now;
+        ch->words = 0;
+        ch->ram_status = 0;
+        ch->ram_read = 0;
+        ch->fifo_head = 0;
+        ch->fifo_count = 0;
+    }
+    ch->enable = newstatus;
+}
+
+void AUDIO_Set_Channel_Transmit_Mode(AUD_TypeDef *audio,uint8_t channel,uint8_t mode)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL)
+        ch->mode = mode;
+}
+
+void AUDIO_Set_RAM_Depth(AUD_TypeDef *audio,uint8_t channel,uint32_t depth)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL)
+        ch->depth = depth + 1;
+}
+
+void AUDIO_Set_RAM_Frame_Move(AUD_TypeDef *audio,uint8_t channel,uint32_t frame_move)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL)
+        ch->frame_move = frame_move + 1;
+}
+
+void AUDIO_Set_RAM_Length(AUD_TypeDef *audio,uint8_t channel,uint32_t length)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL)
+        ch->length = length + 1;
+}
+
+void AUDIO_Set_Ram_Interrupt_Mask(AUD_TypeDef *audio,uint8_t channel,uint32_t interrupt,FunctionalState newstatus)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL && (interrupt & AUDIO_RAM_FRAME_VLD_INTERRUPT))
+        ch->ram_irq = newstatus;
+}
+
+void AUDIO_Set_FIFO_Interrupt_Mask(AUD_TypeDef *audio,uint8_t channel,uint32_t interrupt,FunctionalState newstatus)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch == NULL || !(interrupt & AUDIO_FIFO_HALF_FULL_INTERRUPT))
+        return;
+    ch->fifo_irq = newstatus;
+    if(newstatus == ENABLE && ch->fifo_count >= AUDIO_SIM_FIFO_HALF)
+        sim_raise(AUDIO_IRQn);
+}
+
+uint32_t AUDIO_Get_Ram_Interrupt_Status(AUD_TypeDef *audio,uint8_t channel)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    return ch == NULL ? 0 : ch->ram_status;
+}
+
+void AUDIO_Clear_Ram_Interrupt(AUD_TypeDef *audio,uint8_t channel,uint32_t interrupt)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    if(ch != NULL)
+        ch->ram_status &= ~interrupt;
+}
+
+uint32_t AUDIO_Get_FIFO_Interrupt_Status(AUD_TypeDef *audio,uint8_t channel)
+{
+    Audio_Sim_Channel *ch = sim_channel_get(channel);
+
+    return (ch != NULL && ch->fifo_count >= AUDIO_SIM_FIFO_HALF) ? AUDIO_FIFO_HALF_FULL_INTERRUPT : 0;
+}
+
+uint32_t AUDIO_Read_Fifo_Data(AUD_TypeDef *audio,uint8_t channel)
+{
+    int index = sim_channel_index(channel);
+    Audio_Sim_Channel *ch;
+    uint32_t w;
+
+    if(index < 0)
+        return 0;
+    sim_poll();
+    ch = &sim_channel[index];
+    if(ch->fifo_count == 0)
+        return 0;
+    w = ch->fifo[ch->fifo_head];
+    ch->fifo_head = (ch->fifo_head + 1) % AUDIO_SIM_FIFO_DEPTH;
+    ch->fifo_count--;
+
+    return sim_word(index,w);
+}
+
+uint32_t AUDIO_Read_Ram_Data(AUD_TypeDef *audio,uint8_t channel)
+{
+    int index = sim_channel_index(channel);
+
+    if(index < 0)
+        return 0;
+    sim_poll();
+    return sim_ram_read(index,sim_channel[index].ram_read++,sim_now);
+}
+
+/*the configuration the capture model does not depend on*/
+void AUDIO_Set_Channel_Clock_Divider(AUD_TypeDef *audio,uint8_t divider) {}
+void AUDIO_Channel0_12bit_Pcm_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Analog_Emphasis_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Pre_Emphasis_Bypass_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Sinc5d2_Bypass_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Halfband_Bypass_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Highpass_Bypass_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Channel2_High_Bypass_Cmd(AUD_TypeDef *audio,FunctionalState newstatus) {}
+void AUDIO_Set_Channel_Gain_Configuration(AUD_TypeDef *audio,uint8_t channel,uint8_t value) {}
+void AUDIO_Set_Channel_Edge_Capture_Select(AUD_TypeDef *audio,uint8_t channel,uint8_t edge) {}
+void AUDIO_Set_Channel_Input_Select(AUD_TypeDef *audio,uint8_t channel,uint8_t select) {}
+void AUDIO_Set_CHANNEL0_PCM_ZEROPADDING(AUD_TypeDef *audio,uint8_t value) {}
+void AUDIO_Set_Channel0_Select_Pdm(AUD_TypeDef *audio,uint8_t pdm) {}
+void AUDIO_Set_Channel1_Select_Pdm(AUD_TypeDef *audio,uint8_t pdm) {}
+void AUDIO_Set_Clock_Switch_Configuration(AUD_TypeDef *audio,uint8_t channel,uint8_t clock_switch) {}
+void AUDIO_Set_Vad_Interrupt_Mask(AUD_TypeDef *audio,uint32_t interrupt,FunctionalState newstatus) {}
+void AUDIO_Reset_Vad(AUD_TypeDef *audio) {}
+void VAD_Config(void) {}
+
+/* -------------------------------- the dma ------------------------------- */
+
+void DMA_Init(DMA_TypeDef *dma,uint8_t chl,DMA_InitTypeDef *init_struct)
+{
+    Audio_Sim_Dma *d = sim_dma_get(chl);
+
+    if(d != NULL)
+    {
+        d->enable = DISABLE;
+        d->int_en = init_struct->int_en;
+    }
+}
+
+void DMA_Set_Addr(DMA_TypeDef *dma,uint8_t chl,uint32_t src_addr,uint32_t dst_addr,uint8_t block_size,uint32_t llp_addr)
+{
+    Audio_Sim_Dma *d = sim_dma_get(chl);
+
+    sim_poll();
+    if(d != NULL)
+    {
+        d->src = src_addr;
+        d->dst = dst_addr;
+        d->block = block_size;
+    }
+}
+
+void DMA_Set_Channel_Enable_Cmd(DMA_TypeDef *dma,uint8_t chl,FunctionalState NewState)
+{
+    Audio_Sim_Dma *d = sim_dma_get(chl);
+
+    if(d == NULL)
+        return;
+    if(NewState == DISABLE)
+    {
+        d->enable = DISABLE;
+        return;
+    }
+
+    d->enable = ENABLE;
+    d->begin = sim_now;
+    d->end = sim_now + (uint64_t)(d->block ? d->block : 1) * sim_config.dma_word_cycles;
+
+    /*thread mode spins on the transfer of the audio ram, up to its interrupt*/
+    if(sim_in_isr == DISABLE && sim_ram_source(d->src) >= 0)
+    {
+        sim_step(d->end,ENABLE);
+        while(sim_masked == DISABLE && sim_irq_time(DMA_IRQn) != AUDIO_SIM_NEVER)
+            sim_step(sim_irq_time(DMA_IRQn),ENABLE);
+    }
+}
+
+void DMA_Set_Transfer_Interrupt_Cmd(DMA_TypeDef *dma,uint8_t chl,FunctionalState NewState)
+{
+    Audio_Sim_Dma *d = sim_dma_get(chl);
+
+    if(d != NULL)
+        d->int_en = NewState;
+}
+
+int DMA_Get_Transfer_Interrupt_Status(DMA_TypeDef *dma)
+{
+    return sim_dma_status;
+}
+
+void DMA_Clear_Transfer_Interrupt_Cmd(DMA_TypeDef *dma,uint8_t chl)
+{
+    sim_dma_status &= ~(uint32_t)chl;
+}
+
+void DMA_Clear_All_Interrupt_Cmd(DMA_TypeDef *dma)
+{
+    sim_dma_status = 0;
+}
+
+void DMA_Set_Enable_Cmd(DMA_TypeDef *dma,FunctionalState NewState) {}
+
+/* ------------------------ clocks, pins and memory ----------------------- */
+
+void RCC_CLK_EN_Ctl(uint32_t CLK_EN,FunctionalState NewState) {}
+void RCC_Peri_Rst(uint32_t Peri) {}
+void RCC_Config_Dma_Requst0_Reuse(FunctionalState NewState) {}
+void RCC_Config_Dma_Requst1_Reuse(FunctionalState NewState) {}
+void PMU_Set_Audio_Clock_Cmd(PMU_TypeDef *pmu,FunctionalState NewState) {}
+void PMU_Set_Audio_Clock_Div_Num(PMU_TypeDef *pmu,uint8_t div_num) {}
+void PMU_Set_Ie_Msk(PMU_TypeDef *pmu,uint8_t ie_msk,FunctionalState NewState) {}
+void GPIO_Init(GPIO_TypeDef* GPIOx,GPIO_InitTypeDef* GPIO_InitStruct) {}
+void GPIO_DeInit(GPIO_TypeDef* GPIOx,uint32_t GPIO_Pin) {}
+
+uint32_t mmap_to_sys(uint32_t addr)
+{
+    return addr;
+}
+
+/*the dma takes 32 bits addresses, so the heap is a static pool, freed by audio_sim_init*/
+void *pvPortMalloc(size_t xWantedSize)
+{
+    void *p;
+
+    xWantedSize = (xWantedSize + 7) & ~(size_t)7;
+    if(xWantedSize > AUDIO_SIM_HEAP_SIZE - sim_heap_used)
+        return NULL;
+    p = &sim_heap[sim_heap_used];
+    sim_heap_used += xWantedSize;
+
+    return p;
+}
+
+void vPortFree(void *pv)
+{
+}
@@ -0,0 +1,401 @@
+/**
+  ******************************************************************************
+  * @file    main.c
+  * @brief   This example runs the audio capture path on the host. The input
+             wav, or generated noise, is captured through the stand-ins of
+             audio_sim.c into hal_audio_read, the ring or the async read, each
+             frame is matched against the input for dropped, repeated and
+             corrupt data, and its latency and the buffer high-water marks
+             are reported.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+/*
+ * build, in this directory:
+ *   C=../../..
+ *   gcc -O2 -no-pie -IInc -I$C/Libraries/Device/WITIN/WTM2101/Include -I$C/Libraries/WTM2101_StdPeriph_Lib/inc
+ *       -I$C/Libraries/WTM2101_Syslib/Inc -I$C/Libraries/HAL_Driver/inc -I$C/Middlewares/ring_cache
+ *       -I$C/Libraries/NMSIS/Core/Include Src/main.c Src/audio_sim.c Src/wav_file.c
+ *       $C/Libraries/HAL_Driver/src/hal_audio.c
+ *       $C/Middlewares/ring_cache/spsc_ring.c -o audio_host_sim
+ *   Inc comes first, its nmsis_core.h and wtm2101_config.h stand in for the target ones.
+ *
+ * run:
+ *   ./audio_host_sim [-m ram|fifo|async] [-i in.wav] [-o out.wav] [-f frame_words] [-t seconds]
+ *                    [-w work_us] [-j jitter_us] [-s stall_us:period_ms] [-r] [-S seed]
+ *                    [-L max_latency_us] [-D max_dropped_samples]
+ *   ram   hal_audio_read on the ram buffer, the dma copies each frame, channel 0 dmic
+ *   fifo  hal_audio_read on the ring the fifo interrupt fills, channel 2 line in
+ *   async hal_audio_async_get on the ram buffer, HAL_AUDIO_ASYNC_DEPTH buffers
+ *   -w the main loop works this long after each frame, -j and -s hold the interrupts off,
+ *   -r paces the run with the wall clock. without -i it is 16 kHz noise, 10 s by default.
+ *   the exit code is 1 for a corrupt or repeated frame, more dropped samples than -D
+ *   or a latency over -L.
+ */
+
+#include <unistd.h>
+
+#include "main.h"
+
+#define HARNESS_CORE_HZ                 (24576000)
+#define HARNESS_RATE                    (16000)
+#define HARNESS_SECONDS                 (10)
+#define HARNESS_FRAME_WORDS             (80)
+#define HARNESS_FRAME_WORDS_MAX         (240)           /*two frames in the default ram depth*/
+#define HARNESS_POLL_CYCLES             (200)           /*the main loop looks again after*/
+#define HARNESS_SEARCH_FRAMES           (64)            /*how far on a drop is looked for*/
+#define HARNESS_RUN                     (8)             /*samples the fifo interrupt pushes at a time*/
+
+typedef enum{
+  HARNESS_MODE_RAM = 0,
+  HARNESS_MODE_FIFO,
+  HARNESS_MODE_ASYNC,
+}Harness_Mode;
+
+typedef struct{
+  uint32_t frames;                      /*frames read*/
+  uint32_t dropped;                     /*samples skipped between frames*/
+  uint32_t gapped;                      /*frames with dropped samples inside*/
+  uint32_t repeated;                    /*frames read again*/
+  uint32_t corrupt;                     /*frames with data that is not in the input*/
+  uint32_t late;                        /*frames read more than a frame period after their last sample*/
+  uint64_t latency_max,latency_sum;     /*cycles, from the last sample of a frame to its read*/
+  uint32_t ring_high_water;             /*bytes*/
+  uint32_t async_high_water;            /*frames finished and not collected*/
+}Harness_Stats;
+
+static Harness_Stats harness;
+static Audio_InitTypeDef *audio;
+static const int16_t *input;
+static uint32_t input_frames,input_channels,input_rate;
+static uint32_t position;                               /*the input sample the next frame should start at*/
+static uint8_t frame_buffer[HARNESS_FRAME_WORDS_MAX * 4] __attribute__((aligned(4)));
+static uint8_t async_buffer[HAL_AUDIO_ASYNC_DEPTH][HARNESS_FRAME_WORDS_MAX * 4] __attribute__((aligned(4)));
+
+static void harness_irq_hook(void)
+{
+    if(audio->channel.BufferMode == HAL_AUDIO_BUFFER_FIFO_MODE)
+    {
+        uint32_t used = Spsc_Ring_Used(&(audio->audio_cache.cache.ring));
+
+        if(used > harness.ring_high_water)
+            harness.ring_high_water = used;
+    }
+    if(audio->async.enable == ENABLE)
+    {
+        uint32_t depth = audio->async.completed - audio->async.collected;
+
+        if(depth > harness.async_high_water)
+            harness.async_high_water = depth;
+    }
+}
+
+static int16_t harness_sample(uint32_t n)
+{
+    return n < input_frames ? input[(size_t)n * input_channels] : 0;
+}
+
+static int harness_match(const uint8_t *data,uint32_t samples,uint32_t at)
+{
+    for(uint32_t k = 0;k < samples;k++)
+    {
+        if((int16_t)(data[2 * k] | (data[2 * k + 1] << 8)) != harness_sample(at + k))
+            return 0;
+    }
+    return 1;
+}
+
+static void harness_check(const uint8_t *data,uint32_t samples)
+{
+    uint64_t now = __get_rv_cycle();
+    uint64_t latency,period = (uint64_t)samples * HARNESS_CORE_HZ / input_rate;
+    uint32_t cursor = position;
+    int gaps = 0;
+
+    harness.frames++;
+    if(position >= samples && !harness_match(data,samples,position) && harness_match(data,samples,position - samples))
+    {
+        harness.repeated++;
+        return;
+    }
+
+    /*the frame in runs, a run not where the last one ended is looked for further on*/
+    for(uint32_t k = 0;k < samples;k += HARNESS_RUN)
+    {
+        uint32_t n = samples - k < HARNESS_RUN ? samples - k : HARNESS_RUN;
+        uint32_t at = cursor,last = cursor + HARNESS_SEARCH_FRAMES * samples;
+
+        if(!harness_match(data + 2 * k,n,at))
+        {
+            /*up to the end, the zeros after it would match anywhere there*/
+            if(last > input_frames)
+                last = input_frames;
+            for(at = cursor + 1;at <= last;at++)
+            {
+                if(harness_match(data + 2 * k,n,at))
+                    break;
+            }
+            if(at > last)
+            {
+                harness.corrupt++;
+                position += samples;
+                return;
+            }
+            harness.dropped += at - cursor;
+            if(k > 0)
+                gaps++;
+        }
+        cursor = at + n;
+    }
+    if(gaps)
+        harness.gapped++;
+    position = cursor;
+
+    latency = now - audio_sim_sample_cycle(audio->channel.ChannelNumber,position - 1);
+    if(latency > harness.latency_max)
+        harness.latency_max = latency;
+    harness.latency_sum += latency;
+    if(latency > period)
+        harness.late++;
+}
+
+static int16_t* harness_noise(uint32_t frames,uint32_t seed)
+{
+    int16_t *pcm = malloc((size_t)frames * sizeof(int16_t));
+    uint32_t x = seed ? seed : 1;
+
+    if(pcm == NULL)
+        return NULL;
+    for(uint32_t i = 0;i < frames;i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        pcm[i] = (int16_t)(x >> 16);
+    }
+    return pcm;
+}
+
+static double harness_us(uint64_t cycles)
+{
+    return cycles * 1000000.0 / HARNESS_CORE_HZ;
+}
+
+int main(int argc,char *argv[])
+{
+    Harness_Mode mode = HARNESS_MODE_RAM;
+    Audio_Sim_Config config = {HARNESS_CORE_HZ,40,0,200,4,0,0,1,DISABLE};
+    Audio_Sim_Stats sim;
+    const char *in_path = NULL,*out_path = NULL;
+    uint32_t frame_words = HARNESS_FRAME_WORDS,seconds = HARNESS_SECONDS,work = 0,rate = HARNESS_RATE;
+    uint32_t max_dropped = 0,samples;
+    double max_latency_us = 0;
+    int16_t *pcm = NULL,*out = NULL;
+    uint32_t out_frames = 0,out_capacity;
+    uint64_t deadline;
+    int opt,ret,index = 0,failed;
+
+    while((opt = getopt(argc,argv,"m:i:o:f:t:w:j:s:rS:L:D:")) != -1)
+    {
+        switch(opt)
+        {
+          case 'm':
+              if(!strcmp(optarg,"ram"))
+                  mode = HARNESS_MODE_RAM;
+              else if(!strcmp(optarg,"fifo"))
+                  mode = HARNESS_MODE_FIFO;
+              else if(!strcmp(optarg,"async"))
+                  mode = HARNESS_MODE_ASYNC;
+              else
+                  return 2;
+              break;
+          case 'i': in_path = optarg; break;
+          case 'o': out_path = optarg; break;
+          case 'f': frame_words = atoi(optarg); break;
+          case 't': seconds = atoi(optarg); break;
+          case 'w': work = (uint32_t)(atof(optarg) * HARNESS_CORE_HZ / 1000000); break;
+          case 'j': config.irq_jitter = (uint32_t)(atof(optarg) * HARNESS_CORE_HZ / 1000000); break;
+          case 's':
+          {
+              double stall_us = 0,period_ms = 0;
+
+              if(sscanf(optarg,"%lf:%lf",&stall_us,&period_ms) != 2 || stall_us >= period_ms * 1000)
+                  return 2;
+              config.stall_cycles = (uint32_t)(stall_us * HARNESS_CORE_HZ / 1000000);
+              config.stall_period = (uint32_t)(period_ms * HARNESS_CORE_HZ / 1000);
+              break;
+          }
+          case 'r': config.realtime = ENABLE; break;
+          case 'S': config.seed = atoi(optarg); break;
+          case 'L': max_latency_us = atof(optarg); break;
+          case 'D': max_dropped = atoi(optarg); break;
+          default:
+              printf("usage: %s [-m ram|fifo|async] [-i in.wav] [-o out.wav] [-f frame_words] [-t seconds] "
+                     "[-w work_us] [-j jitter_us] [-s stall_us:period_ms] [-r] [-S seed] [-L max_latency_us] [-D max_dropped]\n",argv[0]);
+              return 2;
+        }
+    }
+    if(frame_words == 0 || frame_words > HARNESS_FRAME_WORDS_MAX)
+    {
+        printf("the frame is 1 to %d words\n",HARNESS_FRAME_WORDS_MAX);
+        return 2;
+    }
+    samples = frame_words * 2;
+
+    /*the input*/
+    if(in_path != NULL)
+    {
+        ret = wav_file_read(in_path,&pcm,&input_frames,&input_channels,&rate);
+        if(ret <= 0)
+        {
+            printf("wav_file_read %s is error:%d\n",in_path,ret);
+            return 2;
+        }
+        if(seconds && input_frames > (uint64_t)seconds * rate)
+            input_frames = seconds * rate;
+    }
+    else
+    {
+        input_frames = seconds * rate;
+        input_channels = 1;
+        pcm = harness_noise(input_frames,config.seed);
+        if(pcm == NULL)
+            return 2;
+    }
+    input = pcm;
+    input_rate = rate;
+    out_capacity = input_frames + HARNESS_SEARCH_FRAMES * samples;
+    if(out_path != NULL && (out = malloc((size_t)out_capacity * sizeof(int16_t))) == NULL)
+        return 2;
+
+    ret = audio_sim_init(&config,pcm,input_frames,input_channels,rate);
+    if(ret <= 0)
+    {
+        printf("audio_sim_init is error:%d\n",ret);
+        return 2;
+    }
+    audio_sim_set_irq_hook(harness_irq_hook);
+
+    /*the audio, as the hal audio example sets it up*/
+    audio = hal_audio_instance_get(HAL_AUDIO_INSTANCE1);
+    ret = hal_audio_init(audio,mode == HARNESS_MODE_FIFO ? HAL_AUDIO_MIC_INPUT_LINEIN : HAL_AUDIO_MIC_INPUT_DMIC);
+    if(ret <= 0)
+    {
+        printf("hal_audio_init is error:%d\n",ret);
+        return 2;
+    }
+    if(mode != HARNESS_MODE_FIFO)
+    {
+        audio->channel.Buffer_Ram_Depth = frame_words * 2;
+        audio->channel.Buffer_Ram_Frame_Move = frame_words;
+    }
+    audio->channel.Buffer_Ram_Length = frame_words;
+    ret = hal_audio_open(audio);
+    if(ret <= 0)
+    {
+        printf("hal_audio_open is error:%d\n",ret);
+        return 2;
+    }
+    if(mode == HARNESS_MODE_ASYNC)
+    {
+        hal_audio_async_enable(audio,NULL);
+        for(int i = 0;i < HAL_AUDIO_ASYNC_DEPTH;i++)
+            hal_audio_async_submit(audio,async_buffer[i]);
+    }
+
+    __enable_irq();
+    hal_audio_ctl(audio,HAL_AUDIO_INTERRUPT_ENABLE_COMMAND,ENABLE);
+    hal_audio_ctl(audio,HAL_AUDIO_CHANNEL_ENABLE_COMMAND,ENABLE);
+    deadline = audio_sim_sample_cycle(audio->channel.ChannelNumber,input_frames) + HARNESS_CORE_HZ;
+
+    /*the main loop, a frame is read, checked and worked on*/
+    while(position + samples <= input_frames)
+    {
+        const uint8_t *data = NULL;
+        Hal_Audio_Frame frame;
+
+        if(mode == HARNESS_MODE_RAM)
+        {
+            if(hal_audio_read(audio,NULL) > 0)
+                data = audio->audio_cache.cache.sram.sram_data;
+        }
+        else if(mode == HARNESS_MODE_FIFO)
+        {
+            if(hal_audio_read(audio,frame_buffer) > 0)
+                data = frame_buffer;
+        }
+        else
+        {
+            if(hal_audio_async_get(audio,&frame,ENABLE) > 0)
+                data = frame.buffer;
+        }
+
+        if(data == NULL)
+        {
+            if(__get_rv_cycle() > deadline)
+            {
+                printf("no frame since %.0f us\n",harness_us(__get_rv_cycle()));
+                break;
+            }
+            audio_sim_run(HARNESS_POLL_CYCLES);
+            continue;
+        }
+
+        harness_check(data,samples);
+        if(out != NULL && out_frames + samples <= out_capacity)
+        {
+            for(uint32_t k = 0;k < samples;k++)
+                out[out_frames++] = (int16_t)(data[2 * k] | (data[2 * k + 1] << 8));
+        }
+        if(mode == HARNESS_MODE_ASYNC)
+            hal_audio_async_submit(audio,frame.buffer);
+        audio_sim_run(work);
+    }
+    hal_audio_ctl(audio,HAL_AUDIO_CHANNEL_ENABLE_COMMAND,DISABLE);
+
+    /*the report*/
+    audio_sim_get_stats(&sim);
+    index = mode == HARNESS_MODE_FIFO ? 2 : 0;
+    printf("mode %s, %u words a frame, %u Hz, %.2f s\n",mode == HARNESS_MODE_RAM ? "ram" : mode == HARNESS_MODE_FIFO ? "fifo" : "async",
+           frame_words,rate,(double)input_frames / rate);
+    printf("frames %u, dropped %u samples, frames with a gap %u, repeated %u, corrupt %u, late %u\n",
+           harness.frames,harness.dropped,harness.gapped,harness.repeated,harness.corrupt,harness.late);
+    printf("latency max %.1f us, mean %.1f us, frame period %.1f us\n",harness_us(harness.latency_max),
+           harness.frames ? harness_us(harness.latency_sum / harness.frames) : 0.0,samples * 1000000.0 / rate);
+    printf("irqs %llu, irq delay max %.1f us\n",(unsigned long long)sim.irqs,harness_us(sim.irq_delay_max));
+    if(mode == HARNESS_MODE_FIFO)
+    {
+        printf("fifo high water %u/%d words, overflow %u words\n",sim.fifo_high_water[index],AUDIO_SIM_FIFO_DEPTH,sim.fifo_overflow[index]);
+        printf("ring high water %u/%u bytes\n",harness.ring_high_water,audio->audio_cache.cache.ring.size);
+    }
+    else
+    {
+        printf("ram high water %u/%u words, overwritten %u words, missed %u frames\n",sim.ram_high_water[index],
+               audio->channel.Buffer_Ram_Depth,sim.ram_overwritten[index],sim.ram_missed[index]);
+    }
+    if(mode == HARNESS_MODE_ASYNC)
+    {
+        printf("async high water %u/%d frames, overrun %u, underrun %u\n",harness.async_high_water,HAL_AUDIO_ASYNC_DEPTH,
+               audio->async.overrun,audio->async.underrun);
+    }
+
+    if(out != NULL)
+    {
+        ret = wav_file_write(out_path,out,out_frames,1,rate);
+        if(ret <= 0)
+            printf("wav_file_write %s is error:%d\n",out_path,ret);
+    }
+
+    failed = harness.corrupt || harness.repeated || harness.dropped > max_dropped ||
+             (max_latency_us > 0 && harness_us(harness.latency_max) > max_latency_us) ||
+             position + samples <= input_frames;
+    printf("%s\n",failed ? "FAIL" : "PASS");
+
+    free(out);
+    free(pcm);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+/**
+  ******************************************************************************
+  * @file    wav_file.c
+  * @brief   16 bits pcm wav files for the audio host harness.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wav_file.h"
+
+static uint32_t wav_le32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t wav_le16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static void wav_put32(uint8_t *p,uint32_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static void wav_put16(uint8_t *p,uint16_t v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+int wav_file_read(const char *path,int16_t **pcm,uint32_t *frames,uint32_t *channels,uint32_t *sample_rate)
+{
+    FILE *fp = fopen(path,"rb");
+    uint8_t head[12],chunk[8],fmt[16];
+    int have_fmt = 0;
+
+    if(fp == NULL)
+        return -1;
+    if(fread(head,1,12,fp) != 12 || memcmp(head,"RIFF",4) || memcmp(head + 8,"WAVE",4))
+    {
+        fclose(fp);
+        return -2;
+    }
+
+    while(fread(chunk,1,8,fp) == 8)
+    {
+        uint32_t size = wav_le32(chunk + 4);
+
+        if(!memcmp(chunk,"fmt ",4))
+        {
+            if(size < 16 || fread(fmt,1,16,fp) != 16)
+                break;
+            /*PCM, 16 bits*/
+            if(wav_le16(fmt) != 1 || wav_le16(fmt + 14) != 16 || wav_le16(fmt + 2) == 0)
+            {
+                fclose(fp);
+                return -3;
+            }
+            *channels = wav_le16(fmt + 2);
+            *sample_rate = wav_le32(fmt + 4);
+            have_fmt = 1;
+            fseek(fp,(size - 16) + (size & 1),SEEK_CUR);
+        }
+        else if(!memcmp(chunk,"data",4) && have_fmt)
+        {
+            uint32_t n = size / (2 * *channels);
+            uint8_t *raw = malloc((size_t)n * *channels * 2 + 2);
+
+            if(raw == NULL)
+                break;
+            n = fread(raw,2 * *channels,n,fp);
+            *pcm = (int16_t *)raw;
+            for(uint32_t i = 0;i < n * *channels;i++)
+                (*pcm)[i] = (int16_t)wav_le16(raw + 2 * i);
+            *frames = n;
+            fclose(fp);
+            return n > 0 ? 1 : -4;
+        }
+        else
+        {
+            fseek(fp,size + (size & 1),SEEK_CUR);
+        }
+    }
+    fclose(fp);
+    return -4;
+}
+
+int wav_file_write(const char *path,const int16_t *pcm,uint32_t frames,uint32_t channels,uint32_t sample_rate)
+{
+    FILE *fp = fopen(path,"wb");
+    uint32_t bytes = frames * channels * 2;
+    uint8_t head[44],s[2];
+
+    if(fp == NULL)
+        return -1;
+
+    memcpy(head,"RIFF",4);
+    wav_put32(head + 4,36 + bytes);
+    memcpy(head + 8,"WAVEfmt ",8);
+    wav_put32(head + 16,16);
+    wav_put16(head + 20,1);
+    wav_put16(head + 22,channels);
+    wav_put32(head + 24,sample_rate);
+    wav_put32(head + 28,sample_rate * channels * 2);
+    wav_put16(head + 32,channels * 2);
+    wav_put16(head + 34,16);
+    memcpy(head + 36,"data",4);
+    wav_put32(head + 40,bytes);
+    fwrite(head,1,44,fp);
+
+    for(uint32_t i = 0;i < frames * channels;i++)
+    {
+        wav_put16(s,(uint16_t)pcm[i]);
+        fwrite(s,1,2,fp);
+    }
+    if(fclose(fp) != 0)
+        return -2;
+    return 1;
+}
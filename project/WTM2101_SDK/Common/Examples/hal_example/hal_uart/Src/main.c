@@ -320,6 +320,6 @@ static int application_uart_async_callbac(struct Hal_Uart_InitTypeDef *i2s_insta
 {
     /* get data from ring buffer */
     receive_count = 0;
-    receive_count = Ring_Cache_Pop(&(i2s_instance->cache.ring_buffer),receive_buffer,sizeof(receive_buffer));
+    receive_count = Spsc_Ring_Pop(&(i2s_instance->cache.ring_buffer),receive_buffer,sizeof(receive_buffer));
     async_receive_flag = TRUE;
 }
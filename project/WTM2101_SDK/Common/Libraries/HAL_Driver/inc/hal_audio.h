@@ -26,7 +26,7 @@
 #include <stdarg.h>
 
 #include "wtm2101_mmap.h"
-#include "ring_cache.h"
+#include "spsc_ring.h"
 
 struct Audio_InitTypeDef;
 
@@ -171,7 +171,7 @@ typedef struct{
       volatile uint8_t sram_data_flag;                /*the audio channel data flag in HAL_AUDIO_BUFFER_RAM_MODE mode*/
       uint8_t *sram_data;                             /*the audio channel data address malloced by special area in HAL_AUDIO_BUFFER_RAM_MODE mode*/
     }sram;
-    Ring_Cache                    ring;               /*the ring buffer to cache the audio data in HAL_AUDIO_BUFFER_FIFO_MODE mode*/
+    Spsc_Ring                     ring;               /*the ring buffer to cache the audio data in HAL_AUDIO_BUFFER_FIFO_MODE mode, filled by the interrupt*/
   }cache;
 }HAL_AUDIO_CACHE; 
 
@@ -181,6 +181,34 @@ typedef struct
   void(*audio_receive_handler)(struct Audio_InitTypeDef *audio_instance);
 }Hal_Audio_Data_handle;
 
+#define HAL_AUDIO_ASYNC_DEPTH 4                           /*the max frame buffers submitted at a time*/
+
+typedef struct{
+  uint8_t                         *buffer;            /*the submitted buffer, Buffer_Ram_Length * 4 bytes*/
+  uint32_t                        sequence;           /*the frame number since the async read was enabled, gaps are dropped frames*/
+  uint64_t                        timestamp;          /*the cpu cycle the frame became valid in the audio buffer, its deadline is one frame later*/
+  uint32_t                        overrun;            /*the overrun counter when the frame was taken*/
+  uint32_t                        underrun;           /*the underrun counter when the frame was taken*/
+}Hal_Audio_Frame;
+
+typedef void(*Hal_Audio_Frame_Callback)(struct Audio_InitTypeDef *audio_instance,Hal_Audio_Frame *frame);
+
+typedef struct{
+  FunctionalState                 enable;             /*the async read flag*/
+  Hal_Audio_Frame_Callback        callback;           /*called in the interrupt for each frame, NULL to collect them with hal_audio_async_get*/
+  Hal_Audio_Frame                 frame[HAL_AUDIO_ASYNC_DEPTH];  /*the submitted frames, used in turn*/
+  volatile uint32_t               submitted;          /*the buffers submitted by the application*/
+  volatile uint32_t               started;            /*the frames taken into a buffer by the interrupt*/
+  volatile uint32_t               completed;          /*the frames finished by the interrupt*/
+  volatile uint32_t               collected;          /*the frames handed to the application*/
+  volatile uint32_t               frames;             /*the frames produced by the audio buffer*/
+  volatile uint32_t               overrun;            /*the frames dropped, no buffer was submitted or the dma was still busy*/
+  volatile uint32_t               underrun;           /*the missed deadlines. polled, a frame became valid while no submitted buffer was left.
+                                                        with a callback, a frame became valid while the callback was still running,
+                                                        after it returned late or before it rearmed a buffer*/
+  volatile uint8_t                late;               /*the callback returned after the next frame became valid*/
+}Hal_Audio_Async_Typedef;
+
 typedef struct Audio_InitTypeDef{
   FunctionalState enable;                             /*init flag with hal audio*/
   AUD_TypeDef                     *instance;          /*hardware address with audio module*/
@@ -204,6 +232,7 @@ typedef struct Audio_InitTypeDef{
   
   HAL_AUDIO_CACHE                 audio_cache;        /*the audio channel data cache*/ 
   Hal_Audio_Data_handle           Data_handle_info;   /*the buffer handle call*/
+  Hal_Audio_Async_Typedef         async;              /*the non-blocking read*/
 }Audio_InitTypeDef;
 
 /**
@@ -222,7 +251,8 @@ extern Audio_InitTypeDef* hal_audio_instance_get(Hal_Audio_Instance_Typedef numb
 extern int hal_audio_init(Audio_InitTypeDef *audio_instance,Audio_Mic_Input_TypeDef type);
 
 /**
-* @brief  Open the actual related audio hardware 
+* @brief  Open the actual related audio hardware, the fifo mode mallocs a ring of
+*         Buffer_Ram_Length * 8 bytes rounded up to a power of two, e.g. 2048 for 160
 * @param  audio_instance: the hal audio instance
 * @retval Greater than 0 for success, otherwise failure
 */
@@ -245,6 +275,40 @@ extern int hal_audio_ctl(Audio_InitTypeDef *audio_instance,int command, ...);
 */
 extern int hal_audio_read(Audio_InitTypeDef *audio_instance,uint8_t *buffer);
 
+/**
+* @brief  Enable the non-blocking read, hal_audio_read is not used any more, called after hal_audio_open
+* @param  audio_instance: the hal audio instance
+* @param  callback: called in the interrupt for each frame, the buffer is handed back when it returns.
+*                   it returns and a buffer is submitted before the next frame is valid, or underrun counts it.
+*                   NULL to collect the frames with hal_audio_async_get
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_audio_async_enable(Audio_InitTypeDef *audio_instance,Hal_Audio_Frame_Callback callback);
+
+/**
+* @brief  Disable the non-blocking read, the submitted buffers are dropped
+* @param  audio_instance: the hal audio instance
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_audio_async_disable(Audio_InitTypeDef *audio_instance);
+
+/**
+* @brief  Submit a buffer for one of the next frames. with a callback submit either from it or from the main loop, not both
+* @param  audio_instance: the hal audio instance
+* @param  buffer: Buffer_Ram_Length * 4 bytes
+* @retval Greater than 0 for success, -10 HAL_AUDIO_ASYNC_DEPTH buffers are submitted already, otherwise failure
+*/
+extern int hal_audio_async_submit(Audio_InitTypeDef *audio_instance,uint8_t *buffer);
+
+/**
+* @brief  Get the oldest finished frame, its buffer is handed back to the application
+* @param  audio_instance: the hal audio instance
+* @param  frame: the frame
+* @param  wfi: ENABLE to sleep with wfi until a frame is finished
+* @retval Greater than 0 for success, -10 no frame is finished, otherwise failure
+*/
+extern int hal_audio_async_get(Audio_InitTypeDef *audio_instance,Hal_Audio_Frame *frame,FunctionalState wfi);
+
 /**
 * @brief  Close the hal audio instance and related hardware
 * @param  audio_instance: the hal audio instance
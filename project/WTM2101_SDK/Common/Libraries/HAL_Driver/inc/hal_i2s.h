@@ -28,6 +28,7 @@
 #include <stdlib.h>
 
 #include "ring_cache.h"
+#include "hal_pcm.h"
 #include "wtm2101_mmap.h"
 struct Hal_I2s_InitTypeDef;
 
@@ -88,6 +89,40 @@ typedef struct{
   uint32_t dma_cnt;                   /*the dma count flag*/
 }Hal_I2s_Dma_Typedef;
 
+#define HAL_I2S_ZERO_COPY_MAX_BLOCKS    8                 /*the max block numbers of the zero copy capture ring*/
+#define HAL_I2S_ZERO_COPY_MAX_BLOCK_TS  4095              /*the max dma transfers of one block, the BLOCK_TS field of CTLx*/
+
+/*zero copy capture: the dma link script writes straight into the application owned blocks in turn,
+  the interrupt only publishes a filled block. blocks are borrowed and released in order, a block must
+  be released before the dma comes round to it again, that is within block_count - 1 block periods*/
+typedef struct{
+  FunctionalState enable;                                         /*the zero copy capture flag*/
+  uint8_t *block[HAL_I2S_ZERO_COPY_MAX_BLOCKS];                   /*the application owned blocks*/
+  int block_count;                                                /*the block numbers of the ring*/
+  int block_bytes;                                                /*the bytes of one block, left and right channel interleaved*/
+  DMA_LlpTypeDef llp_cfg[HAL_I2S_ZERO_COPY_MAX_BLOCKS];           /*the dma link script, one item per block*/
+  volatile uint32_t filled;                                       /*the blocks published by the dma interrupt*/
+  volatile uint32_t borrowed;                                     /*the blocks handed to the application*/
+  volatile uint32_t released;                                     /*the blocks given back by the application*/
+  volatile uint32_t overrun;                                      /*the times the dma came round to a block not released*/
+  volatile uint32_t dropped;                                      /*the filled blocks dropped unborrowed on an overrun*/
+}Hal_I2s_Zero_Copy_Typedef;
+
+/*the sample format hal_i2s_read hands back, by default the same as the width word*/
+typedef struct{
+  FunctionalState to_16bits;                                      /*32bits width word read as 16bits samples*/
+  int shift;                                                      /*the right shift before the saturation to 16bits*/
+}Hal_I2s_Read_Format_Typedef;
+
+/*the dma position of each direction, to line the sent stream up with the received one*/
+typedef struct{
+  volatile uint32_t tx_frames;                                    /*the frames the dma moved to the i2s since it was enabled*/
+  volatile uint32_t rx_frames;                                    /*the frames the dma moved from the i2s since it was enabled*/
+  volatile uint64_t tx_timestamp;                                 /*the cpu cycle tx_frames was reached*/
+  volatile uint64_t rx_timestamp;                                 /*the cpu cycle rx_frames was reached*/
+  void(*tx_tap)(struct Hal_I2s_InitTypeDef *i2s_instance,const void *frames,int count,uint32_t first_frame);  /*sees each block queued for sending in the interrupt, first_frame is its place in tx_frames*/
+}Hal_I2s_Stamp_Typedef;
+
 typedef struct
 {
   void(*transfer_and_receive_handler)(struct Hal_I2s_InitTypeDef *i2s_instance);
@@ -105,7 +140,10 @@ typedef struct Hal_I2s_InitTypeDef{
   Hal_I2s_Cache_Typedef send_buffer;              /*the send buffer to cache the hal i2s data*/
   Hal_I2s_Cache_Typedef receive_buffer;           /*the receive buffer to cache the hal i2s data*/
   Data_handle Data_handle_info;                   /*the buffer handle call*/
-  Hal_I2s_Dma_Typedef dma;                        /*the dma configuration*/             
+  Hal_I2s_Dma_Typedef dma;                        /*the dma configuration*/
+  Hal_I2s_Zero_Copy_Typedef zero_copy;            /*the zero copy capture ring*/
+  Hal_I2s_Read_Format_Typedef read_format;        /*the sample format of hal_i2s_read*/
+  Hal_I2s_Stamp_Typedef stamp;                    /*the dma position of each direction*/
 }Hal_I2s_InitTypeDef;
 
 /**
@@ -163,6 +201,59 @@ extern int hal_i2s_write(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void
 */
 extern int hal_i2s_read(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_data,int size_by_data);
 
+/**
+* @brief  Read a 32bits width word as 16bits samples, each word is shifted right and saturated
+* @param  i2s_instance: the hal i2s instance, 32bits width word
+* @param  to_16bits: ENABLE for int16_t left_data and right_data, DISABLE for the words as they are
+* @param  shift: the right shift, 0 to 31, 16 keeps the top half of a left aligned sample
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_i2s_read_format_config(Hal_I2s_InitTypeDef *i2s_instance,FunctionalState to_16bits,int shift);
+
+/**
+* @brief  Capture into application owned blocks instead of the hal i2s buffer, called after hal_i2s_init and before hal_i2s_open
+* @param  i2s_instance: the hal i2s instance, only receive type
+* @param  blocks: the block addresses, aligned to the width word
+* @param  block_count: the block numbers, 2 to HAL_I2S_ZERO_COPY_MAX_BLOCKS
+* @param  block_bytes: the bytes of one block, lr_channel_need_sizes_by_width width words as given to hal_i2s_init
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_i2s_zero_copy_config(Hal_I2s_InitTypeDef *i2s_instance,uint8_t **blocks,int block_count,int block_bytes);
+
+/**
+* @brief  Borrow the oldest filled block of the zero copy capture ring
+* @param  i2s_instance: the hal i2s instance
+* @param  block: the block address, left and right channel interleaved
+* @retval the block bytes, -10 no block filled, -11 the dma came round to a block not released: the filled
+*         blocks it may have overwritten that were not borrowed yet are dropped (counted in dropped), the
+*         blocks still borrowed stay with the caller, may be overwritten and have to be released, -11
+*         comes back until the ring has room again, otherwise failure
+*/
+extern int hal_i2s_read_borrow(Hal_I2s_InitTypeDef *i2s_instance,void **block);
+
+/**
+* @brief  Give the oldest borrowed block back to the dma
+* @param  i2s_instance: the hal i2s instance
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_i2s_read_release(Hal_I2s_InitTypeDef *i2s_instance);
+
+/**
+* @brief  Tap the blocks queued for sending, e.g. as the echo reference, called after hal_i2s_init
+* @param  i2s_instance: the hal i2s instance, send or send and receive type
+* @param  tx_tap: called in the interrupt with the interleaved frames, NULL to stop
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_i2s_tx_tap_config(Hal_I2s_InitTypeDef *i2s_instance,void(*tx_tap)(struct Hal_I2s_InitTypeDef *i2s_instance,const void *frames,int count,uint32_t first_frame));
+
+/**
+* @brief  Get the dma position of both directions at once
+* @param  i2s_instance: the hal i2s instance
+* @param  stamp: the frames and their cpu cycles
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_i2s_stamp_get(Hal_I2s_InitTypeDef *i2s_instance,Hal_I2s_Stamp_Typedef *stamp);
+
 /**
 * @brief  Close the hal i2s instance and related hardware
 * @param  i2s_instance: the hal i2s instance
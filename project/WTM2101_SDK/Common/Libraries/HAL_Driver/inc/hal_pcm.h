@@ -0,0 +1,85 @@
+/**
+  ******************************************************************************
+  * @file    hal_pcm.h
+  * @brief   Header for hal_pcm.c module.
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  ******************************************************************************
+  */
+#ifndef HAL_PCM_H
+#define HAL_PCM_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+#include "stdint.h"
+
+/*
+ * channel split, format conversion and gain for interleaved audio frames.
+ * the N307 of the WTM2101 has no dsp extension (__DSP_PRESENT is 0), the
+ * 16bits splits move two samples per word with shifts and masks when the
+ * buffers are word aligned, the rest is done sample by sample.
+ */
+
+#define HAL_PCM_MAX_CHANNELS    4                  /*the max channels of an interleaved frame*/
+
+/**
+* @brief  Split interleaved 16bits frames into channels
+* @param  src: the interleaved frames
+* @param  dst: the channel buffers, channels entries, NULL to skip a channel
+* @param  channels: 2 or 4
+* @param  frames: the frame numbers
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_pcm_deinterleave_16(const int16_t *src,int16_t **dst,int channels,int frames);
+
+/**
+* @brief  Split interleaved 32bits frames into channels
+* @param  src: the interleaved frames
+* @param  dst: the channel buffers, channels entries, NULL to skip a channel
+* @param  channels: 2 or 4
+* @param  frames: the frame numbers
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_pcm_deinterleave_32(const int32_t *src,int32_t **dst,int channels,int frames);
+
+/**
+* @brief  Split interleaved 32bits frames into 16bits channels, each sample is shifted right and saturated
+* @param  src: the interleaved frames
+* @param  dst: the channel buffers, channels entries, NULL to skip a channel
+* @param  channels: 2 or 4
+* @param  frames: the frame numbers
+* @param  shift: the right shift, 0 to 31, 16 keeps the top half of a left aligned word
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_pcm_deinterleave_32_to_16(const int32_t *src,int16_t **dst,int channels,int frames,int shift);
+
+/**
+* @brief  Merge 16bits channels into interleaved frames
+* @param  src: the channel buffers, channels entries, NULL for a silent channel
+* @param  dst: the interleaved frames
+* @param  channels: 2 or 4
+* @param  frames: the frame numbers
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_pcm_interleave_16(int16_t **src,int16_t *dst,int channels,int frames);
+
+/**
+* @brief  Apply a gain to 16bits samples, dst = sat(sat((src * gain_q15) >> 15) << shift)
+* @param  src: the samples
+* @param  dst: the result, may be src
+* @param  samples: the sample numbers
+* @param  gain_q15: the gain mantissa in Q15
+* @param  shift: the left shift, 0 to 15, up to 32768 times
+* @retval Greater than 0 for success, otherwise failure
+*/
+extern int hal_pcm_gain_16(const int16_t *src,int16_t *dst,int samples,int16_t gain_q15,int shift);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -23,12 +23,12 @@
 
 #include "wtm2101_hal.h"
 #include "wtm2101_mmap.h"
-#include "ring_cache.h"
+#include "spsc_ring.h"
 #include "LibNPU.h"
 #include "heap.h"
 
 #define HAL_UART_SEND_DMA_DEFAULT_CHANNEL DMA_CHANNEL4
-#define HAL_UART_RECEIVE_RING_BUFFER_DEFAULT_SIZE (1.5 * 1024)
+#define HAL_UART_RECEIVE_RING_BUFFER_DEFAULT_SIZE (2 * 1024)              /*a power of two*/
 
 struct Hal_Uart_InitTypeDef;
 typedef int(*async_handler)(struct Hal_Uart_InitTypeDef *i2s_instance);
@@ -73,7 +73,7 @@ typedef struct
 
 typedef struct
 {
-    Ring_Cache ring_buffer;                         /*ring buffer*/
+    Spsc_Ring ring_buffer;                          /*ring buffer, filled by the receive interrupt*/
 }Hal_Uart_CacheTypeDef;
 
 typedef struct Hal_Uart_InitTypeDef
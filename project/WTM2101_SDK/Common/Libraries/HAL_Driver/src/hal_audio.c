@@ -76,10 +76,82 @@ __attribute__((weak)) void AUDIO_IRQHandler(void)
     }
 }
 
+static uint8_t hal_audio_async_next_valid(Audio_InitTypeDef *audio_instance)
+{
+    /*the next frame is valid and its interrupt has not run yet*/
+    if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
+        return (AUDIO_Get_Ram_Interrupt_Status(audio_instance->instance,audio_instance->channel.ChannelNumber) & HAL_AUDIO_BUFFER_RAM_VLD_INTERRUPT) != 0;
+
+    return Spsc_Ring_Used(&(audio_instance->audio_cache.cache.ring)) >= audio_instance->channel.Buffer_Ram_Length * 4;
+}
+
+static void hal_audio_async_complete(Audio_InitTypeDef *audio_instance)
+{
+    Hal_Audio_Async_Typedef *async = &audio_instance->async;
+    Hal_Audio_Frame *frame = &async->frame[async->completed % HAL_AUDIO_ASYNC_DEPTH];
+
+    frame->overrun = async->overrun;
+    frame->underrun = async->underrun;
+    async->completed++;
+
+    if(async->callback != NULL)
+    {
+        async->callback(audio_instance,frame);
+        async->collected++;
+        /*the callback returned after the next frame became valid, hal_audio_async_start counts it*/
+        if(hal_audio_async_next_valid(audio_instance))
+            async->late = 1;
+    }
+}
+
+static Hal_Audio_Frame* hal_audio_async_start(Audio_InitTypeDef *audio_instance)
+{
+    Hal_Audio_Async_Typedef *async = &audio_instance->async;
+    Hal_Audio_Frame *frame;
+    uint32_t sequence = async->frames++;
+
+    /*with a callback the deadline of the last frame is missed when the callback is still running,
+      returned late or has not rearmed a buffer by now, counted once a frame.
+      polled, finished frames may queue up to HAL_AUDIO_ASYNC_DEPTH, the deadline is only missed
+      when no submitted buffer is left for this frame*/
+    if(async->completed != 0)
+    {
+        if(async->callback != NULL)
+        {
+            if(async->late || async->collected != async->completed || async->started == async->submitted)
+                async->underrun++;
+            async->late = 0;
+        }
+        else if(async->started == async->submitted)
+        {
+            async->underrun++;
+        }
+    }
+
+    /*a new frame is valid, drop it without a free buffer or while the dma still moves the last one*/
+    if(async->started == async->submitted || async->started != async->completed)
+    {
+        async->overrun++;
+        return NULL;
+    }
+
+    frame = &async->frame[async->started % HAL_AUDIO_ASYNC_DEPTH];
+    frame->sequence = sequence;
+    frame->timestamp = __get_rv_cycle();
+    async->started++;
+
+    return frame;
+}
+
 static void dma_receive_handler(struct Audio_InitTypeDef *audio_instance)
 {
     if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
-       audio_instance->dma_finish_flag = 1;
+    {
+        if(audio_instance->async.enable == ENABLE)
+            hal_audio_async_complete(audio_instance);
+        else
+            audio_instance->dma_finish_flag = 1;
+    }
 }
 
 static void audio_receive_handler(struct Audio_InitTypeDef *audio_instance)
@@ -87,29 +159,56 @@ static void audio_receive_handler(struct Audio_InitTypeDef *audio_instance)
     if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
     {
         /*ram mode*/
-        audio_instance->audio_cache.cache.sram.sram_data_flag = 1;
+        if(audio_instance->async.enable == ENABLE)
+        {
+            /*the dma moves the frame straight into the submitted buffer, dma_receive_handler finishes it*/
+            Hal_Audio_Frame *frame = hal_audio_async_start(audio_instance);
+
+            if(frame != NULL)
+            {
+                if(audio_instance->channel.ChannelNumber == HAL_AUDIO_CHANNEL0_NUMBER)
+                    DMA_Set_Addr(DMA, audio_instance->dma_channel, (uint32_t) & (audio_instance->instance->RAM0DATA), mmap_to_sys((uint32_t )(frame->buffer)), audio_instance->channel.Buffer_Ram_Length, 0);
+                if(audio_instance->channel.ChannelNumber == HAL_AUDIO_CHANNEL1_NUMBER)
+                    DMA_Set_Addr(DMA, audio_instance->dma_channel, (uint32_t) & (audio_instance->instance->RAM1DATA), mmap_to_sys((uint32_t )(frame->buffer)), audio_instance->channel.Buffer_Ram_Length, 0);
+                DMA_Set_Channel_Enable_Cmd(DMA, audio_instance->dma_channel, ENABLE);
+            }
+        }
+        else
+        {
+            audio_instance->audio_cache.cache.sram.sram_data_flag = 1;
+        }
     } 
     else if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_FIFO_MODE)
     {
         /*fifo mode*/
-        uint8_t temp[16] = {0};
-        uint32_t _ = 0;
+        uint32_t temp[4] = {0};
 
+        /*the words are read through the audio driver, so the host harness can stand in for the fifo*/
         for(int i = 0;i < 4;i++)
+            temp[i] = AUDIO_Read_Fifo_Data(audio_instance->instance,audio_instance->channel.ChannelNumber);
+        /*the data is push to ring buffer, the fifo words are little endian like the bytes before*/
+        Spsc_Ring_Push(&(audio_instance->audio_cache.cache.ring),temp,16);
+
+        if(audio_instance->async.enable == ENABLE)
         {
-            if(audio_instance->channel.ChannelNumber == HAL_AUDIO_CHANNEL0_NUMBER)
-                _ =  audio_instance->instance->FF0DATA;
-            else if(audio_instance->channel.ChannelNumber == HAL_AUDIO_CHANNEL1_NUMBER)
-                _ =  audio_instance->instance->FF1DATA;
-            else if(audio_instance->channel.ChannelNumber == HAL_AUDIO_CHANNEL2_NUMBER)
-                _ =  audio_instance->instance->FF2DATA;
-            temp[0 + i * 4] = (_ >> 0);
-            temp[1 + i * 4] = (_ >> 8);
-            temp[2 + i * 4] = (_ >> 16);
-            temp[3 + i * 4] = (_ >> 24);
+            /*the interrupt is the consumer of the ring now*/
+            uint32_t frame_size = audio_instance->channel.Buffer_Ram_Length * 4;
+
+            while(Spsc_Ring_Used(&(audio_instance->audio_cache.cache.ring)) >= frame_size)
+            {
+                Hal_Audio_Frame *frame = hal_audio_async_start(audio_instance);
+
+                if(frame != NULL)
+                {
+                    Spsc_Ring_Pop(&(audio_instance->audio_cache.cache.ring),frame->buffer,frame_size);
+                    hal_audio_async_complete(audio_instance);
+                }
+                else
+                {
+                    Spsc_Ring_Read_Commit(&(audio_instance->audio_cache.cache.ring),frame_size);
+                }
+            }
         }
-        /*the data is push to ring buffer*/
-        Ring_Cache_Push_String(&(audio_instance->audio_cache.cache.ring),temp,16);
     }
 }
 
@@ -585,6 +684,8 @@ int hal_audio_init(Audio_InitTypeDef *audio_instance,Audio_Mic_Input_TypeDef typ
         audio_instance->Data_handle_info.audio_receive_handler = audio_receive_handler;
     }
     audio_instance->vad_flag = DISABLE;
+    audio_instance->async.enable = DISABLE;
+    audio_instance->async.callback = NULL;
 
     return 1;
 }
@@ -599,8 +700,9 @@ int hal_audio_open(Audio_InitTypeDef *audio_instance)
     /*the audio data cache is malloc*/
     if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_FIFO_MODE)
     {
-        /*if the ring buffer is used,the data cahche size is twice*/
-        if(Ring_Cache_Init(&(audio_instance->audio_cache.cache.ring),audio_instance->channel.Buffer_Ram_Length * 4 * 2) <= 0)
+        /*if the ring buffer is used,the data cahche size is twice, rounded up to a power of two and
+          taken from the pvPortMalloc heap: Buffer_Ram_Length 160 needs 1280 bytes and gets 2048*/
+        if(Spsc_Ring_Init(&(audio_instance->audio_cache.cache.ring),NULL,audio_instance->channel.Buffer_Ram_Length * 4 * 2) <= 0)
             return -3;
     }
     else if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
@@ -898,6 +1000,8 @@ int hal_audio_read(Audio_InitTypeDef *audio_instance,uint8_t *buffer)
 {
     if(audio_instance == NULL)
         return -1;
+    if(audio_instance->async.enable == ENABLE)
+        return -2;
 
     if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
     {
@@ -919,10 +1023,10 @@ int hal_audio_read(Audio_InitTypeDef *audio_instance,uint8_t *buffer)
     }
     else if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_FIFO_MODE)
     {
-        if(audio_instance->audio_cache.cache.ring.current_size >= audio_instance->channel.Buffer_Ram_Length * 4)
+        if(Spsc_Ring_Used(&(audio_instance->audio_cache.cache.ring)) >= audio_instance->channel.Buffer_Ram_Length * 4)
         {
             /*Copy the hal audio buffer data to buffer with the hal audio instance*/
-            Ring_Cache_Pop(&(audio_instance->audio_cache.cache.ring),buffer,audio_instance->channel.Buffer_Ram_Length * 4);
+            Spsc_Ring_Pop(&(audio_instance->audio_cache.cache.ring),buffer,audio_instance->channel.Buffer_Ram_Length * 4);
 
           return 1;
         }
@@ -974,7 +1078,7 @@ int hal_audio_close(Audio_InitTypeDef *audio_instance)
     /*free heap*/
     if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_FIFO_MODE)
     {
-        HAL_AUDIO_FREE(audio_instance->audio_cache.cache.ring.data);
+        Spsc_Ring_Deinit(&(audio_instance->audio_cache.cache.ring));
     }
     else if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE)
     {
@@ -983,6 +1087,97 @@ int hal_audio_close(Audio_InitTypeDef *audio_instance)
 
     /*the hal audio flag is disabled*/
     audio_instance->enable = DISABLE;
+    audio_instance->async.enable = DISABLE;
+
+    return 1;
+}
+
+int hal_audio_async_enable(Audio_InitTypeDef *audio_instance,Hal_Audio_Frame_Callback callback)
+{
+    Hal_Audio_Async_Typedef *async;
+
+    if(audio_instance == NULL)
+        return -1;
+    if(audio_instance->enable == DISABLE)
+        return -2;
+    if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE && audio_instance->dma_enable == DISABLE)
+        return -3;
+
+    /*the interrupts see the counters only after they are cleared*/
+    async = &audio_instance->async;
+    async->enable = DISABLE;
+    async->callback = callback;
+    async->submitted = 0;
+    async->started = 0;
+    async->completed = 0;
+    async->collected = 0;
+    async->frames = 0;
+    async->overrun = 0;
+    async->underrun = 0;
+    async->late = 0;
+    async->enable = ENABLE;
+
+    return 1;
+}
+
+int hal_audio_async_disable(Audio_InitTypeDef *audio_instance)
+{
+    if(audio_instance == NULL)
+        return -1;
+
+    audio_instance->async.enable = DISABLE;
+    if(audio_instance->channel.BufferMode == HAL_AUDIO_BUFFER_RAM_MODE && audio_instance->dma_enable == ENABLE)
+        DMA_Set_Channel_Enable_Cmd(DMA, audio_instance->dma_channel, DISABLE);
+
+    return 1;
+}
+
+int hal_audio_async_submit(Audio_InitTypeDef *audio_instance,uint8_t *buffer)
+{
+    Hal_Audio_Async_Typedef *async;
+
+    if(audio_instance == NULL || buffer == NULL)
+        return -1;
+    async = &audio_instance->async;
+    if(async->enable == DISABLE)
+        return -2;
+    if(async->submitted - async->collected >= HAL_AUDIO_ASYNC_DEPTH)
+        return -10;
+
+    /*the slot is filled before the interrupt can see it*/
+    async->frame[async->submitted % HAL_AUDIO_ASYNC_DEPTH].buffer = buffer;
+    __asm volatile("" ::: "memory");
+    async->submitted++;
+
+    return 1;
+}
+
+int hal_audio_async_get(Audio_InitTypeDef *audio_instance,Hal_Audio_Frame *frame,FunctionalState wfi)
+{
+    Hal_Audio_Async_Typedef *async;
+    rv_csr_t mstatus;
+
+    if(audio_instance == NULL || frame == NULL)
+        return -1;
+    async = &audio_instance->async;
+    if(async->enable == DISABLE || async->callback != NULL)
+        return -2;
+    if(async->collected == async->completed && wfi == DISABLE)
+        return -10;
+
+    /*a frame finished between the check and the wfi still wakes it, the interrupt is taken after enabling.
+      the caller may have the interrupts masked already*/
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    while(async->collected == async->completed)
+    {
+        __WFI();
+        __RV_CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+        __RV_CSR_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    }
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    *frame = async->frame[async->collected % HAL_AUDIO_ASYNC_DEPTH];
+    async->collected++;
 
     return 1;
 }
@@ -166,9 +166,9 @@ static void hal_i2s_dma_init(Hal_I2s_InitTypeDef *i2s_instance)
     ECLIC_EnableIRQ(DMA_IRQn);
 }
 
-static void hal_i2s_dma_fifo_init(Hal_I2s_InitTypeDef *i2s_instance)
+static uint32_t hal_i2s_dma_ctl_get(Hal_I2s_InitTypeDef *i2s_instance)
 {
-    uint32_t ctl0_cache;
+    uint32_t ctl0_cache = 0;
 
     switch (i2s_instance->dma.dma_channel) {
         case DMA_CHANNEL0: ctl0_cache = (uint32_t)DMA->CTL0; break;
@@ -179,6 +179,12 @@ static void hal_i2s_dma_fifo_init(Hal_I2s_InitTypeDef *i2s_instance)
         case DMA_CHANNEL5: ctl0_cache = (uint32_t)DMA->CTL5; break;
         default:break;
     }
+    return ctl0_cache;
+}
+
+static void hal_i2s_dma_fifo_init(Hal_I2s_InitTypeDef *i2s_instance)
+{
+    uint32_t ctl0_cache = hal_i2s_dma_ctl_get(i2s_instance);
 
     i2s_instance->dma.llp_cfg[0].llp         = mmap_to_sys((uint32_t)&(i2s_instance->dma.llp_cfg[1]));
     if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
@@ -219,6 +225,22 @@ static void hal_i2s_dma_fifo_init(Hal_I2s_InitTypeDef *i2s_instance)
     i2s_instance->dma.llp_cfg[1].ctl_reg_low = ctl0_cache;
 }
 
+static void hal_i2s_dma_zero_copy_init(Hal_I2s_InitTypeDef *i2s_instance)
+{
+    Hal_I2s_Zero_Copy_Typedef *zero_copy = &i2s_instance->zero_copy;
+    uint32_t ctl0_cache = hal_i2s_dma_ctl_get(i2s_instance);
+
+    /*one link item per block, the last one links back to the first*/
+    for(int i = 0; i < zero_copy->block_count; i++)
+    {
+        zero_copy->llp_cfg[i].llp          = mmap_to_sys((uint32_t)&(zero_copy->llp_cfg[(i + 1) % zero_copy->block_count]));
+        zero_copy->llp_cfg[i].src          = mmap_to_sys((uint32_t)&(i2s_instance->instance->RXDMA));
+        zero_copy->llp_cfg[i].dst          = mmap_to_sys((uint32_t)zero_copy->block[i]);
+        zero_copy->llp_cfg[i].ctl_reg_high = zero_copy->block_bytes / i2s_instance->width_word;
+        zero_copy->llp_cfg[i].ctl_reg_low  = ctl0_cache;
+    }
+}
+
 static void hal_i2s_data_prehandle(Hal_I2s_InitTypeDef *i2s_instance)
 {
     uint16_t *temp_data_pointer16 = NULL;
@@ -303,6 +325,26 @@ static void hal_i2s_gpio_uninit(Hal_I2s_InitTypeDef *i2s_instance)
     }
 }
 
+/*the frames of one dma block, 16 words of left and right channel*/
+#define HAL_I2S_DMA_BLOCK_FRAMES 8
+
+static void hal_i2s_stamp_tx(Hal_I2s_InitTypeDef *i2s_instance,const uint8_t *queued,uint32_t ahead)
+{
+    Hal_I2s_Stamp_Typedef *stamp = &i2s_instance->stamp;
+
+    stamp->tx_timestamp = __get_rv_cycle();
+    stamp->tx_frames += HAL_I2S_DMA_BLOCK_FRAMES;
+    /*the block just queued goes out after the ones still ahead of it*/
+    if(stamp->tx_tap)
+        stamp->tx_tap(i2s_instance,queued,HAL_I2S_DMA_BLOCK_FRAMES,stamp->tx_frames + ahead);
+}
+
+static void hal_i2s_stamp_rx(Hal_I2s_InitTypeDef *i2s_instance,uint32_t frames)
+{
+    i2s_instance->stamp.rx_timestamp = __get_rv_cycle();
+    i2s_instance->stamp.rx_frames += frames;
+}
+
 static void transfer_and_receive_handler(struct Hal_I2s_InitTypeDef *i2s_instance)
 {
     if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
@@ -318,18 +360,24 @@ static void transfer_and_receive_handler(struct Hal_I2s_InitTypeDef *i2s_instanc
         i2s_instance->receive_buffer.write_index += 16 * i2s_instance->width_word;
         i2s_instance->receive_buffer.write_index %= i2s_instance->receive_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word; 
         i2s_instance->dma.dma_cnt++;
+        hal_i2s_stamp_rx(i2s_instance,HAL_I2S_DMA_BLOCK_FRAMES);
     }
     else if(i2s_instance->type == HAL_I2S_ONLY_SEND)
     {
+        uint8_t *queued;
+
         i2s_instance->dma.dma_cnt++;
         if(i2s_instance->dma.dma_cnt%2)
         {
-            memcpy(i2s_instance->dma.cache_buffer + 0,i2s_instance->send_buffer.buffer + i2s_instance->send_buffer.write_index,16 * i2s_instance->width_word);       
+            queued = i2s_instance->dma.cache_buffer + 0;
         }
         else
         {
-            memcpy(i2s_instance->dma.cache_buffer + 16 * i2s_instance->width_word,i2s_instance->send_buffer.buffer + i2s_instance->send_buffer.write_index,16 * i2s_instance->width_word);          
+            queued = i2s_instance->dma.cache_buffer + 16 * i2s_instance->width_word;
         }
+        memcpy(queued,i2s_instance->send_buffer.buffer + i2s_instance->send_buffer.write_index,16 * i2s_instance->width_word);
+        /*the other half is being sent*/
+        hal_i2s_stamp_tx(i2s_instance,queued,HAL_I2S_DMA_BLOCK_FRAMES);
         i2s_instance->send_buffer.write_index += 16 * i2s_instance->width_word;
         i2s_instance->send_buffer.write_index %= i2s_instance->send_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word; 
     }
@@ -339,6 +387,8 @@ static void transfer_and_receive_handler(struct Hal_I2s_InitTypeDef *i2s_instanc
         if(i2s_instance->dma.dma_cnt%2)
         {
             memcpy(i2s_instance->dma.cache_buffer + 0,i2s_instance->send_buffer.buffer + i2s_instance->send_buffer.write_index,16 * i2s_instance->width_word); 
+            /*the send and the receive block take turns, this one goes out next*/
+            hal_i2s_stamp_tx(i2s_instance,i2s_instance->dma.cache_buffer + 0,0);
             i2s_instance->send_buffer.write_index += 16 * i2s_instance->width_word;
             i2s_instance->send_buffer.write_index %= i2s_instance->send_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word; 
         }
@@ -347,10 +397,23 @@ static void transfer_and_receive_handler(struct Hal_I2s_InitTypeDef *i2s_instanc
             memcpy(i2s_instance->receive_buffer.buffer + i2s_instance->receive_buffer.write_index,i2s_instance->dma.cache_buffer + 16 * i2s_instance->width_word,16 * i2s_instance->width_word);
             i2s_instance->receive_buffer.write_index += 16 * i2s_instance->width_word;
             i2s_instance->receive_buffer.write_index %= i2s_instance->receive_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word; 
+            hal_i2s_stamp_rx(i2s_instance,HAL_I2S_DMA_BLOCK_FRAMES);
         }
     } 
 }
 
+static void zero_copy_receive_handler(struct Hal_I2s_InitTypeDef *i2s_instance)
+{
+    Hal_I2s_Zero_Copy_Typedef *zero_copy = &i2s_instance->zero_copy;
+    uint32_t filled = zero_copy->filled + 1;
+
+    /*the dma goes on with block filled, it has to be released by now*/
+    if(filled - zero_copy->released >= (uint32_t)zero_copy->block_count)
+        zero_copy->overrun++;
+    zero_copy->filled = filled;
+    hal_i2s_stamp_rx(i2s_instance,zero_copy->block_bytes / (2 * i2s_instance->width_word));
+}
+
 Hal_I2s_InitTypeDef* hal_i2s_instance_get(Hal_I2s_Instance_Typedef number)
 {
     if(number < HAL_I2S_INSTANCE0 || number > HAL_I2S_INSTANCE1)
@@ -474,6 +537,11 @@ int hal_i2s_init(Hal_I2s_InitTypeDef *i2s_instance,I2S_TypeDef *address,Hal_I2s_
         memset(i2s_instance->dma.cache_buffer,0,16 * 4 * 2);
         i2s_instance->dma.dma_cnt = 0;
     }
+    memset(&i2s_instance->zero_copy,0,sizeof(i2s_instance->zero_copy));
+    i2s_instance->zero_copy.enable = DISABLE;
+    i2s_instance->read_format.to_16bits = DISABLE;
+    i2s_instance->read_format.shift = 0;
+    memset(&i2s_instance->stamp,0,sizeof(i2s_instance->stamp));
 
     return 1;
 }
@@ -484,7 +552,11 @@ int hal_i2s_open(Hal_I2s_InitTypeDef *i2s_instance)
         return -1;
 
     /* malloc memory*/
-    if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
+    if(i2s_instance->zero_copy.enable == ENABLE)
+    {
+        /* the application owns the blocks */
+    }
+    else if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
     {
         i2s_instance->receive_buffer.buffer = (uint8_t *)HAL_I2S_MALLOC(i2s_instance->receive_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word);
         if(!(i2s_instance->receive_buffer.buffer))
@@ -529,7 +601,10 @@ int hal_i2s_open(Hal_I2s_InitTypeDef *i2s_instance)
     
     /* i2s-dma init */
     hal_i2s_dma_init(i2s_instance);
-    hal_i2s_dma_fifo_init(i2s_instance);
+    if(i2s_instance->zero_copy.enable == ENABLE)
+        hal_i2s_dma_zero_copy_init(i2s_instance);
+    else
+        hal_i2s_dma_fifo_init(i2s_instance);
 
     i2s_instance->enable = ENABLE;
 
@@ -554,12 +629,26 @@ int hal_i2s_ctl(Hal_I2s_InitTypeDef *i2s_instance,int command, ...)
             if(value)
             { 
                 i2s_instance->dma.dma_cnt = 0;
+                i2s_instance->stamp.tx_frames = 0;
+                i2s_instance->stamp.rx_frames = 0;
 
                 I2S_RxFIFO_Flush(i2s_instance->instance);
                 I2S_TxFIFO_Flush(i2s_instance->instance);
 
                 hal_i2s_data_prehandle(i2s_instance);
-                DMA_Set_Addr(DMA, i2s_instance->dma.dma_channel, 0, 0, 0, mmap_to_sys((uint32_t)i2s_instance->dma.llp_cfg));
+                if(i2s_instance->zero_copy.enable == ENABLE)
+                {
+                    i2s_instance->zero_copy.filled = 0;
+                    i2s_instance->zero_copy.borrowed = 0;
+                    i2s_instance->zero_copy.released = 0;
+                    i2s_instance->zero_copy.overrun = 0;
+                    i2s_instance->zero_copy.dropped = 0;
+                    DMA_Set_Addr(DMA, i2s_instance->dma.dma_channel, 0, 0, 0, mmap_to_sys((uint32_t)i2s_instance->zero_copy.llp_cfg));
+                }
+                else
+                {
+                    DMA_Set_Addr(DMA, i2s_instance->dma.dma_channel, 0, 0, 0, mmap_to_sys((uint32_t)i2s_instance->dma.llp_cfg));
+                }
                   
                 if(i2s_instance->mode == HAL_I2S_MASTER)
                     I2S_ClkCtl(i2s_instance->instance,ENABLE);
@@ -626,81 +715,110 @@ int hal_i2s_ctl(Hal_I2s_InitTypeDef *i2s_instance,int command, ...)
     return 1;
 }
 
-int hal_i2s_write(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_data,int size_by_data)
+/*a null channel keeps the words already in the buffer like before, so only the 16bits frames with both
+  channels go through the pack kernel*/
+static void hal_i2s_interleave(Hal_I2s_InitTypeDef *i2s_instance,void *i2s_buffer,void *left_data,void *right_data,int frames)
 {
-    volatile uint32_t *left_temp32 = NULL,*right_temp32 = NULL,*i2s_buffer32 = NULL;
-    volatile uint16_t *left_temp16 = NULL,*right_temp16 = NULL,*i2s_buffer16 = NULL;
-
-    if (i2s_instance == NULL || size_by_data <= 0) 
-        return -1;
-
     if(i2s_instance->width_word == HAL_I2S_16BITS_WIDTH_WORD)
     {
-        left_temp16 = (uint16_t *)left_data;
-        right_temp16 = (uint16_t *)right_data;
-        i2s_buffer16 = (uint16_t *)(&i2s_instance->send_buffer.buffer[i2s_instance->send_buffer.read_index]);
-        for(int i = 0 ;i < size_by_data; i++)
+        int16_t *channel[2] = {(int16_t *)left_data,(int16_t *)right_data};
+        int16_t *i2s_buffer16 = (int16_t *)i2s_buffer;
+
+        if(left_data && right_data)
+        {
+            hal_pcm_interleave_16(channel,i2s_buffer16,2,frames);
+            return;
+        }
+        for(int i = 0 ;i < frames; i++)
         {
-            if(left_temp16)
-             i2s_buffer16[i * 2] =  left_temp16[i];
-            if(right_temp16)
-             i2s_buffer16[i * 2 + 1] = right_temp16[i];
+            if(channel[0])
+                i2s_buffer16[i * 2] = channel[0][i];
+            if(channel[1])
+                i2s_buffer16[i * 2 + 1] = channel[1][i];
         }
     }
     else
     {
-        left_temp32 = (uint32_t *)left_data;
-        right_temp32 = (uint32_t *)right_data;
-        i2s_buffer32 = (uint32_t *)(&i2s_instance->send_buffer.buffer[i2s_instance->send_buffer.read_index]);
-        for(int i = 0 ;i < size_by_data; i++)
+        uint32_t *left_temp32 = (uint32_t *)left_data,*right_temp32 = (uint32_t *)right_data;
+        uint32_t *i2s_buffer32 = (uint32_t *)i2s_buffer;
+
+        for(int i = 0 ;i < frames; i++)
         {
             if(left_temp32)
-                i2s_buffer32[i * 2] =  left_temp32[i];
+                i2s_buffer32[i * 2] = left_temp32[i];
             if(right_temp32)
                 i2s_buffer32[i * 2 + 1] = right_temp32[i];
         }
     }
+}
+
+/*split the interleaved frames into the left and right channel in the format of read_format*/
+static void hal_i2s_deinterleave(Hal_I2s_InitTypeDef *i2s_instance,const void *i2s_buffer,void *left_data,void *right_data,int frames)
+{
+    if(i2s_instance->width_word == HAL_I2S_16BITS_WIDTH_WORD)
+    {
+        int16_t *channel[2] = {(int16_t *)left_data,(int16_t *)right_data};
+        hal_pcm_deinterleave_16((const int16_t *)i2s_buffer,channel,2,frames);
+    }
+    else if(i2s_instance->read_format.to_16bits == ENABLE)
+    {
+        int16_t *channel[2] = {(int16_t *)left_data,(int16_t *)right_data};
+        hal_pcm_deinterleave_32_to_16((const int32_t *)i2s_buffer,channel,2,frames,i2s_instance->read_format.shift);
+    }
+    else
+    {
+        int32_t *channel[2] = {(int32_t *)left_data,(int32_t *)right_data};
+        hal_pcm_deinterleave_32((const int32_t *)i2s_buffer,channel,2,frames);
+    }
+}
+
+int hal_i2s_write(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_data,int size_by_data)
+{
+    void *i2s_buffer = NULL;
+
+    if (i2s_instance == NULL || size_by_data <= 0) 
+        return -1;
+
+    i2s_buffer = &i2s_instance->send_buffer.buffer[i2s_instance->send_buffer.read_index];
+    hal_i2s_interleave(i2s_instance,i2s_buffer,left_data,right_data,size_by_data);
     i2s_instance->send_buffer.read_index += i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word;
     i2s_instance->send_buffer.read_index %= i2s_instance->send_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word;
 
     return 1;
 }
 
+static int hal_i2s_read_zero_copy(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_data,int size_by_data)
+{
+    void *block = NULL;
+    int ret;
+    int frames;
+
+    /*the copying read on top of the zero copy ring, one block per call*/
+    ret = hal_i2s_read_borrow(i2s_instance,&block);
+    if(ret < 0)
+        return ret;
+
+    frames = ret / (2 * i2s_instance->width_word);
+    if(size_by_data < frames)
+        frames = size_by_data;
+
+    hal_i2s_deinterleave(i2s_instance,block,left_data,right_data,frames);
+    hal_i2s_read_release(i2s_instance);
+
+    return 1;
+}
+
 int hal_i2s_read(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_data,int size_by_data)
 {
-    volatile uint32_t *left_temp32 = NULL,*right_temp32 = NULL,*i2s_buffer32 = NULL;
-    volatile uint16_t *left_temp16 = NULL,*right_temp16 = NULL,*i2s_buffer16 = NULL;
     if (i2s_instance == NULL) 
         return -1;
 
+    if(i2s_instance->zero_copy.enable == ENABLE)
+        return hal_i2s_read_zero_copy(i2s_instance,left_data,right_data,size_by_data);
+
     if(abs(i2s_instance->receive_buffer.write_index - i2s_instance->receive_buffer.read_index) >= i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word)
     {  
-        if(i2s_instance->width_word == HAL_I2S_16BITS_WIDTH_WORD)
-        {
-            left_temp16 = (uint16_t *)left_data;
-            right_temp16 = (uint16_t *)right_data;
-            i2s_buffer16 = (uint16_t *)(&i2s_instance->receive_buffer.buffer[i2s_instance->receive_buffer.read_index]);
-            for(int i = 0 ;i < size_by_data; i++)
-            {
-               if(left_temp16)
-                  left_temp16[i] = i2s_buffer16[i * 2];
-               if(right_temp16)
-                  right_temp16[i] = i2s_buffer16[i * 2 + 1];
-            }
-        }
-        else
-        {
-            left_temp32 = (uint32_t *)left_data;
-            right_temp32 = (uint32_t *)right_data;
-            i2s_buffer32 = (uint32_t *)(&i2s_instance->receive_buffer.buffer[i2s_instance->receive_buffer.read_index]);
-            for(int i = 0 ;i < size_by_data; i++)
-            {
-              if(left_temp32)
-                  left_temp32[i] = i2s_buffer32[i * 2];
-              if(right_temp32)
-                  right_temp32[i] = i2s_buffer32[i * 2 + 1];
-            }
-        }
+        hal_i2s_deinterleave(i2s_instance,&i2s_instance->receive_buffer.buffer[i2s_instance->receive_buffer.read_index],left_data,right_data,size_by_data);
         i2s_instance->receive_buffer.read_index += i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word;
         i2s_instance->receive_buffer.read_index %= i2s_instance->receive_buffer.lr_channel_need_sizes_by_width_counts * i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word;
         return 1;
@@ -709,6 +827,52 @@ int hal_i2s_read(Hal_I2s_InitTypeDef *i2s_instance,void *left_data,void *right_d
     return -10; 
 }
 
+int hal_i2s_read_format_config(Hal_I2s_InitTypeDef *i2s_instance,FunctionalState to_16bits,int shift)
+{
+    if(i2s_instance == NULL)
+        return -1;
+    if(to_16bits == ENABLE && i2s_instance->width_word != HAL_I2S_32BITS_WIDTH_WORD)
+        return -2;
+    if(shift < 0 || shift > 31)
+        return -3;
+
+    i2s_instance->read_format.to_16bits = to_16bits;
+    i2s_instance->read_format.shift = shift;
+
+    return 1;
+}
+
+int hal_i2s_tx_tap_config(Hal_I2s_InitTypeDef *i2s_instance,void(*tx_tap)(struct Hal_I2s_InitTypeDef *i2s_instance,const void *frames,int count,uint32_t first_frame))
+{
+    if(i2s_instance == NULL)
+        return -1;
+    if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
+        return -2;
+
+    i2s_instance->stamp.tx_tap = tx_tap;
+
+    return 1;
+}
+
+int hal_i2s_stamp_get(Hal_I2s_InitTypeDef *i2s_instance,Hal_I2s_Stamp_Typedef *stamp)
+{
+    rv_csr_t mstatus;
+
+    if(i2s_instance == NULL || stamp == NULL)
+        return -1;
+
+    /*the 64bits timestamps are not written in one go, the caller may have the interrupts masked already*/
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    stamp->tx_frames = i2s_instance->stamp.tx_frames;
+    stamp->rx_frames = i2s_instance->stamp.rx_frames;
+    stamp->tx_timestamp = i2s_instance->stamp.tx_timestamp;
+    stamp->rx_timestamp = i2s_instance->stamp.rx_timestamp;
+    stamp->tx_tap = i2s_instance->stamp.tx_tap;
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    return 1;
+}
+
 int hal_i2s_close(Hal_I2s_InitTypeDef *i2s_instance)
 {
     if(i2s_instance == NULL)
@@ -736,7 +900,11 @@ int hal_i2s_close(Hal_I2s_InitTypeDef *i2s_instance)
     I2S_Ctl(i2s_instance->instance,DISABLE);
 
     /* free memory */
-    if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
+    if(i2s_instance->zero_copy.enable == ENABLE)
+    {
+        /* the application owns the blocks */
+    }
+    else if(i2s_instance->type == HAL_I2S_ONLY_RECEIVE)
     {
         HAL_I2S_FREE(i2s_instance->receive_buffer.buffer);
     }
@@ -754,3 +922,88 @@ int hal_i2s_close(Hal_I2s_InitTypeDef *i2s_instance)
 
     return 1;
 }
+
+int hal_i2s_zero_copy_config(Hal_I2s_InitTypeDef *i2s_instance,uint8_t **blocks,int block_count,int block_bytes)
+{
+    if(i2s_instance == NULL || blocks == NULL)
+        return -1;
+    if(i2s_instance->type != HAL_I2S_ONLY_RECEIVE)
+        return -2;
+    if(block_count < 2 || block_count > HAL_I2S_ZERO_COPY_MAX_BLOCKS)
+        return -3;
+    /*one block is what one copying hal_i2s_read takes, so that read keeps its frame count*/
+    if(block_bytes != i2s_instance->lr_channel_need_sizes_by_width * i2s_instance->width_word || block_bytes / i2s_instance->width_word > HAL_I2S_ZERO_COPY_MAX_BLOCK_TS)
+        return -4;
+    if(i2s_instance->enable == ENABLE)
+        return -5;
+    for(int i = 0; i < block_count; i++)
+    {
+        if(blocks[i] == NULL || ((uint32_t)blocks[i] % i2s_instance->width_word))
+            return -6;
+    }
+
+    for(int i = 0; i < block_count; i++)
+        i2s_instance->zero_copy.block[i] = blocks[i];
+    i2s_instance->zero_copy.block_count = block_count;
+    i2s_instance->zero_copy.block_bytes = block_bytes;
+    i2s_instance->zero_copy.filled = 0;
+    i2s_instance->zero_copy.borrowed = 0;
+    i2s_instance->zero_copy.released = 0;
+    i2s_instance->zero_copy.overrun = 0;
+    i2s_instance->zero_copy.dropped = 0;
+    i2s_instance->zero_copy.enable = ENABLE;
+    i2s_instance->Data_handle_info.transfer_and_receive_handler = zero_copy_receive_handler;
+
+    return 1;
+}
+
+int hal_i2s_read_borrow(Hal_I2s_InitTypeDef *i2s_instance,void **block)
+{
+    Hal_I2s_Zero_Copy_Typedef *zero_copy;
+    uint32_t filled;
+    uint32_t held;
+
+    if(i2s_instance == NULL || block == NULL)
+        return -1;
+    zero_copy = &i2s_instance->zero_copy;
+    if(zero_copy->enable != ENABLE)
+        return -2;
+
+    /*filled is only written by the interrupt, borrowed and released only here*/
+    filled = zero_copy->filled;
+    if(filled - zero_copy->released >= (uint32_t)zero_copy->block_count)
+    {
+        /*the dma is writing a block not released. the filled blocks not borrowed yet that it may have
+          overwritten are dropped, the ones the application holds stay borrowed until it releases them*/
+        held = zero_copy->borrowed - zero_copy->released;
+        if(filled - zero_copy->borrowed >= (uint32_t)zero_copy->block_count)
+        {
+            zero_copy->dropped += filled - (zero_copy->block_count - 1) - zero_copy->borrowed;
+            zero_copy->borrowed = filled - (zero_copy->block_count - 1);
+        }
+        /*released only counts, the dropped blocks are taken as given back*/
+        zero_copy->released = zero_copy->borrowed - held;
+        return -11;
+    }
+    if(zero_copy->borrowed == filled)
+        return -10;
+
+    *block = zero_copy->block[zero_copy->borrowed % zero_copy->block_count];
+    zero_copy->borrowed++;
+
+    return zero_copy->block_bytes;
+}
+
+int hal_i2s_read_release(Hal_I2s_InitTypeDef *i2s_instance)
+{
+    if(i2s_instance == NULL)
+        return -1;
+    if(i2s_instance->zero_copy.enable != ENABLE)
+        return -2;
+    if(i2s_instance->zero_copy.released == i2s_instance->zero_copy.borrowed)
+        return -3;
+
+    i2s_instance->zero_copy.released++;
+
+    return 1;
+}
@@ -0,0 +1,206 @@
+/**
+* @file    hal_pcm.c
+* @brief   The Source Codes for the hal_pcm Functions
+* @date    2023-02-07
+* Copyright (c) 2023 Witmem Technology Co., Ltd
+* All rights reserved.
+*
+******************************************************************************
+*/
+
+/** Includes */
+#include "hal_pcm.h"
+#include "stddef.h"
+
+/*the low half of a word is the first sample in memory. pkbb packs the low halves of a and b, pktt the high ones*/
+static inline uint32_t hal_pcm_pkbb16(uint32_t a,uint32_t b)
+{
+    return (a << 16) | (b & 0xFFFF);
+}
+
+static inline uint32_t hal_pcm_pktt16(uint32_t a,uint32_t b)
+{
+    return (a & 0xFFFF0000) | (b >> 16);
+}
+
+static inline int16_t hal_pcm_sat16(int32_t v)
+{
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+#define HAL_PCM_ALIGNED(p)          ((((uint32_t)(uintptr_t)(p)) & 0x03) == 0)
+
+/*a 16bits sample of src times the Q15 gain, then shifted left, both steps saturated*/
+static inline int16_t hal_pcm_gain_sample(int16_t x,int16_t gain_q15,int shift)
+{
+    int32_t v;
+
+    if(x == -32768 && gain_q15 == -32768)
+        v = 32767;
+    else
+        v = ((int32_t)x * gain_q15) >> 15;
+    return hal_pcm_sat16(v * (1 << shift));
+}
+
+static int hal_pcm_check(const void *src,void *dst,int channels,int frames)
+{
+    if(src == NULL || dst == NULL || frames < 0)
+        return -1;
+    if(channels != 2 && channels != 4)
+        return -2;
+    return 1;
+}
+
+/*the 16bits buffers of all channels in use are word aligned*/
+static int hal_pcm_channels_aligned(int16_t **ch,int channels)
+{
+    for(int c = 0; c < channels; c++)
+    {
+        if(ch[c] != NULL && !HAL_PCM_ALIGNED(ch[c]))
+            return 0;
+    }
+    return 1;
+}
+
+int hal_pcm_deinterleave_16(const int16_t *src,int16_t **dst,int channels,int frames)
+{
+    int i = 0;
+    int ret = hal_pcm_check(src,dst,channels,frames);
+
+    if(ret < 0)
+        return ret;
+
+    if(HAL_PCM_ALIGNED(src) && hal_pcm_channels_aligned(dst,channels))
+    {
+        const uint32_t *src32 = (const uint32_t *)src;
+        int words = channels / 2;
+
+        /*two frames at a time: each word holds two channels of one frame, the pack
+          gathers the same channel of both frames into one word*/
+        for(; i + 2 <= frames; i += 2)
+        {
+            for(int w = 0; w < words; w++)
+            {
+                uint32_t first = src32[w];
+                uint32_t second = src32[words + w];
+
+                if(dst[2 * w] != NULL)
+                    *(uint32_t *)&dst[2 * w][i] = hal_pcm_pkbb16(second,first);
+                if(dst[2 * w + 1] != NULL)
+                    *(uint32_t *)&dst[2 * w + 1][i] = hal_pcm_pktt16(second,first);
+            }
+            src32 += 2 * words;
+        }
+    }
+
+    for(; i < frames; i++)
+    {
+        for(int c = 0; c < channels; c++)
+        {
+            if(dst[c] != NULL)
+                dst[c][i] = src[i * channels + c];
+        }
+    }
+
+    return 1;
+}
+
+int hal_pcm_deinterleave_32(const int32_t *src,int32_t **dst,int channels,int frames)
+{
+    int ret = hal_pcm_check(src,dst,channels,frames);
+
+    if(ret < 0)
+        return ret;
+
+    for(int c = 0; c < channels; c++)
+    {
+        const int32_t *s = src + c;
+        int32_t *d = dst[c];
+
+        if(d == NULL)
+            continue;
+        for(int i = 0; i < frames; i++)
+        {
+            d[i] = *s;
+            s += channels;
+        }
+    }
+
+    return 1;
+}
+
+int hal_pcm_deinterleave_32_to_16(const int32_t *src,int16_t **dst,int channels,int frames,int shift)
+{
+    int ret = hal_pcm_check(src,dst,channels,frames);
+
+    if(ret < 0)
+        return ret;
+    if(shift < 0 || shift > 31)
+        return -3;
+
+    for(int c = 0; c < channels; c++)
+    {
+        const int32_t *s = src + c;
+        int16_t *d = dst[c];
+
+        if(d == NULL)
+            continue;
+        for(int i = 0; i < frames; i++)
+        {
+            d[i] = hal_pcm_sat16(*s >> shift);
+            s += channels;
+        }
+    }
+
+    return 1;
+}
+
+int hal_pcm_interleave_16(int16_t **src,int16_t *dst,int channels,int frames)
+{
+    int i = 0;
+    int ret = hal_pcm_check(src,dst,channels,frames);
+
+    if(ret < 0)
+        return ret;
+
+    if(HAL_PCM_ALIGNED(dst) && hal_pcm_channels_aligned(src,channels))
+    {
+        uint32_t *dst32 = (uint32_t *)dst;
+        int words = channels / 2;
+
+        /*two frames at a time, the reverse of the deinterleave pack*/
+        for(; i + 2 <= frames; i += 2)
+        {
+            for(int w = 0; w < words; w++)
+            {
+                uint32_t even = src[2 * w] != NULL ? *(const uint32_t *)&src[2 * w][i] : 0;
+                uint32_t odd = src[2 * w + 1] != NULL ? *(const uint32_t *)&src[2 * w + 1][i] : 0;
+
+                dst32[w] = hal_pcm_pkbb16(odd,even);
+                dst32[words + w] = hal_pcm_pktt16(odd,even);
+            }
+            dst32 += 2 * words;
+        }
+    }
+
+    for(; i < frames; i++)
+    {
+        for(int c = 0; c < channels; c++)
+            dst[i * channels + c] = src[c] != NULL ? src[c][i] : 0;
+    }
+
+    return 1;
+}
+
+int hal_pcm_gain_16(const int16_t *src,int16_t *dst,int samples,int16_t gain_q15,int shift)
+{
+    if(src == NULL || dst == NULL || samples < 0)
+        return -1;
+    if(shift < 0 || shift > 15)
+        return -3;
+
+    for(int i = 0; i < samples; i++)
+        dst[i] = hal_pcm_gain_sample(src[i],gain_q15,shift);
+
+    return 1;
+}
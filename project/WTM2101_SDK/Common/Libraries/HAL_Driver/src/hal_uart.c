@@ -192,7 +192,7 @@ int hal_uart_open(Hal_Uart_InitTypeDef *uart_instance)
     if(uart_instance == NULL)
         return -1;
     
-    if(Ring_Cache_Init(&(uart_instance->cache.ring_buffer),HAL_UART_RECEIVE_RING_BUFFER_DEFAULT_SIZE) <= 0)
+    if(Spsc_Ring_Init(&(uart_instance->cache.ring_buffer),NULL,HAL_UART_RECEIVE_RING_BUFFER_DEFAULT_SIZE) <= 0)
         return -2;
 
     if(uart_instance->instance == UART0)
@@ -285,7 +285,7 @@ int hal_uart_read(Hal_Uart_InitTypeDef *uart_instance,uint8_t *buffer,uint32_t s
         if(uart_instance->sync_receive_flag == TRUE)
         {
             uart_instance->sync_receive_flag = FALSE;
-            (*read_size) += Ring_Cache_Pop(&(uart_instance->cache.ring_buffer),buffer + (*read_size),size);
+            (*read_size) += Spsc_Ring_Pop(&(uart_instance->cache.ring_buffer),buffer + (*read_size),size);
             if((*read_size) >= size)
                 break;
             size -= (*read_size);
@@ -364,7 +364,7 @@ int hal_uart_close(struct Hal_Uart_InitTypeDef *uart_instance)
     else if (uart_instance->instance == UART1)
         RCC_CLK_EN_Ctl(RCC_UART1_CLKEN, DISABLE);
 
-    Ring_Cache_Clear(&(uart_instance->cache.ring_buffer));
+    Spsc_Ring_Deinit(&(uart_instance->cache.ring_buffer));
 
     uart_instance->enable = DISABLE;
       
@@ -440,7 +440,7 @@ static void async_receive_handler(struct Hal_Uart_InitTypeDef *uart_instance)
 
     data = UART_ReceiveData(hal_uart_instance->instance);
     TIMER_Set_Enable_Cmd(hal_uart_instance->timer_instance, DISABLE);
-    Ring_Cache_Push(&hal_uart_instance->cache.ring_buffer, data);
+    Spsc_Ring_Push(&hal_uart_instance->cache.ring_buffer, &data, 1);
     TIMER_Set_Enable_Cmd(hal_uart_instance->timer_instance, ENABLE);
 }
 
@@ -0,0 +1,253 @@
+/**
+  ******************************************************************************
+  * @file    spsc_ring.c
+  * @brief   The Source Codes for the single producer single consumer ring
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  *******************************************************************************
+  */
+
+#include "spsc_ring.h"
+#include "stdlib.h"
+#include "string.h"
+
+static void * spsc_ring_malloc(uint32_t size)
+{
+    extern void *pvPortMalloc( size_t xWantedSize );
+    return pvPortMalloc(size);
+}
+
+static void spsc_ring_free(void *data)
+{
+    extern void vPortFree( void *pv );
+    vPortFree(data);
+}
+
+/*word copy when both sides can be brought to the same alignment*/
+static void spsc_ring_copy(uint8_t *dst, const uint8_t *src, uint32_t len)
+{
+    if ((((uintptr_t)dst ^ (uintptr_t)src) & 0x03) == 0)
+    {
+        while (len > 0 && ((uintptr_t)dst & 0x03))
+        {
+            *dst++ = *src++;
+            len--;
+        }
+
+        uint32_t *dst32 = (uint32_t *)dst;
+        const uint32_t *src32 = (const uint32_t *)src;
+
+        while (len >= 16)
+        {
+            dst32[0] = src32[0];
+            dst32[1] = src32[1];
+            dst32[2] = src32[2];
+            dst32[3] = src32[3];
+            dst32 += 4;
+            src32 += 4;
+            len -= 16;
+        }
+        while (len >= 4)
+        {
+            *dst32++ = *src32++;
+            len -= 4;
+        }
+        dst = (uint8_t *)dst32;
+        src = (const uint8_t *)src32;
+    }
+
+    while (len > 0)
+    {
+        *dst++ = *src++;
+        len--;
+    }
+}
+
+int Spsc_Ring_Init(Spsc_Ring *ring, uint8_t *buffer, uint32_t size)
+{
+    uint32_t pow2 = 1;
+
+    if (ring == 0 || size == 0 || size > 0x80000000u)
+    {
+        return -1;
+    }
+
+    memset(ring, 0x00, sizeof(Spsc_Ring));
+
+    while (pow2 < size)
+    {
+        pow2 <<= 1;
+    }
+
+    if (buffer != NULL)
+    {
+        if (pow2 != size)
+        {
+            return -1;
+        }
+        ring->data = buffer;
+    }
+    else
+    {
+        ring->data = (uint8_t *)spsc_ring_malloc(pow2);
+
+        if (ring->data == NULL)
+        {
+            return -2;
+        }
+        ring->owned = 1;
+    }
+
+    ring->size = pow2;
+    ring->mask = pow2 - 1;
+    ring->head = 0x00;
+    ring->tail = 0x00;
+
+    return 0x01;
+}
+
+int Spsc_Ring_Deinit(Spsc_Ring *ring)
+{
+    if (ring == 0)
+    {
+        return -1;
+    }
+
+    if (ring->owned && ring->data != NULL)
+    {
+        spsc_ring_free(ring->data);
+    }
+
+    ring->data = NULL;
+    ring->size = 0x00;
+    ring->mask = 0x00;
+    ring->owned = 0;
+    ring->head = 0x00;
+    ring->tail = 0x00;
+
+    return 0x01;
+}
+
+int Spsc_Ring_Reset(Spsc_Ring *ring)
+{
+    if (ring == 0)
+    {
+        return -1;
+    }
+
+    ring->head = 0x00;
+    ring->tail = 0x00;
+
+    return 0x01;
+}
+
+uint32_t Spsc_Ring_Used(const Spsc_Ring *ring)
+{
+    return SPSC_RING_LOAD_ACQUIRE(&ring->head) - SPSC_RING_LOAD_ACQUIRE(&ring->tail);
+}
+
+uint32_t Spsc_Ring_Free(const Spsc_Ring *ring)
+{
+    return ring->size - Spsc_Ring_Used(ring);
+}
+
+uint32_t Spsc_Ring_Write_Peek(Spsc_Ring *ring, Spsc_Ring_Span *span)
+{
+    uint32_t head = ring->head;
+    uint32_t free_size = ring->size - (head - SPSC_RING_LOAD_ACQUIRE(&ring->tail));
+    uint32_t index = head & ring->mask;
+    uint32_t first = ring->size - index;
+
+    if (first > free_size)
+    {
+        first = free_size;
+    }
+
+    span->ptr[0] = ring->data + index;
+    span->len[0] = first;
+    span->ptr[1] = ring->data;
+    span->len[1] = free_size - first;
+
+    return free_size;
+}
+
+void Spsc_Ring_Write_Commit(Spsc_Ring *ring, uint32_t len)
+{
+    SPSC_RING_STORE_RELEASE(&ring->head, ring->head + len);
+}
+
+uint32_t Spsc_Ring_Read_Peek(Spsc_Ring *ring, Spsc_Ring_Span *span)
+{
+    uint32_t tail = ring->tail;
+    uint32_t used = SPSC_RING_LOAD_ACQUIRE(&ring->head) - tail;
+    uint32_t index = tail & ring->mask;
+    uint32_t first = ring->size - index;
+
+    if (first > used)
+    {
+        first = used;
+    }
+
+    span->ptr[0] = ring->data + index;
+    span->len[0] = first;
+    span->ptr[1] = ring->data;
+    span->len[1] = used - first;
+
+    return used;
+}
+
+void Spsc_Ring_Read_Commit(Spsc_Ring *ring, uint32_t len)
+{
+    SPSC_RING_STORE_RELEASE(&ring->tail, ring->tail + len);
+}
+
+uint32_t Spsc_Ring_Push(Spsc_Ring *ring, const void *data, uint32_t len)
+{
+    Spsc_Ring_Span span;
+    uint32_t first;
+
+    if (ring == 0 || data == NULL)
+    {
+        return 0x00;
+    }
+
+    if (Spsc_Ring_Write_Peek(ring, &span) < len)
+    {
+        return 0x00;
+    }
+
+    first = len < span.len[0] ? len : span.len[0];
+    spsc_ring_copy(span.ptr[0], (const uint8_t *)data, first);
+    spsc_ring_copy(span.ptr[1], (const uint8_t *)data + first, len - first);
+    Spsc_Ring_Write_Commit(ring, len);
+
+    return len;
+}
+
+uint32_t Spsc_Ring_Pop(Spsc_Ring *ring, void *data, uint32_t size)
+{
+    Spsc_Ring_Span span;
+    uint32_t used;
+    uint32_t first;
+
+    if (ring == 0 || data == NULL)
+    {
+        return 0x00;
+    }
+
+    used = Spsc_Ring_Read_Peek(ring, &span);
+
+    if (size > used)
+    {
+        size = used;
+    }
+
+    first = size < span.len[0] ? size : span.len[0];
+    spsc_ring_copy((uint8_t *)data, span.ptr[0], first);
+    spsc_ring_copy((uint8_t *)data + first, span.ptr[1], size - first);
+    Spsc_Ring_Read_Commit(ring, size);
+
+    return size;
+}
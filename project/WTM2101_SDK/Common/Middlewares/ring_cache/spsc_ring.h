@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file    spsc_ring.h
+  * @brief   Header for the single producer single consumer ring
+  * @date    2023-02-07
+  * Copyright (c) 2023 Witmem Technology Co., Ltd
+  * All rights reserved.
+  *
+  *******************************************************************************
+  */
+#ifndef __SPSC__RING__H
+#define __SPSC__RING__H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "stdint.h"
+
+/*
+ * one producer (e.g. an interrupt) and one consumer (e.g. the main loop) share
+ * the ring without masking interrupts: the producer only writes head, the
+ * consumer only writes tail, both indexes run freely and the size is a power
+ * of two, so used = head - tail and the slot is index & mask.
+ * the data is published with a release store of the index after the copy and
+ * seen with an acquire load before it, which is a compiler barrier on the
+ * single hart and keeps the host stress test honest on a multi core machine.
+ */
+
+#define SPSC_RING_LOAD_ACQUIRE(p)     __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPSC_RING_STORE_RELEASE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+typedef struct
+{
+    uint8_t *data;
+    uint32_t size;                  /*power of two*/
+    uint32_t mask;
+    uint8_t owned;                  /*data was malloced by Spsc_Ring_Init*/
+    volatile uint32_t head;         /*written by the producer only*/
+    volatile uint32_t tail;         /*written by the consumer only*/
+}Spsc_Ring;
+
+/*up to two contiguous pieces of the ring, len[1] is 0 when it does not wrap*/
+typedef struct
+{
+    uint8_t *ptr[2];
+    uint32_t len[2];
+}Spsc_Ring_Span;
+
+/**
+* @brief  Init the ring
+* @param  ring: the ring
+* @param  buffer: the storage, NULL to malloc it
+* @param  size: the storage bytes, a power of two with buffer, rounded up to one without
+* @retval 0x01 for success, -1 bad parameter, -2 malloc failure
+*/
+int Spsc_Ring_Init(Spsc_Ring *ring, uint8_t *buffer, uint32_t size);
+
+/**
+* @brief  Free the malloced storage, no side may use the ring any more
+*/
+int Spsc_Ring_Deinit(Spsc_Ring *ring);
+
+/**
+* @brief  Drop the content, only while neither side is running
+*/
+int Spsc_Ring_Reset(Spsc_Ring *ring);
+
+uint32_t Spsc_Ring_Used(const Spsc_Ring *ring);
+uint32_t Spsc_Ring_Free(const Spsc_Ring *ring);
+
+/**
+* @brief  Producer: copy len bytes in, all or nothing
+* @retval len, 0 when there is no room
+*/
+uint32_t Spsc_Ring_Push(Spsc_Ring *ring, const void *data, uint32_t len);
+
+/**
+* @brief  Consumer: copy up to size bytes out
+* @retval the bytes copied
+*/
+uint32_t Spsc_Ring_Pop(Spsc_Ring *ring, void *data, uint32_t size);
+
+/**
+* @brief  Producer: the free space as up to two pieces to write in place
+* @retval the free bytes
+*/
+uint32_t Spsc_Ring_Write_Peek(Spsc_Ring *ring, Spsc_Ring_Span *span);
+
+/**
+* @brief  Producer: publish len bytes written through Spsc_Ring_Write_Peek
+*/
+void Spsc_Ring_Write_Commit(Spsc_Ring *ring, uint32_t len);
+
+/**
+* @brief  Consumer: the content as up to two pieces to read in place
+* @retval the used bytes
+*/
+uint32_t Spsc_Ring_Read_Peek(Spsc_Ring *ring, Spsc_Ring_Span *span);
+
+/**
+* @brief  Consumer: give len bytes read through Spsc_Ring_Read_Peek back
+*/
+void Spsc_Ring_Read_Commit(Spsc_Ring *ring, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
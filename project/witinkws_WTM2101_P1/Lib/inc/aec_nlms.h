@@ -0,0 +1,67 @@
+#ifndef AEC_NLMS_H
+#define AEC_NLMS_H
+
+#include <stdint.h>
+
+// acoustic echo canceller on the fft frames of the feature front end. on
+// the device fbank_aec_calculate (third_hardware) takes the microphone
+// spectrum from the FBANK block window and fft that the features need
+// anyway, and the aligned playback reference through the block fft too.
+// the echo of each bin is estimated from the last taps reference frames
+// and taken off the microphone spectrum in place, which the block then
+// finishes with sqrt, mel and log. there is no inverse fft, the features
+// are all that is needed.
+//
+// each bin has taps complex weights, Q24, adapted by normalized lms:
+//
+//   E = Y - sum_l W_l X_l
+//   W_l += mu E X_l* / (sum_l |X_l|^2 + Pe + delta)
+//
+// Pe, the smoothed error power of the bin, slows the adaptation when the
+// error is not echo, so near end speech (the keyword) over the music does
+// not pull the weights away. one 32 bits division per bin and frame.
+
+#define AEC_NLMS_BINS           (256)       // the fft_calculate() layout, re/im of bins 0..255
+#define AEC_NLMS_MAX_TAPS       (4)         // frames of echo tail, 12 KB of state at 256 bins
+
+typedef struct
+{
+    uint16_t bins;                          // bins cancelled, the ones above pass as they are
+    uint16_t taps;
+    int16_t mu_q15;                         // step size
+    int16_t err_smooth_q15;                 // share of the new error power per frame
+    uint32_t delta;                         // regularization, in the power units of the bins (>> 4)
+
+    uint16_t pos;                           // history slot of the newest reference frame
+    int16_t x_re[AEC_NLMS_MAX_TAPS][AEC_NLMS_BINS];
+    int16_t x_im[AEC_NLMS_MAX_TAPS][AEC_NLMS_BINS];
+    uint32_t err_pow[AEC_NLMS_BINS];        // |E|^2 >> 4, smoothed
+    int32_t w_re[AEC_NLMS_MAX_TAPS][AEC_NLMS_BINS];
+    int32_t w_im[AEC_NLMS_MAX_TAPS][AEC_NLMS_BINS];
+
+    uint32_t frames;
+    uint32_t resets;                        // the weights diverged and were cleared
+    uint16_t diverge;                       // frames in a row the output was louder than the input
+    uint64_t in_energy;                     // microphone, since the last aec_nlms_take_energy
+    uint64_t out_energy;
+} aec_nlms_t;
+
+// taps 1..AEC_NLMS_MAX_TAPS, bins 1..AEC_NLMS_BINS (128 covers 4 kHz at
+// 16 kHz and 512 points). defaults: mu 0.5, error power over ~4 frames.
+// returns 0, -1 on bad arguments
+int aec_nlms_init(aec_nlms_t *aec, uint16_t taps, uint16_t bins);
+
+// clear the weights and the history, the parameters stay
+void aec_nlms_reset(aec_nlms_t *aec);
+
+// one frame: mic is the microphone spectrum, the echo is taken off in
+// place, ref the reference spectrum of the same frame. both in the
+// fft_calculate() layout (re, im of bins 0..255, AEC_NLMS_BINS * 2 words).
+// adapt 0 only cancels, e.g. while the playback is silent
+void aec_nlms_process(aec_nlms_t *aec, int32_t *mic, const int32_t *ref, int adapt);
+
+// microphone and output energy of the cancelled bins since the last call,
+// their ratio is the echo return loss enhancement
+void aec_nlms_take_energy(aec_nlms_t *aec, uint64_t *in_energy, uint64_t *out_energy);
+
+#endif // AEC_NLMS_H
@@ -0,0 +1,94 @@
+#ifndef BUCKET_TOKENS_H
+#define BUCKET_TOKENS_H
+
+#include <stdint.h>
+#include "heap_sort.h"
+
+#ifdef USE_DECODER_V2_2
+
+// drop-in alternative to the HeapTokens binary heaps: tokens are stored by
+// value in one contiguous array per frame, appends are O(1) and the best
+// max_toks are picked once per frame by a radix select on the int32
+// weight (larger weight is better, as in the heap version).
+//
+// tokens equal to the cutoff weight are kept in insertion order.
+#define BUCKET_TOKENS_BITS      (6)
+#define BUCKET_TOKENS_NUM       (1 << BUCKET_TOKENS_BITS)
+
+typedef struct __BucketTokens
+{
+    TOKEN* cur_toks;
+    int cur_toks_cnt;
+
+    TOKEN* prev_toks;
+    int prev_toks_cnt;
+
+    int max_toks;       // tokens kept per frame
+    int capacity;       // candidates held before an early prune
+    int32_t best_wgt;   // best weight appended in this frame
+    int32_t worst_wgt;  // worst weight appended in this frame
+
+    // after an early prune, tokens not better than cut_wgt can never make
+    // the top max_toks and are rejected on append
+    int32_t cut_wgt;
+    int8_t cut_valid;
+
+    // bumped every time cur_toks is compacted, indices taken before
+    // (e.g. in byte_map_for_arc1) are stale once it changes
+    uint16_t generation;
+
+    uint16_t hist[BUCKET_TOKENS_NUM];
+
+    // heap store only: cur_toks indices as a binary heap, worst on top as
+    // in HeapTokens, and the heap position of every index. NULL for the
+    // bucket store
+    int16_t* heap;
+    int16_t* heap_pos;
+}BucketTokens;
+
+
+__STATIC_FORCEINLINE TOKEN* get_bucket_token_by_index(BucketTokens* btk, int index)
+{
+    return &btk->cur_toks[index];
+}
+
+// capacity < 2 * token_number is raised to 2 * token_number
+BucketTokens* bucket_tokens_init(int token_number, int capacity);
+
+// the HeapTokens way behind the same calls, to compare a decoder on both
+// stores: at most token_number tokens are held, a full store replaces its
+// worst token by a strictly better one and bumps generation, equal ones
+// are rejected. select has nothing left to do
+BucketTokens* bucket_tokens_init_heap(int token_number);
+
+void bucket_tokens_release(BucketTokens* btk);
+
+// copy tok into the current frame, returns its index or -1 when rejected
+int bucket_tokens_append(BucketTokens* btk, const TOKEN* tok);
+
+// token index changed its weight in place (recombination)
+void bucket_tokens_update(BucketTokens* btk, int index);
+
+// keep the best max_toks tokens of the current frame, returns the count
+int bucket_tokens_select(BucketTokens* btk);
+
+// select, then make the current frame the previous one
+int bucket_tokens_exchange_to_another(BucketTokens* btk);
+
+void bucket_tokens_reset(BucketTokens* btk);
+
+// prints heap vs bucket cycles for 20/50/100 tokens and checks both keep
+// the same tokens. bucket_tokens_bench.c, built with BUCKET_TOKENS_BENCH in
+// the RAM_BENCH configuration of Demo.wmproject
+void bucket_tokens_bench(void);
+
+// decodes recorded nnet output (frames x WitinKwsGetNnetOutDimension()
+// int8, as fed to WitinKwsDecodeOneFrame) with kws_multi_decoder on model
+// kws_id twice, on the heap store and on the bucket store, and compares
+// the detected word ids in order. returns the number of differences, < 0
+// on error. needs kws_model_ctx_init(), built with BUCKET_TOKENS_BENCH
+int bucket_tokens_decode_check(const int8_t* nnet, int frames, int kws_id, uint8_t rshift);
+
+#endif
+
+#endif
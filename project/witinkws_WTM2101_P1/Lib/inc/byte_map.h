@@ -38,4 +38,37 @@ void init_byte_map_for_arc1();
 
 int get_byte_map_for_arc1_number();
 
-#endif
\ No newline at end of file
+// the library above clears byte_map_for_arc1 by walking the tokens every
+// frame and keeps its uint8_t layout, Library.a is built against it.
+// decoders built from source use the stamped map instead: one word per
+// state holds the frame stamp and the token index, an entry with an old
+// stamp reads as empty, so a new frame is one increment. the map is wiped
+// only when the 16 bit stamp wraps.
+typedef struct __ByteMapStamped
+{
+    uint32_t* entry;    // stamp << 16 | token index
+    int num_states;
+    uint16_t stamp;     // never 0, the wiped entries read as empty
+}ByteMapStamped;
+
+ByteMapStamped* byte_map_stamped_init(int num_states);
+
+void byte_map_stamped_release(ByteMapStamped* map);
+
+// every state empty
+void byte_map_stamped_clear(ByteMapStamped* map);
+
+__STATIC_FORCEINLINE void byte_map_stamped_set_index(ByteMapStamped* map, int id, int index)
+{
+    map->entry[id] = ((uint32_t)map->stamp << 16) | (uint16_t)index;
+}
+
+// token index of state id in this frame, -1 when it has none
+__STATIC_FORCEINLINE int byte_map_stamped_get_index(const ByteMapStamped* map, int id)
+{
+    uint32_t e = map->entry[id];
+
+    return (e >> 16) == map->stamp ? (int)(e & 0xFFFF) : -1;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef DIGITAL_AGC_H
+#define DIGITAL_AGC_H
+
+#include <stdint.h>
+
+// block based gain control of the capture stream, so a far keyword and a
+// near one reach the features at about the same level. integer only, one
+// division per block.
+//
+//   envelope  block peak, follows a louder block at once and decays over
+//             env_release blocks
+//   gain      Q10, target / envelope between min_gain and max_gain. it
+//             falls at once and rises by rise_q15 of the gap per block.
+//             an envelope under noise_floor holds it, silence is not
+//             pulled up
+//   limiter   the output is delayed by one block, the gain is also kept
+//             under limit / peak of that block and of the next one, so it
+//             is already down when a loud onset comes out. inside a block
+//             the gain moves linearly from the last value to the new one
+//
+// the analog pga can be steered as well (digital_agc_set_analog): when the
+// digital gain stays above ana_up or below ana_down for ana_hold blocks the
+// analog gain moves one 0.75 dB code and the digital gain and the envelope
+// are scaled to match. an input peak at clip_level lowers it at once, a
+// clipped adc can not be repaired behind it.
+
+#define DIGITAL_AGC_MAX_BLOCK       (160)
+#define DIGITAL_AGC_GAIN_ONE        (1024)      // Q10
+#define DIGITAL_AGC_MAX_GAIN        (65535)     // 64x, 36 dB
+#define DIGITAL_AGC_ANA_UP_Q15      (35723)     // +0.75 dB, one analog code
+#define DIGITAL_AGC_ANA_DOWN_Q15    (30057)     // -0.75 dB
+
+typedef struct
+{
+    uint16_t block;                             // samples per call, the delay
+    int16_t target;                             // output peak level, q15
+    int16_t limit;                              // output peaks stay under it, q15
+    int16_t noise_floor;                        // envelope under it holds the gain
+    int32_t min_gain;                           // Q10
+    int32_t max_gain;                           // Q10, up to DIGITAL_AGC_MAX_GAIN
+    int16_t rise_q15;                           // share of the gap the gain rises per block
+    int16_t env_release_q15;                    // share the envelope decays per block
+
+    int32_t gain;                               // Q10, reached at the end of the last block
+    int32_t env;
+    int32_t peak;                               // of the delayed block
+    uint8_t cur;                                // delay slot of the block to put out next
+    int16_t delay[2][DIGITAL_AGC_MAX_BLOCK];
+
+    int (*ana_set)(int code);                   // NULL, the analog gain stays
+    int8_t ana_code;
+    int8_t ana_min;
+    int8_t ana_max;
+    int16_t clip_level;                         // input peak that lowers the analog gain at once
+    int32_t ana_up;                             // Q10 digital gain
+    int32_t ana_down;
+    uint16_t ana_hold;                          // blocks
+    int16_t ana_count;                          // > 0 towards up, < 0 towards down
+
+    uint32_t blocks;
+    uint32_t limited_blocks;                    // the limiter held the gain down
+    uint32_t ana_steps;
+} digital_agc_t;
+
+// block: samples per call (up to DIGITAL_AGC_MAX_BLOCK). defaults: target
+// -12 dBFS, limit -1 dBFS, noise floor -50 dBFS, gain -12 to +30 dB rising
+// over ~1.5 s, envelope release ~300 ms. the fields can be changed after.
+// returns 0, -1 on bad arguments
+int digital_agc_init(digital_agc_t *agc, uint32_t sample_rate, uint16_t block);
+
+// unity gain, empty delay, the parameters and the analog code stay
+void digital_agc_reset(digital_agc_t *agc);
+
+// steer the analog gain through ana_set (audio_set_analog_gain) from code,
+// between min and max. defaults: up at +12 dB digital, down under 0 dB,
+// hold ~1 s, clip at -0.17 dBFS.
+// returns 0, -1 on bad arguments
+int digital_agc_set_analog(digital_agc_t *agc, int (*ana_set)(int code), int code, int min, int max,
+                           uint32_t sample_rate);
+
+// block samples in, the block before out, out may be in
+void digital_agc_process(digital_agc_t *agc, const int16_t *in, int16_t *out);
+
+#endif // DIGITAL_AGC_H
@@ -0,0 +1,79 @@
+#ifndef ENERGY_GATE_H
+#define ENERGY_GATE_H
+
+#include <stdint.h>
+
+// time domain pre-stage that decides per shift block whether the
+// fft/fbank/npu chain has to run at all. ENERGY_GATE_BANDS band passes
+// (one df1 biquad each, riscv_biquad_cascade_df1_q15 on the N307) feed
+// per band energy trackers:
+//
+//   energy  block energy smoothed over 2 blocks
+//   floor   follows the energy down within a few blocks and up over
+//           ~2^ENERGY_GATE_FLOOR_RISE blocks, the background level
+//
+// the gate opens when a band rises on_ratio above its floor, stays open
+// while one is off_ratio above, then holds for hangover blocks. the last
+// ENERGY_GATE_LOOKBACK blocks are kept, on the opening block the caller
+// replays them (energy_gate_history) so the onset and the window history
+// of the first frame are not lost.
+//
+// not in the audio chain: this project runs no per block feature loop a
+// gate could skip, the caller that has one pushes every block itself.
+// a background that comes up to stay holds the gate open until the floor
+// has followed, ~1200 blocks for 20 dB on host_test/test_energy_gate.c.
+
+#define ENERGY_GATE_BANDS           (3)
+#define ENERGY_GATE_MAX_BLOCK       (160)
+#ifndef ENERGY_GATE_LOOKBACK
+#define ENERGY_GATE_LOOKBACK        (8)         // blocks, including the current one
+#endif
+#define ENERGY_GATE_FLOOR_RISE      (7)
+
+#define ENERGY_GATE_CLOSED          (0)
+#define ENERGY_GATE_OPEN            (1)
+#define ENERGY_GATE_ONSET           (2)         // opened on this block, replay the history
+
+typedef struct
+{
+    uint16_t block;                             // samples per push
+    uint16_t on_ratio;                          // Q4, 64 = 4x (6 dB)
+    uint16_t off_ratio;                         // Q4
+    uint16_t hangover;                          // blocks
+    uint32_t min_floor;                         // energy floor of digital silence
+
+    int16_t coeffs[ENERGY_GATE_BANDS][6];      // {b0, 0, b1, b2, a1, a2}, Q14
+    int16_t state[ENERGY_GATE_BANDS][4];
+    uint32_t energy[ENERGY_GATE_BANDS];
+    uint32_t floor[ENERGY_GATE_BANDS];
+
+    uint8_t open;
+    uint16_t hold;
+    uint32_t blocks;                            // pushed
+    uint32_t open_blocks;                       // pushed while open
+    uint16_t hist_pos;                          // slot of the newest block
+    uint16_t hist_count;
+    int16_t hist[ENERGY_GATE_LOOKBACK][ENERGY_GATE_MAX_BLOCK];
+} energy_gate_t;
+
+// block: samples per push, the frame shift (160 at 16 kHz, 80 at 8 kHz).
+// bands 300-800, 800-2000 and 2000-4000 Hz (up to 0.45 fs).
+// returns 0, -1 on bad arguments
+int energy_gate_init(energy_gate_t *gate, uint32_t sample_rate, uint16_t block);
+
+// forget the trackers and the history, the parameters stay
+void energy_gate_reset(energy_gate_t *gate);
+
+// one shift block in, ENERGY_GATE_CLOSED/OPEN/ONSET out
+int energy_gate_push(energy_gate_t *gate, const int16_t *pcm);
+
+// blocks in the history, the current one included
+int energy_gate_history_count(const energy_gate_t *gate);
+
+// block i of the history, 0 is the oldest, count - 1 the current one
+const int16_t *energy_gate_history(const energy_gate_t *gate, int i);
+
+// per mille of the pushed blocks the gate was open
+uint32_t energy_gate_duty(const energy_gate_t *gate);
+
+#endif // ENERGY_GATE_H
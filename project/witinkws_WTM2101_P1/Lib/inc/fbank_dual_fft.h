@@ -0,0 +1,36 @@
+#ifndef FBANK_DUAL_FFT_H
+#define FBANK_DUAL_FFT_H
+
+#include <stdint.h>
+#include "feature_tools.h"
+
+// two microphones, one fft: the channels are packed as z = a + j*b into
+// one 512 point complex fft and separated with the conjugate symmetry
+//
+//   A[k] = (Z[k] + Z*[N-k]) / 2
+//   B[k] = (Z[k] - Z*[N-k]) / 2j
+//
+// on the N307 the complex fft is riscv_cfft_q15, the host build uses a
+// plain radix-2 fft with the same 1/N scaling. the FBANK block only has
+// a 256 point complex fft, too short for two 512 point channels, but the
+// outputs use its sram layout so fbank_calculate_sqrt_mel_log() can take
+// them directly.
+//
+// not used by the two microphone path. host_test builds both ffts: against
+// fft_odata of the SDK fft example the device path is within 5 lsb, against
+// a double dft within 13 lsb (the host radix-2 within 3). it saves no core
+// cycles: fbank_calculate_win_fft() runs the fft in the FBANK block while
+// the core sleeps in WFI, so two block ffts cost the core their sram
+// copies, while riscv_cfft_q15 and the split run the whole 512 point fft on
+// the core. no cycle count was taken on the board.
+
+#define FBANK_DUAL_FFT_N        (_NFFT)
+
+// a, b: _NFFT samples of each channel, already windowed and zero padded
+// spec_a, spec_b: re/im of bins 0..255 as fft_calculate(), scaled by 1/N
+void fbank_dual_fft(const int16_t* a, const int16_t* b, int32_t* spec_a, int32_t* spec_b);
+
+// one channel through the same complex fft, for comparison
+void fbank_dual_fft_single(const int16_t* x, int32_t* spec);
+
+#endif // FBANK_DUAL_FFT_H
@@ -0,0 +1,34 @@
+#ifndef FBANK_MEL_Q15_H
+#define FBANK_MEL_Q15_H
+
+#include <stdint.h>
+#include "feature_tools.h"
+
+// sparse Q15 mel filterbank for a front end without the FBANK block.
+// FBANK_FILTERS is turned once into a plan over pairs of fft bins: the two
+// magnitudes of a pair are loaded as one word and multiplied with the
+// packed weights of every mel bin covering the pair (two on a triangle
+// slope, three at a peak), so each bin is loaded once for both
+// neighbouring filters.
+//
+// plain C: the N307 of the WTM2101 has no P extension (__DSP_PRESENT is 0).
+// nothing on the device calls it, fbank_calculate_sqrt_mel(_log) and the
+// two-mic paths run the mel filters in the FBANK block.
+
+// fft bins with a weight, the pairs cover [0, FBANK_MEL_Q15_BINS)
+#define FBANK_MEL_Q15_BINS      (_NFFT / 2)
+#define FBANK_MEL_Q15_PAIRS     (FBANK_MEL_Q15_BINS / 2)
+#define FBANK_MEL_Q15_MAX_COVER (3)
+
+// build the plan from FBANK_FILTERS, 0 on success, <0 when a filter is
+// outside the fft bins or a pair is covered by more than 3 mel bins
+int fbank_mel_q15_init(void);
+
+// mag: FBANK_MEL_Q15_BINS Q15 magnitudes, 4-byte aligned
+// mel: _NUM_MEL_BINS outputs, sum of mag * weight in Q15
+void fbank_mel_q15(const int16_t* mag, int32_t* mel);
+
+// the same sums by walking the start/end ranges one bin at a time
+void fbank_mel_q15_scalar(const int16_t* mag, int32_t* mel);
+
+#endif // FBANK_MEL_Q15_H
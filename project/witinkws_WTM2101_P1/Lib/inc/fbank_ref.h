@@ -0,0 +1,109 @@
+#ifndef FBANK_REF_H
+#define FBANK_REF_H
+
+#include <stdint.h>
+#include "feature_tools.h"
+
+// integer model of the FBANK block, the same chain as fbank_calculate()
+// (window, 512 point real fft, magnitude, FBANK_FILTERS mel, log to
+// uint8_t), the split entries of fbank_config.c and ifft_calculate(). only
+// integer arithmetic, so host and target give the same bytes as each other.
+//
+// the rounding of the fft/ifft, the magnitude, the mel weights and the log
+// constants are fitted to the board vectors of the SDK fft example
+// (Common/Examples/fft_example): fft, ifft and one fbank_calculate frame
+// come out bit exact, host_test/test_fbank_ref checks them. that is one
+// fbank frame of two tones, so the log curve is pinned only in the range
+// those 40 bins cover; fbank_ref_compare() measures board captures.
+//
+// every stage takes and returns the FBANK sram layout: 512 words in,
+// re/im pairs of 256 bins after the fft, 40 bytes in 10 words at the end.
+
+#ifndef FBANK_REF_WIN_SHIFT
+#define FBANK_REF_WIN_SHIFT     (16)    // povey_win is Q16
+#endif
+
+// one mel term is (melfiter >> FBANK_REF_MEL_WEIGHT_SHIFT) * mag >>
+// FBANK_REF_MEL_SHIFT, the Q16 FBANK_FILTERS weights are cut to Q8
+#ifndef FBANK_REF_MEL_WEIGHT_SHIFT
+#define FBANK_REF_MEL_WEIGHT_SHIFT  (8)
+#endif
+#ifndef FBANK_REF_MEL_SHIFT
+#define FBANK_REF_MEL_SHIFT     (7)
+#endif
+
+// feature = log2(mel) * FBANK_REF_LOG_GAIN / 256 + FBANK_REF_LOG_BIAS,
+// log2 in Q8, clamped to [FBANK_REF_LOG_FLOOR, 255]. the fit leaves
+// GAIN 1352..1364 with BIAS 58, the middle is taken
+#ifndef FBANK_REF_LOG_GAIN
+#define FBANK_REF_LOG_GAIN      (1358)
+#endif
+#ifndef FBANK_REF_LOG_BIAS
+#define FBANK_REF_LOG_BIAS      (58)
+#endif
+#ifndef FBANK_REF_LOG_FLOOR
+#define FBANK_REF_LOG_FLOOR     (64)
+#endif
+
+#define FBANK_REF_FEAT_WORDS    (_NUM_MEL_BINS / 4)
+
+typedef struct
+{
+    uint32_t frames;            // frames compared
+    uint32_t exact_frames;      // frames with all bytes equal
+    uint32_t diff_bytes;        // bytes that differ over all frames
+    uint32_t max_abs_diff;      // largest byte difference
+    int32_t first_bad_frame;    // -1 when every frame matches
+} fbank_ref_diff_t;
+
+// FBANK_FILTERS bins are [start, end], weights melfiter[0..end-start]
+static inline int fbank_ref_mel_len(const fbank_cfg_t* cfg)
+{
+    return cfg->end - cfg->start + 1;
+}
+
+// MELFILTER_ENABLE of one bin, weight from melfiter
+static inline uint32_t fbank_ref_mel_term(uint16_t weight, uint32_t mag)
+{
+    return (uint32_t)(((uint64_t)(weight >> FBANK_REF_MEL_WEIGHT_SHIFT) * mag) >> FBANK_REF_MEL_SHIFT);
+}
+
+// DO_WINDOW: words[0.._WIN_SIZE) *= povey_win, the rest is left as is
+void fbank_ref_window(int32_t* words);
+
+// fft_calculate(): 512 real samples in, bins 0..255 as re/im out, scaled
+// by 1/512. in and out may be the same buffer
+void fbank_ref_fft(const int32_t* in, int32_t* out);
+
+// ifft_calculate(): bins 0..255 as re/im in, 256 complex samples out as
+// re/im, no stage is scaled. in and out may be the same buffer
+void fbank_ref_ifft(const int32_t* in, int32_t* out);
+
+// SQRT_ENABLE of one bin, about |X| / 4
+uint32_t fbank_ref_mag(int32_t re, int32_t im);
+
+// SQRT_ENABLE + MELFILTER_ENABLE: fft words in, 40 mel energies out
+void fbank_ref_sqrt_mel(const int32_t* spectrum, uint32_t* mel);
+
+// LOG_ENABLE: 40 mel energies to 40 bytes, packed as the sram read back
+void fbank_ref_log(const uint32_t* mel, uint32_t* feature);
+
+// the same log for any number of mel energies, one byte each
+void fbank_ref_log_bins(const uint32_t* mel, uint8_t* out, int num_bins);
+
+// fbank_calculate_sqrt_mel_log(): fft words in, 10 words out
+void fbank_ref_sqrt_mel_log(const int32_t* spectrum, uint32_t* feature);
+
+// fbank_calculate(): 512 words of pcm (first _WIN_SIZE used) in, 10 words
+// out. words is used as scratch
+void fbank_ref_calculate(int32_t* words, uint32_t* feature);
+
+// replay pcm with the _WIN_SIZE/_UPDATE_SIZE framing and compare each
+// frame with golden (num_frames * _NUM_MEL_BINS bytes), host_test/
+// test_fbank_ref replays board captures with it. returns 0 when all
+// frames match, 1 on a mismatch, <0 on bad arguments
+int fbank_ref_compare(const int16_t* pcm, uint32_t num_samples,
+                      const uint8_t* golden, uint32_t num_frames,
+                      fbank_ref_diff_t* diff);
+
+#endif // FBANK_REF_H
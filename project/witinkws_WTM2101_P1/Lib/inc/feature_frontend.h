@@ -0,0 +1,80 @@
+#ifndef FEATURE_FRONTEND_H
+#define FEATURE_FRONTEND_H
+
+#include <stdint.h>
+#include "feature_tools.h"
+
+// runtime description of a feature front end, so a smaller model can use
+// e.g. 8 kHz audio, a 256 point fft, 20/32/64 mel bins or 20/10 ms framing
+// without new constants in feature_params.h.
+//
+// the mel filters and the window are generated with the Kaldi formulas
+// the stock FBANK_FILTERS/povey_win tables follow (mel = 1127 ln(1 + f/700),
+// 20 Hz to nyquist, povey window), either at startup into a
+// feature_frontend_tables_t or on the host as const tables with
+// host_test/feature_frontend_gen.
+//
+// the FBANK block only has the 512 point real fft and the fixed 40 bin
+// mel/log stage. a 256 point frame is zero padded to 512 and every second
+// bin taken, which is exactly the 256 point spectrum scaled by 1/512. mel
+// and log of a generated descriptor run on the cpu, only
+// feature_frontend_default keeps the whole chain in the block.
+//
+// the cpu mel and log are fbank_ref's, fitted to the board vectors, so a
+// generated front end is on the block's scale: the 16 kHz/512/40 one gives
+// the board frame of host_test/fbank_golden.c to within one step, the Q15
+// window rounds apart from the Q16 povey_win of the block.
+//
+// nothing in the pipeline takes a descriptor yet: WitinKwsGetFbank() in
+// Library.a runs the fixed 40 bin chain of the block. a model built on
+// another front end calls feature_frontend_compute_hw() (the block fft,
+// third_hardware) or feature_frontend_compute() per frame itself.
+
+#define FEATURE_FRONTEND_MAX_NFFT       (_NFFT)
+#define FEATURE_FRONTEND_MAX_MEL        (64)
+// every fft bin lies under at most two triangles
+#define FEATURE_FRONTEND_MAX_WEIGHTS    (FEATURE_FRONTEND_MAX_NFFT)
+#define FEATURE_FRONTEND_LOW_FREQ       (20)
+
+typedef struct
+{
+    uint16_t sample_rate;
+    uint16_t nfft;              // 256 or 512
+    uint16_t win_size;          // samples, <= nfft
+    uint16_t shift_size;        // samples
+    uint16_t num_mel_bins;      // <= FEATURE_FRONTEND_MAX_MEL
+    uint16_t bin_stride;        // _NFFT / nfft, bin k is bin k * stride of the 512 point fft
+    uint8_t hw_fbank;           // 1: the FBANK tables, the block does window, mel and log
+    const fbank_cfg_t* filters; // num_mel_bins triangles over bins [0, nfft/2), Q16
+    const short* window;        // win_size weights, Q15
+} feature_frontend_t;
+
+typedef struct
+{
+    fbank_cfg_t filters[FEATURE_FRONTEND_MAX_MEL];
+    uint16_t weights[FEATURE_FRONTEND_MAX_WEIGHTS];
+    short window[FEATURE_FRONTEND_MAX_NFFT];
+} feature_frontend_tables_t;
+
+// 16 kHz, 512 point, 400/160, 40 bins on FBANK_FILTERS/povey_win_signed
+extern const feature_frontend_t feature_frontend_default;
+
+// fill fe and tab for the given front end, fe points into tab afterwards.
+// returns 0, -1 on bad sizes, -2 when a mel bin gets no fft bin (too many
+// bins for the fft)
+int feature_frontend_generate(feature_frontend_t* fe, feature_frontend_tables_t* tab,
+                              uint16_t sample_rate, uint16_t nfft,
+                              uint16_t win_ms, uint16_t shift_ms, uint16_t num_mel_bins);
+
+// window win_size samples into words[0..win_size), zero pad to _NFFT
+void feature_frontend_window(const feature_frontend_t* fe, const int16_t* frame, int32_t* words);
+
+// spectrum in the fft_calculate() layout to num_mel_bins bytes, the same
+// sqrt and log as the FBANK block
+void feature_frontend_mel_log(const feature_frontend_t* fe, const int32_t* spectrum, uint8_t* out);
+
+// software path: window, fbank_ref_fft, mel and log. words: _NFFT scratch
+void feature_frontend_compute(const feature_frontend_t* fe, const int16_t* frame,
+                              int32_t* words, uint8_t* out);
+
+#endif // FEATURE_FRONTEND_H
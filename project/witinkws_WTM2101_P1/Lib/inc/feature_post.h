@@ -0,0 +1,78 @@
+#ifndef FEATURE_POST_H
+#define FEATURE_POST_H
+
+#include <stdint.h>
+#include "feature_frontend.h"
+
+// streaming post-processing of the uint8_t fbank frames for the model
+// input, fixed point and O(bins) per frame:
+//
+//   cmvn    running mean/variance with an exponential window of
+//           2^cmvn_shift frames, output out_scale * (x - mean) / std as
+//           int8. while fewer frames were seen the mean stands in for the
+//           cumulative one: the step is divided by the power of two at or
+//           below the frame count, not by the count, so a frame weighs up
+//           to twice its share (within 10 feature units of the exact mean
+//           on the host test). the shifted step truncates, the mean stops
+//           within one feature unit of a constant input
+//   delta   Kaldi deltas with N = 2 on the normalized frames,
+//           sum n (c[t+n] - c[t-n]) / 10, and the same again for delta-delta
+//
+// the deltas are centered, so an output frame lags the input by
+// feature_post_delay() frames. the first frame (and its delta) is repeated
+// into the history as Kaldi does at the edge, so the outputs start with
+// input frame 0. the variance starts at var_init and the mean at the first
+// frame.
+// 1/std is refreshed for FEATURE_POST_STD_REFRESH bins per frame in turn,
+// it follows the slow variance without a sqrt and a divide on every bin.
+
+#define FEATURE_POST_MAX_BINS       (FEATURE_FRONTEND_MAX_MEL)
+#define FEATURE_POST_DELTA_N        (2)
+#define FEATURE_POST_HIST           (2 * FEATURE_POST_DELTA_N + 1)
+#define FEATURE_POST_STD_REFRESH    (8)
+
+#define FEATURE_POST_DELTA          (0x01)
+#define FEATURE_POST_DELTA2         (0x02)      // implies FEATURE_POST_DELTA
+
+typedef struct
+{
+    uint16_t num_bins;
+    uint8_t flags;                  // FEATURE_POST_DELTA*
+    uint8_t cmvn_shift;             // exponential window of 2^cmvn_shift frames
+    int16_t out_scale;              // int8 units per standard deviation
+    int16_t delta_gain;             // Q8, 26 ~ 1/10
+    uint32_t var_init;              // Q16 feature units^2, until the window fills
+
+    uint32_t frames;
+    uint16_t std_next;              // next bin of the 1/std refresh
+
+    int32_t mean[FEATURE_POST_MAX_BINS];            // Q8
+    uint32_t var[FEATURE_POST_MAX_BINS];            // Q16
+    int32_t inv_std[FEATURE_POST_MAX_BINS];         // out_scale / std, Q8 in Q16
+    int8_t stat[FEATURE_POST_HIST][FEATURE_POST_MAX_BINS];
+    int16_t delta[FEATURE_POST_HIST][FEATURE_POST_MAX_BINS];   // unscaled sums
+} feature_post_t;
+
+// defaults: 2^8 frame window, 32 per std, delta_gain 26, std 16 to start.
+// returns 0, -1 on bad arguments
+int feature_post_init(feature_post_t* fp, uint16_t num_bins, uint8_t flags);
+
+// drop the statistics and the history, the parameters stay
+void feature_post_reset(feature_post_t* fp);
+
+// frames an output lags its input: 0, 2 with deltas, 4 with delta-deltas
+int feature_post_delay(const feature_post_t* fp);
+
+// values per output frame: num_bins times 1, 2 or 3
+int feature_post_dim(const feature_post_t* fp);
+
+// push one fbank frame (num_bins bytes) and write the output frame
+// [static | delta | delta2] that became complete. returns 1 when out was
+// written, 0 while the history fills
+int feature_post_process(feature_post_t* fp, const uint8_t* frame, int8_t* out);
+
+// the int8 to P/N split of run_net1(): out[i] = max(x, 0),
+// out[i + num] = max(-x, 0)
+void feature_post_to_pn(const int8_t* in, uint8_t* out, int num);
+
+#endif // FEATURE_POST_H
@@ -1,6 +1,7 @@
 #ifndef  KWS_MANAGER_H
 #define KWS_MANAGER_H
 
+#include "lib_witin_kws/lib_witin_kws.h"
 
 #define NUM_KWS_MODULES (2)
 
@@ -15,4 +16,28 @@ extern int32_t CUR_KWS_ID;
 
 void set_kws_module(int kws_id);
 
+// per-model decoder context: fst, acoustic model and a word hash that no
+// switch rebuilds. built once by kws_model_ctx_init() and owned by it,
+// callers only read it. switching models is a pointer swap plus token
+// reset: kws_model_ctx_switch() may be called from the get-words
+// callback, kws_model_ctx_sync() applies it between two frames.
+typedef struct _KWS_MODEL_CTX
+{
+    int32_t kws_id;
+    KWS_FST_MODU fst;
+    KWS_ACOU_MODU acou;
+} KWS_MODEL_CTX;
+
+extern KWS_MODEL_CTX* cur_kws_ctx;
+
+// build all NUM_KWS_MODULES contexts once, after decoder_init
+int kws_model_ctx_init(void);
+KWS_MODEL_CTX* kws_model_ctx_get(int kws_id);
+// replaces set_kws_module() on the hot path, 0 ok, <0 no such context
+int kws_model_ctx_switch(int kws_id);
+// call before each decoded frame. applies a pending switch, or follows a
+// set_kws_module() seen on is_fst_changed(), resetting the tokens and
+// clearing the flag. 1 switched, 0 nothing to do, <0 error
+int kws_model_ctx_sync(void);
+
 #endif // ! KWS_MANAGER_H
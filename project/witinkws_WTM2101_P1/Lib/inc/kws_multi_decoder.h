@@ -0,0 +1,44 @@
+#ifndef KWS_MULTI_DECODER_H
+#define KWS_MULTI_DECODER_H
+
+#include <stdint.h>
+#include "kws_manager.h"
+#include "bucket_tokens.h"
+#include "lib_witin_kws/lib_witin_kws.h"
+
+// decode several keyword graphs (e.g. wake-up + always-on quick commands)
+// from one nnet output frame. the log posteriors are computed once per
+// frame and shared, every graph keeps its own token set, and a combined
+// arc budget per frame is split between the graphs by their share.
+
+typedef void (*KwsMultiOnWords)(int kws_id, const CallBackKeyWordsType* words);
+
+typedef struct _KWS_MULTI_GRAPH_CFG
+{
+    int32_t kws_id;         // model context, see kws_model_ctx_get()
+    int16_t max_toks;       // token cap of this graph
+    int16_t min_toks;       // token floor when the budget is tight
+    int16_t share;          // relative share of the arc budget
+    int32_t min_score;      // mean log-likelihood per frame over the word, in 1/256
+    uint8_t heap_toks;      // 1: tokens on the heap store, for comparison, see bucket_tokens_init_heap()
+} KWS_MULTI_GRAPH_CFG;
+
+// graphs: cfgs[0..num_graphs), the graph table is sized to num_graphs and
+// several graphs may share one model context. arc_budget: arcs evaluated
+// per frame over all graphs, 0 = unlimited. rshift is the nnet output shift given to
+// LogSoftMax_f. kws_model_ctx_init() must have run.
+int kws_multi_init(const KWS_MULTI_GRAPH_CFG* cfgs, int num_graphs, uint32_t arc_budget, uint8_t rshift);
+
+void kws_multi_release(void);
+
+void kws_multi_reset(void);
+
+void kws_multi_set_on_words(KwsMultiOnWords func);
+
+// returns the number of graphs that detected a word in this frame
+int kws_multi_decode_one_frame(int8_t* nnet_out);
+
+// arcs evaluated by graph index in the last frame, for tuning the budget
+uint32_t kws_multi_get_arcs(int graph);
+
+#endif // ! KWS_MULTI_DECODER_H
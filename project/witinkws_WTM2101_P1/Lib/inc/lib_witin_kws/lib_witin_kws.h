@@ -70,6 +70,47 @@ void WitinKwsRelease(void);
  */
 void WitinKwsDecodeOneFrame(int8_t* nnet_out, int skip3FrameFlag, int skipFrameIndex);
 
+/**
+ * @brief Dynamic frame skipping config, see WitinKwsDecodeOneFrameDynamic
+ */
+typedef struct
+{
+    int8_t min_skip;          /*!< frames per group right after the hangover, 1 or 3, 1 decodes every frame */
+    int8_t max_skip;          /*!< frames per group in long silence, 1 or 3, the decoder only skips in groups of 3 */
+    int16_t sil_index;        /*!< nnet output index of the silence pdf */
+    int16_t sil_margin;       /*!< silence logit must beat the best other logit by this to count as silence */
+    int16_t hangover_frms;    /*!< frames decoded one by one after the last speech frame */
+    int16_t ramp_frms;        /*!< quiet frames needed to grow the skip by one, a skip of 2 still decodes every frame */
+    uint16_t energy_margin;   /*!< frame energy above the tracked noise floor that counts as speech */
+}WitinKwsSkipConfig;
+
+/**
+ * @brief        Enable dynamic frame skipping. The decoder's skip3FrameFlag only
+ *               skips groups of 3, so min_skip and max_skip are 1 or 3, a 2 or 4
+ *               frame skip is not supported
+ * @param[in]    cfg   skip config, NULL for defaults
+ * @return       0 success, -1 bad max_skip, -2 bad min_skip, -3 bad ramp_frms,
+ *               -4 bad sil_index, -5 out of memory
+ */
+int WitinKwsDynamicSkipInit(const WitinKwsSkipConfig* cfg);
+
+/**
+ * @brief        Reset the dynamic skip state, call after decode_reset or a mode switch
+ * @return       void
+ */
+void WitinKwsDynamicSkipReset(void);
+
+/**
+ * @brief        Decode one frame, using the decoder's 3 frame skip in long silence
+ * @param[in]    nnet_out       neural network output of this frame
+ * @param[in]    vad_active     hardware VAD state, >0 voice
+ * @param[in]    frame_energy   frame energy, e.g. sum of the fbank bins
+ * @return       number of frames passed to the decoder by this call, frames held
+ *               back in silence are decoded as a skip group once it is full, or
+ *               one by one first when speech starts
+ */
+int WitinKwsDecodeOneFrameDynamic(int8_t* nnet_out, int vad_active, uint32_t frame_energy);
+
 /**
  * @brief        Kws get fbank features
  * @param[in]    in_frame        input PCM audio data buf10ms data size: 160 * sizeof(int16_t) 16KHz,16bit
@@ -0,0 +1,69 @@
+#ifndef _NOISE_SUPPRESSION_MCRA_Q15_H_
+#define _NOISE_SUPPRESSION_MCRA_Q15_H_
+
+#include <stdint.h>
+#include "noise_suppression_mcra.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// fixed-point MCRA with the float parameters and call sequence of
+// noise_suppression_mcra.h. power is linear power in any fixed scale,
+// masks are Q15. per bin and frame:
+//
+//   S      = alpha_s * S + (1 - alpha_s) * P
+//   Smin   = min(Smin, S), Stmp = min(Stmp, S), every refresh_len frames
+//            Smin = min(Stmp, S), Stmp = S
+//   p      = alpha_p * p + (1 - alpha_p) * (S > delta * Smin)
+//   ad     = alpha_d + (1 - alpha_d) * p
+//   lambda = ad * lambda + (1 - ad) * P
+//   g      = max(P - res * lambda, floor * P) / P, at least mask_ns_min
+//   g     *= mask_nn_I where mask_nn < mask_nn_th
+//   mask   = smoothed g, a_low while rising, a_high while falling
+//
+// the state is structure of arrays, 20 bytes per bin against 40 for the
+// float handle. plain C: the N307 of the WTM2101 has no P extension.
+
+// largest Q15 value, the masks and p saturate here. coefficients 1 - a
+// are taken against 32768
+#define NS_MCRA_Q15_ONE     (32767)
+
+typedef struct NsMcraQ15Param_ {
+    int16_t alpha_s;        // Q15
+    int16_t alpha_p;        // Q15
+    int16_t alpha_d;        // Q15
+    int16_t floor;          // Q15
+    int16_t mask_nn_th;     // Q15
+    int16_t mask_nn_I;      // Q15
+    int16_t mask_ns_min;    // Q15
+    int16_t a_low;          // Q15
+    int16_t a_high;         // Q15
+    uint16_t delta;         // Q8
+    uint16_t res;           // Q8
+    int refresh_len;
+} NsMcraQ15Param;
+
+typedef struct NsMcraQ15Handle_ {
+    uint32_t lambda_d[NS_MCRA_MAG_LEN];
+    uint32_t Scur[NS_MCRA_MAG_LEN];
+    uint32_t Smin[NS_MCRA_MAG_LEN];
+    uint32_t Stmp[NS_MCRA_MAG_LEN];
+    int16_t phat[NS_MCRA_MAG_LEN];
+    int16_t mask_smooth[NS_MCRA_MAG_LEN];
+    NsMcraQ15Param ns_param;
+    NsMcraParam ns_param_f;   // kept for set_param
+} NsMcraQ15Handle;
+
+// param: the float parameters to convert, e.g. ns_param of an initialized
+// NsMcraHandle, NULL for the built-in defaults
+int noise_suppress_mcra_q15_init(NsMcraQ15Handle *self, const NsMcraParam *param);
+int noise_suppress_mcra_q15_set_param(NsMcraQ15Handle *self, float nn_denoise_level, float a_low);
+// mask_nn may be NULL
+int noise_suppress_mcra_q15_process(NsMcraQ15Handle *self, const uint32_t *power, const int16_t *mask_nn, int frame_idx, int16_t *mask_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include <stdint.h>
+
+// sample rate conversion of an I2S codec stream (ES8311 at 48 or 44.1 kHz)
+// to the 16 kHz of the keyword path, block by block with the history kept
+// in the state.
+//
+//   resampler_decim_t     integer factor, a q15 fir run on every factor-th
+//                         input (riscv_fir_decimate_q15 on the N307). 3:1
+//                         with a symmetric filter takes a folded kernel,
+//                         half the multiplies, same output bit for bit.
+//   resampler_rational_t  up/down polyphase, 44.1 -> 16 kHz is 160/441. the
+//                         prototype filter is symmetric, so only the first
+//                         half of the phases is stored, the others are read
+//                         backwards.
+//
+// the built-in filters are kaiser windowed sincs flat to 0.4 of the lower
+// rate and about 58 dB down as close above as their taps allow: from 0.55
+// of 16 kHz for 3:1, from 0.6 for 44.1 kHz, so aliases land above 0.4.
+
+#define RESAMPLER_MAX_TAPS          (96)        // decimator taps
+#define RESAMPLER_MAX_BLOCK         (480)       // input samples per push, 10 ms at 48 kHz
+#define RESAMPLER_3TO1_TAPS         (72)
+#define RESAMPLER_PHASE_TAPS        (48)        // rational taps per phase by default
+#define RESAMPLER_MAX_PHASE_TAPS    (64)
+
+// coefficient storage of a rational resampler with `up` phases
+#define RESAMPLER_RATIONAL_COEFF_LEN(up, taps)  ((((up) + 1) / 2) * (taps))
+
+typedef struct
+{
+    uint8_t factor;
+    uint8_t fast;                               // the folded 3:1 kernel is used
+    uint16_t taps;
+    uint16_t block;                             // input samples per push, a multiple of factor
+    int16_t coeffs[RESAMPLER_MAX_TAPS];         // oldest sample first, the riscv_fir_decimate_q15 order
+    int16_t state[RESAMPLER_MAX_TAPS + RESAMPLER_MAX_BLOCK - 1];
+} resampler_decim_t;
+
+typedef struct
+{
+    uint16_t up;                                // both reduced by their gcd
+    uint16_t down;
+    uint16_t taps;                              // per phase
+    uint16_t phase;                             // of the next output, 0 .. up - 1
+    int32_t next;                               // newest input of the next output, from the current block start
+    int16_t *coeffs;                            // RESAMPLER_RATIONAL_COEFF_LEN(up, taps), phase by phase
+    int16_t buf[RESAMPLER_MAX_PHASE_TAPS - 1 + RESAMPLER_MAX_BLOCK];
+} resampler_rational_t;
+
+// factor 2..8, block up to RESAMPLER_MAX_BLOCK and a multiple of factor.
+// coeffs NULL designs the built-in low pass with 24 taps per factor,
+// otherwise taps (up to RESAMPLER_MAX_TAPS) q15 values are copied in, the
+// oldest sample first.
+// returns 0, -1 on bad arguments
+int resampler_decim_init(resampler_decim_t *dec, uint8_t factor, uint16_t block, const int16_t *coeffs, uint16_t taps);
+
+// clear the history
+void resampler_decim_reset(resampler_decim_t *dec);
+
+// block input samples in, block / factor out, the delay is (taps - 1) / 2
+// input samples. returns the output count
+int resampler_decim_process(resampler_decim_t *dec, const int16_t *in, int16_t *out);
+
+// rate_in and rate_out in Hz, up and down after the gcd at most 1024.
+// taps per phase up to RESAMPLER_MAX_PHASE_TAPS, 0 for RESAMPLER_PHASE_TAPS.
+// coeffs is the caller's storage for RESAMPLER_RATIONAL_COEFF_LEN(up, taps)
+// values, coeff_len its size.
+// returns 0, -1 on bad arguments, -2 when coeffs is too small
+int resampler_rational_init(resampler_rational_t *rs, uint32_t rate_in, uint32_t rate_out, uint16_t taps,
+                            int16_t *coeffs, uint32_t coeff_len);
+
+// clear the history and restart the phase
+void resampler_rational_reset(resampler_rational_t *rs);
+
+// the most outputs num inputs can give
+uint32_t resampler_rational_max_out(const resampler_rational_t *rs, uint32_t num);
+
+// num (up to RESAMPLER_MAX_BLOCK) input samples in, any count per call.
+// returns the output count, -1 on bad arguments
+int resampler_rational_process(resampler_rational_t *rs, const int16_t *in, uint32_t num, int16_t *out);
+
+#endif // RESAMPLER_H
@@ -0,0 +1,133 @@
+#include <stddef.h>
+#include <string.h>
+#include "aec_nlms.h"
+
+// frames in a row the output may be louder than the input before the
+// weights are taken as diverged
+#define AEC_NLMS_DIVERGE_FRAMES     (8)
+
+static int16_t aec_nlms_sat16(int32_t v)
+{
+    return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+}
+
+static int32_t aec_nlms_sat32(int64_t v)
+{
+    return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : (int32_t)v);
+}
+
+static uint32_t aec_nlms_pow(int64_t re, int64_t im)
+{
+    uint64_t p = (uint64_t)(re * re + im * im) >> 4;
+
+    return p > UINT32_MAX ? UINT32_MAX : (uint32_t)p;
+}
+
+int aec_nlms_init(aec_nlms_t *aec, uint16_t taps, uint16_t bins)
+{
+    if (aec == NULL || taps == 0 || taps > AEC_NLMS_MAX_TAPS || bins == 0 || bins > AEC_NLMS_BINS)
+        return -1;
+
+    memset(aec, 0, sizeof(*aec));
+    aec->taps = taps;
+    aec->bins = bins;
+    aec->mu_q15 = 16384;
+    aec->err_smooth_q15 = 8192;
+    aec->delta = 64;
+    return 0;
+}
+
+void aec_nlms_reset(aec_nlms_t *aec)
+{
+    aec->pos = 0;
+    aec->diverge = 0;
+    memset(aec->x_re, 0, sizeof(aec->x_re));
+    memset(aec->x_im, 0, sizeof(aec->x_im));
+    memset(aec->err_pow, 0, sizeof(aec->err_pow));
+    memset(aec->w_re, 0, sizeof(aec->w_re));
+    memset(aec->w_im, 0, sizeof(aec->w_im));
+}
+
+void aec_nlms_process(aec_nlms_t *aec, int32_t *mic, const int32_t *ref, int adapt)
+{
+    uint16_t taps = aec->taps;
+    uint64_t in_energy = 0, out_energy = 0;
+
+    aec->pos = (aec->pos + 1) % taps;
+    for (uint16_t k = 0; k < aec->bins; k++) {
+        aec->x_re[aec->pos][k] = aec_nlms_sat16(ref[2 * k]);
+        aec->x_im[aec->pos][k] = aec_nlms_sat16(ref[2 * k + 1]);
+    }
+
+    for (uint16_t k = 0; k < aec->bins; k++) {
+        int64_t yr = 0, yi = 0;
+        uint32_t x_pow = 0, den;
+        int32_t er, ei;
+        int64_t e_pow;
+
+        // lag l is the history slot pos - l
+        for (uint16_t l = 0, s = aec->pos; l < taps; l++, s = s ? s - 1 : taps - 1) {
+            int32_t xr = aec->x_re[s][k], xi = aec->x_im[s][k];
+            int32_t wr = aec->w_re[l][k], wi = aec->w_im[l][k];
+
+            yr += (int64_t)xr * wr - (int64_t)xi * wi;
+            yi += (int64_t)xr * wi + (int64_t)xi * wr;
+            x_pow += aec_nlms_pow(xr, xi);
+        }
+
+        er = aec_nlms_sat32((int64_t)mic[2 * k] - (yr >> 24));
+        ei = aec_nlms_sat32((int64_t)mic[2 * k + 1] - (yi >> 24));
+        in_energy += (uint64_t)((int64_t)mic[2 * k] * mic[2 * k] + (int64_t)mic[2 * k + 1] * mic[2 * k + 1]);
+        out_energy += (uint64_t)((int64_t)er * er + (int64_t)ei * ei);
+        mic[2 * k] = er;
+        mic[2 * k + 1] = ei;
+
+        e_pow = aec_nlms_pow(er, ei);
+        aec->err_pow[k] += (int32_t)(((e_pow - aec->err_pow[k]) * aec->err_smooth_q15) >> 15);
+
+        if (!adapt)
+            continue;
+
+        // mu / den with 15 to 16 significant bits, den is shifted down to 16 bits
+        den = x_pow + aec->delta;
+        den = den + aec->err_pow[k] < den ? UINT32_MAX : den + aec->err_pow[k];
+        {
+            int sh = den >= 65536 ? 16 - __builtin_clz(den) : 0;
+            int32_t inv = (int32_t)(((uint32_t)aec->mu_q15 << 15) / (den >> sh));
+
+            // W += E X* mu / (den << 4), Q24: (E X* inv) >> (10 + sh)
+            for (uint16_t l = 0, s = aec->pos; l < taps; l++, s = s ? s - 1 : taps - 1) {
+                int32_t xr = aec->x_re[s][k], xi = aec->x_im[s][k];
+                int64_t pr = (int64_t)er * xr + (int64_t)ei * xi;
+                int64_t pi = (int64_t)ei * xr - (int64_t)er * xi;
+
+                aec->w_re[l][k] = aec_nlms_sat32(aec->w_re[l][k] + ((pr * inv) >> (10 + sh)));
+                aec->w_im[l][k] = aec_nlms_sat32(aec->w_im[l][k] + ((pi * inv) >> (10 + sh)));
+            }
+        }
+    }
+
+    aec->in_energy += in_energy;
+    aec->out_energy += out_energy;
+    aec->frames++;
+
+    // an echo path change or a runaway: start over rather than add echo
+    if (out_energy > 2 * in_energy && in_energy > 0) {
+        if (++aec->diverge >= AEC_NLMS_DIVERGE_FRAMES) {
+            memset(aec->w_re, 0, sizeof(aec->w_re));
+            memset(aec->w_im, 0, sizeof(aec->w_im));
+            aec->diverge = 0;
+            aec->resets++;
+        }
+    } else {
+        aec->diverge = 0;
+    }
+}
+
+void aec_nlms_take_energy(aec_nlms_t *aec, uint64_t *in_energy, uint64_t *out_energy)
+{
+    *in_energy = aec->in_energy;
+    *out_energy = aec->out_energy;
+    aec->in_energy = 0;
+    aec->out_energy = 0;
+}
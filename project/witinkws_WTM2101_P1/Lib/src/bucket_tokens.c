@@ -0,0 +1,287 @@
+#include <string.h>
+#include "bucket_tokens.h"
+#include "lib_witin_kws/lib_witin_kws.h"
+
+#ifdef USE_DECODER_V2_2
+
+static void bucket_tokens_frame_reset(BucketTokens* btk)
+{
+    btk->cur_toks_cnt = 0;
+    btk->best_wgt = INT32_MIN;
+    btk->worst_wgt = INT32_MAX;
+    btk->cut_valid = 0;
+}
+
+BucketTokens* bucket_tokens_init(int token_number, int capacity)
+{
+    BucketTokens* btk;
+
+    if (token_number <= 0)
+        return NULL;
+    if (capacity < 2 * token_number) {
+        capacity = 2 * token_number;
+    }
+
+    btk = (BucketTokens*)OsalMalloc(sizeof(BucketTokens));
+    if (btk == NULL)
+        return NULL;
+    memset(btk, 0, sizeof(BucketTokens));
+
+    btk->cur_toks = (TOKEN*)OsalMalloc(capacity * sizeof(TOKEN));
+    btk->prev_toks = (TOKEN*)OsalMalloc(capacity * sizeof(TOKEN));
+    if (btk->cur_toks == NULL || btk->prev_toks == NULL) {
+        bucket_tokens_release(btk);
+        return NULL;
+    }
+    btk->max_toks = token_number;
+    btk->capacity = capacity;
+
+    bucket_tokens_reset(btk);
+    return btk;
+}
+
+BucketTokens* bucket_tokens_init_heap(int token_number)
+{
+    BucketTokens* btk = bucket_tokens_init(token_number, token_number);
+
+    if (btk == NULL)
+        return NULL;
+    btk->heap = (int16_t*)OsalMalloc(token_number * sizeof(int16_t));
+    btk->heap_pos = (int16_t*)OsalMalloc(token_number * sizeof(int16_t));
+    if (btk->heap == NULL || btk->heap_pos == NULL) {
+        bucket_tokens_release(btk);
+        return NULL;
+    }
+    return btk;
+}
+
+void bucket_tokens_release(BucketTokens* btk)
+{
+    if (btk == NULL)
+        return;
+    if (btk->heap != NULL) {
+        OsalFree(btk->heap);
+    }
+    if (btk->heap_pos != NULL) {
+        OsalFree(btk->heap_pos);
+    }
+    if (btk->cur_toks != NULL) {
+        OsalFree(btk->cur_toks);
+    }
+    if (btk->prev_toks != NULL) {
+        OsalFree(btk->prev_toks);
+    }
+    OsalFree(btk);
+}
+
+void bucket_tokens_reset(BucketTokens* btk)
+{
+    bucket_tokens_frame_reset(btk);
+    btk->prev_toks_cnt = 0;
+    btk->generation++;
+}
+
+// radix select of the keep-th best weight. each pass buckets the weights
+// still in [lo, hi] by (hi - w) >> shift and narrows to the bucket that
+// holds the cutoff, until a bucket is a single weight value.
+// *ties returns how many tokens equal to the cutoff are kept.
+static int32_t radix_select_cut(BucketTokens* btk, int keep, int* ties)
+{
+    const TOKEN* toks = btk->cur_toks;
+    int cnt = btk->cur_toks_cnt;
+    int32_t hi = btk->best_wgt;
+    int32_t lo = btk->worst_wgt;
+    int need = keep;
+
+    for (;;) {
+        uint32_t range = (uint32_t)hi - (uint32_t)lo;
+        int shift = 0;
+        int b = 0;
+
+        while ((range >> shift) >= BUCKET_TOKENS_NUM) {
+            shift++;
+        }
+
+        memset(btk->hist, 0, sizeof(btk->hist));
+        for (int i = 0; i < cnt; i++) {
+            int32_t w = toks[i].weight;
+            if (w >= lo && w <= hi) {
+                btk->hist[((uint32_t)hi - (uint32_t)w) >> shift]++;
+            }
+        }
+
+        while (btk->hist[b] < need) {
+            need -= btk->hist[b];
+            b++;
+        }
+
+        if (shift == 0) {
+            *ties = need;
+            return (int32_t)((uint32_t)hi - (uint32_t)b);
+        }
+
+        int64_t new_lo = (int64_t)hi - ((((int64_t)b + 1) << shift) - 1);
+        hi = (int32_t)((int64_t)hi - ((int64_t)b << shift));
+        if (new_lo > lo) {
+            lo = (int32_t)new_lo;
+        }
+    }
+}
+
+static void bucket_tokens_prune(BucketTokens* btk)
+{
+    TOKEN* toks = btk->cur_toks;
+    int ties = 0;
+    int j = 0;
+    int32_t cut = radix_select_cut(btk, btk->max_toks, &ties);
+
+    // stable compaction, earlier tokens win the ties
+    for (int i = 0; i < btk->cur_toks_cnt; i++) {
+        int32_t w = toks[i].weight;
+        if (w > cut || (w == cut && ties-- > 0)) {
+            if (i != j) {
+                toks[j] = toks[i];
+            }
+            j++;
+        }
+    }
+
+    btk->cur_toks_cnt = j;
+    btk->worst_wgt = cut;
+    btk->cut_wgt = cut;
+    btk->cut_valid = 1;
+    btk->generation++;
+}
+
+static void heap_set(BucketTokens* btk, int pos, int index)
+{
+    btk->heap[pos] = (int16_t)index;
+    btk->heap_pos[index] = (int16_t)pos;
+}
+
+static void heap_sift_up(BucketTokens* btk, int pos)
+{
+    int index = btk->heap[pos];
+    int32_t w = btk->cur_toks[index].weight;
+
+    while (pos > 0) {
+        int up = (pos - 1) >> 1;
+        if (btk->cur_toks[btk->heap[up]].weight <= w)
+            break;
+        heap_set(btk, pos, btk->heap[up]);
+        pos = up;
+    }
+    heap_set(btk, pos, index);
+}
+
+static void heap_sift_down(BucketTokens* btk, int pos)
+{
+    int index = btk->heap[pos];
+    int32_t w = btk->cur_toks[index].weight;
+    int cnt = btk->cur_toks_cnt;
+
+    for (;;) {
+        int down = 2 * pos + 1;
+        if (down >= cnt)
+            break;
+        if (down + 1 < cnt && btk->cur_toks[btk->heap[down + 1]].weight < btk->cur_toks[btk->heap[down]].weight) {
+            down++;
+        }
+        if (btk->cur_toks[btk->heap[down]].weight >= w)
+            break;
+        heap_set(btk, pos, btk->heap[down]);
+        pos = down;
+    }
+    heap_set(btk, pos, index);
+}
+
+static int heap_append(BucketTokens* btk, const TOKEN* tok)
+{
+    int index;
+
+    if (btk->cur_toks_cnt < btk->max_toks) {
+        index = btk->cur_toks_cnt++;
+        btk->cur_toks[index] = *tok;
+        btk->heap[index] = (int16_t)index;
+        heap_sift_up(btk, index);
+        return index;
+    }
+
+    // the worst token makes room, its index now holds another state
+    index = btk->heap[0];
+    if (tok->weight <= btk->cur_toks[index].weight)
+        return -1;
+    btk->cur_toks[index] = *tok;
+    heap_sift_down(btk, 0);
+    btk->generation++;
+    return index;
+}
+
+int bucket_tokens_append(BucketTokens* btk, const TOKEN* tok)
+{
+    int32_t w = tok->weight;
+
+    if (btk->heap != NULL)
+        return heap_append(btk, tok);
+
+    if (btk->cut_valid && w <= btk->cut_wgt)
+        return -1;
+
+    if (btk->cur_toks_cnt >= btk->capacity) {
+        bucket_tokens_prune(btk);
+        if (w <= btk->cut_wgt)
+            return -1;
+    }
+
+    if (w > btk->best_wgt) {
+        btk->best_wgt = w;
+    }
+    if (w < btk->worst_wgt) {
+        btk->worst_wgt = w;
+    }
+    btk->cur_toks[btk->cur_toks_cnt] = *tok;
+    return btk->cur_toks_cnt++;
+}
+
+void bucket_tokens_update(BucketTokens* btk, int index)
+{
+    int32_t w = btk->cur_toks[index].weight;
+
+    // a better weight moves away from the worst
+    if (btk->heap != NULL) {
+        heap_sift_down(btk, btk->heap_pos[index]);
+        return;
+    }
+
+    if (w > btk->best_wgt) {
+        btk->best_wgt = w;
+    }
+    if (w < btk->worst_wgt) {
+        btk->worst_wgt = w;
+    }
+}
+
+int bucket_tokens_select(BucketTokens* btk)
+{
+    if (btk->cur_toks_cnt > btk->max_toks) {
+        bucket_tokens_prune(btk);
+    }
+    return btk->cur_toks_cnt;
+}
+
+int bucket_tokens_exchange_to_another(BucketTokens* btk)
+{
+    TOKEN* t;
+    int n = bucket_tokens_select(btk);
+
+    t = btk->prev_toks;
+    btk->prev_toks = btk->cur_toks;
+    btk->prev_toks_cnt = n;
+    btk->cur_toks = t;
+
+    bucket_tokens_frame_reset(btk);
+    btk->generation++;
+    return n;
+}
+
+#endif // USE_DECODER_V2_2
@@ -0,0 +1,220 @@
+// device bench of the bucket token store against the library HeapTokens,
+// which only exists in Library.a, so unlike the select check in
+// host_test/test_bucket_tokens.c this runs on the target only. built in the
+// RAM_BENCH configuration of Demo.wmproject, not in the product
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bucket_tokens.h"
+#include "lib_witin_kws/lib_witin_kws.h"
+
+#if defined(USE_DECODER_V2_2) && defined(BUCKET_TOKENS_BENCH)
+
+#include "kws_multi_decoder.h"
+
+#ifdef PLATFORM_RSIC_V_N307
+#include "WTM2101.h"
+#define BENCH_NOW()     ((uint64_t)__get_rv_cycle())
+#define BENCH_UNIT      "cycles"
+#else
+#include <time.h>
+#define BENCH_NOW()     ((uint64_t)clock())
+#define BENCH_UNIT      "clocks"
+#endif
+
+#define BENCH_FRAMES        (1000)
+#define BENCH_EXPAND        (3)     // candidates per kept token, like the arc expansion
+#define BENCH_MAX_WORDS     (32)
+#define BENCH_DECODE_TOKENS (50)    // MAX_DECODE_PATHS of the library decoder
+
+static uint32_t bench_seed;
+
+static int32_t bench_rand(void)
+{
+    bench_seed = bench_seed * 1103515245u + 12345u;
+    return (int32_t)((bench_seed >> 8) & 0xFFFF);
+}
+
+// log-likelihood like weights: a per-frame base plus a spread of a few
+// hundred steps of 1/256, with repeats so the cutoff has ties
+static void bench_make_frame(TOKEN* cand, int n, int frame)
+{
+    int32_t base = -frame * 256;
+    for (int i = 0; i < n; i++) {
+        memset(&cand[i], 0, sizeof(TOKEN));
+        cand[i].weight = base - (bench_rand() % 2400) / 3 * 3;
+        cand[i].id = (int16_t)i;
+    }
+}
+
+static int bench_cmp_wgt(const void* a, const void* b)
+{
+    int32_t wa = *(const int32_t*)a;
+    int32_t wb = *(const int32_t*)b;
+    return (wa > wb) - (wa < wb);
+}
+
+static void bench_free(void* p)
+{
+    if (p != NULL) {
+        OsalFree(p);
+    }
+}
+
+static int bench_one(int n)
+{
+    int n_cand = n * BENCH_EXPAND;
+    TOKEN* cand = (TOKEN*)OsalMalloc(n_cand * sizeof(TOKEN));
+    TOKEN* pool = (TOKEN*)OsalMalloc(n * sizeof(TOKEN));
+    TOKEN** heap = (TOKEN**)OsalMalloc(n * sizeof(TOKEN*));
+    int32_t* wh = (int32_t*)OsalMalloc(n * sizeof(int32_t));
+    int32_t* wb = (int32_t*)OsalMalloc(n * sizeof(int32_t));
+    BucketTokens* btk = bucket_tokens_init(n, n_cand);
+    HeapTokens htks;
+    uint64_t t_heap = 0;
+    uint64_t t_bucket = 0;
+    int mismatch = 0;
+
+    if (cand == NULL || pool == NULL || heap == NULL || wh == NULL || wb == NULL || btk == NULL) {
+        printf("bucket_tokens_bench: no memory\n");
+        mismatch = -1;
+        goto out;
+    }
+
+    // the heap side only needs the current token pointers, owned here
+    memset(&htks, 0, sizeof(htks));
+    htks.cur_toks = heap;
+
+    bench_seed = 2101;
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        uint64_t t0, t1, t2;
+
+        bench_make_frame(cand, n_cand, f);
+
+        t0 = BENCH_NOW();
+        htks.cur_toks_cnt = 0;
+        for (int i = 0; i < n_cand; i++) {
+            if (htks.cur_toks_cnt < n) {
+                TOKEN* t = &pool[htks.cur_toks_cnt];
+                *t = cand[i];
+                append_sort_heap(&htks, t);
+            } else {
+                TOKEN* worst = get_worst_token_by_map(&htks);
+                if (cand[i].weight > worst->weight) {
+                    *worst = cand[i];
+                    updata_sort_heap_top(&htks, 0);
+                }
+            }
+        }
+        t1 = BENCH_NOW();
+        for (int i = 0; i < n_cand; i++) {
+            bucket_tokens_append(btk, &cand[i]);
+        }
+        bucket_tokens_exchange_to_another(btk);
+        t2 = BENCH_NOW();
+
+        t_heap += t1 - t0;
+        t_bucket += t2 - t1;
+
+        // same kept weights, the heap keeps no order among the survivors
+        if (htks.cur_toks_cnt != btk->prev_toks_cnt) {
+            mismatch++;
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            wh[i] = htks.cur_toks[i]->weight;
+            wb[i] = btk->prev_toks[i].weight;
+        }
+        qsort(wh, n, sizeof(int32_t), bench_cmp_wgt);
+        qsort(wb, n, sizeof(int32_t), bench_cmp_wgt);
+        if (memcmp(wh, wb, n * sizeof(int32_t)) != 0) {
+            mismatch++;
+        }
+    }
+
+    printf("tokens %3d: heap %8u %s, bucket %8u %s, mismatch frames %d\n",
+           n, (uint32_t)t_heap, BENCH_UNIT, (uint32_t)t_bucket, BENCH_UNIT, mismatch);
+
+out:
+    bucket_tokens_release(btk);
+    bench_free(wb);
+    bench_free(wh);
+    bench_free(heap);
+    bench_free(pool);
+    bench_free(cand);
+    return mismatch;
+}
+
+void bucket_tokens_bench(void)
+{
+    static const int bench_n[] = { 20, 50, 100 };
+
+    for (int i = 0; i < (int)(sizeof(bench_n) / sizeof(bench_n[0])); i++) {
+        bench_one(bench_n[i]);
+    }
+}
+
+static int bench_words[2][BENCH_MAX_WORDS];
+static int bench_word_cnt[2];
+static int bench_store;
+
+static void bench_on_words(int kws_id, const CallBackKeyWordsType* words)
+{
+    (void)kws_id;
+    if (bench_word_cnt[bench_store] < BENCH_MAX_WORDS) {
+        bench_words[bench_store][bench_word_cnt[bench_store]++] = words->id;
+    }
+}
+
+// one pass of the decoder over the recording, store 0 heap, 1 bucket
+static int bench_decode(const int8_t* nnet, int8_t* frame, int frames, int kws_id, uint8_t rshift, int store)
+{
+    KWS_MULTI_GRAPH_CFG cfg = { kws_id, BENCH_DECODE_TOKENS, BENCH_DECODE_TOKENS, 1, INT32_MIN, store == 0 };
+    int32_t dim = WitinKwsGetNnetOutDimension();
+
+    if (kws_multi_init(&cfg, 1, 0, rshift) != 0)
+        return -2;
+
+    bench_store = store;
+    bench_word_cnt[store] = 0;
+    for (int f = 0; f < frames; f++) {
+        memcpy(frame, nnet + f * dim, dim);
+        kws_multi_decode_one_frame(frame);
+    }
+    kws_multi_release();
+    return 0;
+}
+
+int bucket_tokens_decode_check(const int8_t* nnet, int frames, int kws_id, uint8_t rshift)
+{
+    int8_t* frame = (int8_t*)OsalMalloc(WitinKwsGetNnetOutDimension());
+    int diff = 0;
+
+    if (frame == NULL)
+        return -1;
+
+    // the decoder may work on the frame in place, each pass gets a copy
+    kws_multi_set_on_words(bench_on_words);
+    if (bench_decode(nnet, frame, frames, kws_id, rshift, 0) != 0 ||
+        bench_decode(nnet, frame, frames, kws_id, rshift, 1) != 0) {
+        kws_multi_set_on_words(NULL);
+        OsalFree(frame);
+        return -2;
+    }
+    kws_multi_set_on_words(NULL);
+
+    if (bench_word_cnt[0] != bench_word_cnt[1]) {
+        diff++;
+    }
+    for (int i = 0; i < bench_word_cnt[0] && i < bench_word_cnt[1]; i++) {
+        diff += bench_words[0][i] != bench_words[1][i];
+    }
+    printf("decode check: %d frames, heap %d words, bucket %d words, differences %d\n",
+           frames, bench_word_cnt[0], bench_word_cnt[1], diff);
+
+    OsalFree(frame);
+    return diff;
+}
+
+#endif // BUCKET_TOKENS_BENCH
@@ -0,0 +1,46 @@
+#include <string.h>
+#include "byte_map.h"
+#include "lib_witin_kws/lib_witin_kws.h"
+
+// only the stamped map lives here, byte_map_for_arc1 and its functions
+// come from Library.a
+
+ByteMapStamped* byte_map_stamped_init(int num_states)
+{
+    ByteMapStamped* map;
+
+    if (num_states <= 0)
+        return NULL;
+
+    map = (ByteMapStamped*)OsalMalloc(sizeof(ByteMapStamped));
+    if (map == NULL)
+        return NULL;
+    map->entry = (uint32_t*)OsalMalloc(num_states * sizeof(uint32_t));
+    if (map->entry == NULL) {
+        OsalFree(map);
+        return NULL;
+    }
+    map->num_states = num_states;
+    memset(map->entry, 0, num_states * sizeof(uint32_t));
+    map->stamp = 1;
+    return map;
+}
+
+void byte_map_stamped_release(ByteMapStamped* map)
+{
+    if (map == NULL)
+        return;
+    if (map->entry != NULL) {
+        OsalFree(map->entry);
+    }
+    OsalFree(map);
+}
+
+void byte_map_stamped_clear(ByteMapStamped* map)
+{
+    map->stamp++;
+    if (map->stamp == 0) {
+        memset(map->entry, 0, map->num_states * sizeof(uint32_t));
+        map->stamp = 1;
+    }
+}
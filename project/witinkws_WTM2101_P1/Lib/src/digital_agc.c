@@ -0,0 +1,225 @@
+#include <stddef.h>
+#include <string.h>
+#include "digital_agc.h"
+
+#ifdef PLATFORM_RSIC_V_N307
+#include "riscv_math.h"
+#endif
+
+// share of a gap closed per block for a time constant of ms
+static int16_t digital_agc_coef(uint32_t sample_rate, uint16_t block, uint32_t ms)
+{
+    uint32_t span = sample_rate / 1000 * ms;
+    uint32_t coef = span ? (uint32_t)(32768ull * block / span) : 32767;
+
+    return coef > 32767 ? 32767 : (int16_t)coef;
+}
+
+static int32_t digital_agc_peak(const int16_t *in, uint16_t num)
+{
+    int32_t peak = 0;
+
+    for (uint16_t i = 0; i < num; i++) {
+        int32_t v = in[i] < 0 ? -(int32_t)in[i] : in[i];
+
+        if (v > peak) {
+            peak = v;
+        }
+    }
+    return peak;
+}
+
+// the highest gain that keeps a peak under the limit
+static int32_t digital_agc_limit(const digital_agc_t *agc, int32_t peak)
+{
+    int32_t lim = peak ? ((int32_t)agc->limit << 10) / peak : DIGITAL_AGC_MAX_GAIN;
+
+    return lim > DIGITAL_AGC_MAX_GAIN ? DIGITAL_AGC_MAX_GAIN : lim;
+}
+
+static int16_t digital_agc_sat(int32_t v)
+{
+    return v > 32767 ? 32767 : (v < -32768 ? -32768 : (int16_t)v);
+}
+
+static void digital_agc_scale(const int16_t *in, int16_t *out, uint16_t num, int32_t gain)
+{
+#ifdef PLATFORM_RSIC_V_N307
+    // (x * gain) >> (15 - 5), the same as the C loop
+    if (gain <= 32767) {
+        riscv_scale_q15((q15_t *)in, (q15_t)gain, 5, out, num);
+        return;
+    }
+#endif
+    for (uint16_t i = 0; i < num; i++) {
+        out[i] = digital_agc_sat(((int32_t)in[i] * gain) >> 10);
+    }
+}
+
+// gain from g0 towards g1 sample by sample, g1 on the last one
+static void digital_agc_ramp(const int16_t *in, int16_t *out, uint16_t num, int32_t g0, int32_t g1)
+{
+    int32_t step = (g1 - g0) * 256 / num;
+    int32_t acc = g0 * 256;
+
+    for (uint16_t i = 0; i < num; i++) {
+        acc += step;
+        out[i] = digital_agc_sat(((int32_t)in[i] * (acc >> 8)) >> 10);
+    }
+}
+
+int digital_agc_init(digital_agc_t *agc, uint32_t sample_rate, uint16_t block)
+{
+    if (agc == NULL || sample_rate < 1000 || block == 0 || block > DIGITAL_AGC_MAX_BLOCK)
+        return -1;
+
+    memset(agc, 0, sizeof(*agc));
+    agc->block = block;
+    agc->target = 8231;                         // -12 dBFS
+    agc->limit = 29205;                         // -1 dBFS
+    agc->noise_floor = 104;                     // -50 dBFS
+    agc->min_gain = DIGITAL_AGC_GAIN_ONE / 4;   // -12 dB
+    agc->max_gain = 32382;                      // +30 dB
+    agc->rise_q15 = digital_agc_coef(sample_rate, block, 1500);
+    agc->env_release_q15 = digital_agc_coef(sample_rate, block, 300);
+    digital_agc_reset(agc);
+    return 0;
+}
+
+void digital_agc_reset(digital_agc_t *agc)
+{
+    agc->gain = DIGITAL_AGC_GAIN_ONE;
+    agc->env = 0;
+    agc->peak = 0;
+    agc->cur = 0;
+    agc->ana_count = 0;
+    memset(agc->delay, 0, sizeof(agc->delay));
+}
+
+int digital_agc_set_analog(digital_agc_t *agc, int (*ana_set)(int code), int code, int min, int max,
+                           uint32_t sample_rate)
+{
+    if (agc == NULL || ana_set == NULL || min < 0 || max > 63 || min > max || code < min || code > max)
+        return -1;
+
+    agc->ana_set = ana_set;
+    agc->ana_code = (int8_t)code;
+    agc->ana_min = (int8_t)min;
+    agc->ana_max = (int8_t)max;
+    agc->clip_level = 32133;                    // -0.17 dBFS
+    agc->ana_up = 4 * DIGITAL_AGC_GAIN_ONE;
+    agc->ana_down = DIGITAL_AGC_GAIN_ONE;
+    agc->ana_hold = (uint16_t)(sample_rate / agc->block);
+    agc->ana_count = 0;
+    return 0;
+}
+
+// one analog code per decision, the gain and envelope are moved with it
+// so the output level stays. in_peak is the raw block just captured
+static void digital_agc_analog(digital_agc_t *agc, int32_t in_peak)
+{
+    int step = 0;
+    int64_t g;
+
+    if (agc->gain > agc->ana_up && agc->ana_code < agc->ana_max) {
+        agc->ana_count = agc->ana_count > 0 ? agc->ana_count + 1 : 1;
+    } else if (agc->gain < agc->ana_down && agc->ana_code > agc->ana_min) {
+        agc->ana_count = agc->ana_count < 0 ? agc->ana_count - 1 : -1;
+    } else {
+        agc->ana_count = 0;
+    }
+
+    if (in_peak >= agc->clip_level && agc->ana_code > agc->ana_min) {
+        step = -1;
+    } else if (agc->ana_count >= (int16_t)agc->ana_hold) {
+        step = 1;
+    } else if (-agc->ana_count >= (int16_t)agc->ana_hold) {
+        step = -1;
+    }
+    if (step == 0)
+        return;
+
+    agc->ana_count = 0;
+    if (agc->ana_set(agc->ana_code + step) != 0)
+        return;
+
+    agc->ana_code += step;
+    agc->ana_steps++;
+    if (step > 0) {
+        g = ((int64_t)agc->gain * DIGITAL_AGC_ANA_DOWN_Q15) >> 15;
+        agc->env = (int32_t)(((int64_t)agc->env * DIGITAL_AGC_ANA_UP_Q15) >> 15);
+        if (agc->env > 32767) {
+            agc->env = 32767;
+        }
+    } else {
+        int32_t lim = digital_agc_limit(agc, agc->peak);
+
+        g = ((int64_t)agc->gain * DIGITAL_AGC_ANA_UP_Q15) >> 15;
+        if (g > agc->max_gain) {
+            g = agc->max_gain;
+        }
+        if (g > lim) {
+            g = lim;
+        }
+        agc->env = (int32_t)(((int64_t)agc->env * DIGITAL_AGC_ANA_DOWN_Q15) >> 15);
+    }
+    agc->gain = (int32_t)g;
+}
+
+void digital_agc_process(digital_agc_t *agc, const int16_t *in, int16_t *out)
+{
+    int16_t *prev = agc->delay[agc->cur];
+    int32_t peak = digital_agc_peak(in, agc->block);
+    int32_t g0 = agc->gain;
+    int32_t g1, desired, lim;
+
+    // in first, out may be in
+    memcpy(agc->delay[agc->cur ^ 1], in, agc->block * sizeof(int16_t));
+
+    if (peak > agc->env) {
+        agc->env = peak;
+    } else {
+        agc->env -= ((agc->env - peak) * agc->env_release_q15) >> 15;
+    }
+
+    if (agc->env < agc->noise_floor) {
+        desired = g0;
+    } else {
+        desired = ((int32_t)agc->target << 10) / agc->env;
+        if (desired > agc->max_gain) {
+            desired = agc->max_gain;
+        }
+        if (desired < agc->min_gain) {
+            desired = agc->min_gain;
+        }
+    }
+
+    // down at once, up slowly
+    if (desired < g0) {
+        g1 = desired;
+    } else {
+        g1 = g0 + (((desired - g0) * agc->rise_q15) >> 15);
+    }
+
+    // g0 already fits the delayed block, g1 has to fit it and the next
+    lim = digital_agc_limit(agc, peak > agc->peak ? peak : agc->peak);
+    if (g1 > lim) {
+        g1 = lim;
+        agc->limited_blocks++;
+    }
+
+    if (g1 == g0) {
+        digital_agc_scale(prev, out, agc->block, g0);
+    } else {
+        digital_agc_ramp(prev, out, agc->block, g0, g1);
+    }
+
+    agc->peak = peak;
+    agc->gain = g1;
+    agc->cur ^= 1;
+    agc->blocks++;
+
+    if (agc->ana_set != NULL) {
+        digital_agc_analog(agc, peak);
+    }
+}
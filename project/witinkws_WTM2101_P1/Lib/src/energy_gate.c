@@ -0,0 +1,207 @@
+#include <math.h>
+#include <string.h>
+#include "energy_gate.h"
+
+#ifdef PLATFORM_RSIC_V_N307
+#include "riscv_math.h"
+#endif
+
+// coefficients are stored halved, a1 of a band pass reaches -2
+#define ENERGY_GATE_POST_SHIFT      (1)
+
+static const uint16_t energy_gate_edges[ENERGY_GATE_BANDS + 1] = {300, 800, 2000, 4000};
+
+#ifdef PLATFORM_RSIC_V_N307
+
+static void energy_gate_biquad(int16_t *coeffs, int16_t *state, const int16_t *in, int16_t *out, uint32_t num)
+{
+    riscv_biquad_casd_df1_inst_q15 inst;
+
+    inst.numStages = 1;
+    inst.pState = state;
+    inst.pCoeffs = coeffs;
+    inst.postShift = ENERGY_GATE_POST_SHIFT;
+    riscv_biquad_cascade_df1_q15(&inst, in, out, num);
+}
+
+#else
+
+// the plain C path of riscv_biquad_cascade_df1_q15, one stage, q63 sum
+static void energy_gate_biquad(int16_t *coeffs, int16_t *state, const int16_t *in, int16_t *out, uint32_t num)
+{
+    int32_t x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+    for (uint32_t n = 0; n < num; n++) {
+        int64_t acc = (int64_t)coeffs[0] * in[n] + (int64_t)coeffs[2] * x1 + (int64_t)coeffs[3] * x2 +
+                      (int64_t)coeffs[4] * y1 + (int64_t)coeffs[5] * y2;
+        acc >>= 15 - ENERGY_GATE_POST_SHIFT;
+        acc = acc > 32767 ? 32767 : (acc < -32768 ? -32768 : acc);
+        x2 = x1;
+        x1 = in[n];
+        y2 = y1;
+        y1 = (int32_t)acc;
+        out[n] = (int16_t)acc;
+    }
+    state[0] = (int16_t)x1;
+    state[1] = (int16_t)x2;
+    state[2] = (int16_t)y1;
+    state[3] = (int16_t)y2;
+}
+
+#endif
+
+static int16_t energy_gate_q14(float v)
+{
+    float q = v * (1 << (15 - ENERGY_GATE_POST_SHIFT));
+    return (int16_t)(q >= 32767.0f ? 32767 : (q <= -32768.0f ? -32768 : lroundf(q)));
+}
+
+int energy_gate_init(energy_gate_t *gate, uint32_t sample_rate, uint16_t block)
+{
+    if (gate == NULL || sample_rate == 0 || block == 0 || block > ENERGY_GATE_MAX_BLOCK)
+        return -1;
+
+    memset(gate, 0, sizeof(energy_gate_t));
+    gate->block = block;
+    gate->on_ratio = 64;
+    gate->off_ratio = 32;
+    gate->hangover = 30;
+    gate->min_floor = 64;
+
+    // constant 0 dB peak band pass per band, cut at 0.45 fs
+    for (int b = 0; b < ENERGY_GATE_BANDS; b++) {
+        float f1 = energy_gate_edges[b];
+        float f2 = energy_gate_edges[b + 1];
+        float w0, alpha, a0;
+
+        if (f2 > 0.45f * sample_rate) {
+            f2 = 0.45f * sample_rate;
+        }
+        if (f1 >= f2)
+            return -1;
+        w0 = 6.28318530718f * sqrtf(f1 * f2) / sample_rate;
+        alpha = sinf(w0) * (f2 - f1) / (2.0f * sqrtf(f1 * f2));
+        a0 = 1.0f + alpha;
+
+        gate->coeffs[b][0] = energy_gate_q14(alpha / a0);
+        gate->coeffs[b][1] = 0;
+        gate->coeffs[b][2] = 0;
+        gate->coeffs[b][3] = energy_gate_q14(-alpha / a0);
+        gate->coeffs[b][4] = energy_gate_q14(2.0f * cosf(w0) / a0);
+        gate->coeffs[b][5] = energy_gate_q14(-(1.0f - alpha) / a0);
+    }
+
+    energy_gate_reset(gate);
+    return 0;
+}
+
+void energy_gate_reset(energy_gate_t *gate)
+{
+    memset(gate->state, 0, sizeof(gate->state));
+    memset(gate->energy, 0, sizeof(gate->energy));
+    memset(gate->floor, 0, sizeof(gate->floor));
+    gate->open = 0;
+    gate->hold = 0;
+    gate->blocks = 0;
+    gate->open_blocks = 0;
+    gate->hist_pos = 0;
+    gate->hist_count = 0;
+}
+
+int energy_gate_push(energy_gate_t *gate, const int16_t *pcm)
+{
+    int16_t band_out[ENERGY_GATE_MAX_BLOCK];
+    int above_on = 0;
+    int above_off = 0;
+    int ret;
+
+    gate->hist_pos = (uint16_t)(gate->hist_count == 0 ? 0 : (gate->hist_pos + 1) % ENERGY_GATE_LOOKBACK);
+    if (gate->hist_count < ENERGY_GATE_LOOKBACK) {
+        gate->hist_count++;
+    }
+    memcpy(gate->hist[gate->hist_pos], pcm, gate->block * sizeof(int16_t));
+
+    for (int b = 0; b < ENERGY_GATE_BANDS; b++) {
+        uint64_t sum = 0;
+        uint32_t e;
+        uint32_t fl;
+
+        energy_gate_biquad(gate->coeffs[b], gate->state[b], pcm, band_out, gate->block);
+        for (int n = 0; n < gate->block; n++) {
+            sum += (uint32_t)((int32_t)band_out[n] * band_out[n]);
+        }
+        e = (uint32_t)(sum / gate->block);
+
+        if (gate->blocks == 0) {
+            gate->energy[b] = e;
+            gate->floor[b] = e;
+        }
+        gate->energy[b] = (uint32_t)(((uint64_t)gate->energy[b] + e) >> 1);
+
+        // fast down, slow up, slower still while the gate is open
+        fl = gate->floor[b];
+        if (gate->energy[b] < fl) {
+            fl -= (fl - gate->energy[b]) >> 2;
+        } else {
+            fl += (gate->energy[b] - fl) >> (ENERGY_GATE_FLOOR_RISE + (gate->open ? 3 : 0));
+        }
+        gate->floor[b] = fl < gate->min_floor ? gate->min_floor : fl;
+
+        if ((uint64_t)gate->energy[b] * 16 > (uint64_t)gate->floor[b] * gate->on_ratio) {
+            above_on = 1;
+        }
+        if ((uint64_t)gate->energy[b] * 16 > (uint64_t)gate->floor[b] * gate->off_ratio) {
+            above_off = 1;
+        }
+    }
+
+    if (!gate->open) {
+        if (above_on) {
+            gate->open = 1;
+            gate->hold = gate->hangover;
+            ret = ENERGY_GATE_ONSET;
+        } else {
+            ret = ENERGY_GATE_CLOSED;
+        }
+    } else {
+        if (above_off) {
+            gate->hold = gate->hangover;
+        } else if (gate->hold > 0) {
+            gate->hold--;
+        } else {
+            gate->open = 0;
+        }
+        ret = gate->open ? ENERGY_GATE_OPEN : ENERGY_GATE_CLOSED;
+    }
+
+    gate->blocks++;
+    if (ret != ENERGY_GATE_CLOSED) {
+        gate->open_blocks++;
+    }
+    return ret;
+}
+
+int energy_gate_history_count(const energy_gate_t *gate)
+{
+    return gate->hist_count;
+}
+
+const int16_t *energy_gate_history(const energy_gate_t *gate, int i)
+{
+    int slot;
+
+    if (i < 0 || i >= gate->hist_count)
+        return NULL;
+    slot = gate->hist_pos - (gate->hist_count - 1) + i;
+    if (slot < 0) {
+        slot += ENERGY_GATE_LOOKBACK;
+    }
+    return gate->hist[slot];
+}
+
+uint32_t energy_gate_duty(const energy_gate_t *gate)
+{
+    if (gate->blocks == 0)
+        return 0;
+    return (uint32_t)((uint64_t)gate->open_blocks * 1000 / gate->blocks);
+}
@@ -0,0 +1,118 @@
+#include "fbank_dual_fft.h"
+
+#ifdef PLATFORM_RSIC_V_N307
+#include "riscv_math.h"
+#include "riscv_const_structs.h"
+#else
+#include <math.h>
+#endif
+
+// interleaved re/im, q15
+static int16_t dual_buf[2 * FBANK_DUAL_FFT_N];
+
+#ifdef PLATFORM_RSIC_V_N307
+
+static void dual_cfft(int16_t* z)
+{
+    riscv_cfft_q15(&riscv_cfft_sR_q15_len512, z, 0, 1);
+}
+
+#else
+
+#define DUAL_FFT_BITS           (9)
+
+static int16_t dual_cos[FBANK_DUAL_FFT_N / 2];
+static int16_t dual_sin[FBANK_DUAL_FFT_N / 2];
+static int dual_tw_ready = 0;
+
+// radix-2 DIT, every stage scaled by 1/2 like the q15 cfft, rounded
+static void dual_cfft(int16_t* z)
+{
+    if (!dual_tw_ready) {
+        for (int k = 0; k < FBANK_DUAL_FFT_N / 2; k++) {
+            double a = 2.0 * 3.14159265358979323846 * k / FBANK_DUAL_FFT_N;
+            long c = lround(cos(a) * 32768.0);
+            dual_cos[k] = (int16_t)(c > 32767 ? 32767 : c);
+            dual_sin[k] = (int16_t)lround(-sin(a) * 32768.0);
+        }
+        dual_tw_ready = 1;
+    }
+
+    for (int i = 0; i < FBANK_DUAL_FFT_N; i++) {
+        int r = 0;
+        for (int b = 0; b < DUAL_FFT_BITS; b++) {
+            r = (r << 1) | ((i >> b) & 1);
+        }
+        if (r > i) {
+            int16_t t0 = z[2 * i];
+            int16_t t1 = z[2 * i + 1];
+            z[2 * i] = z[2 * r];
+            z[2 * i + 1] = z[2 * r + 1];
+            z[2 * r] = t0;
+            z[2 * r + 1] = t1;
+        }
+    }
+
+    for (int len = 2, step = FBANK_DUAL_FFT_N / 2; len <= FBANK_DUAL_FFT_N; len <<= 1, step >>= 1) {
+        int half = len / 2;
+        for (int st = 0; st < FBANK_DUAL_FFT_N; st += len) {
+            for (int j = 0; j < half; j++) {
+                int16_t* p = &z[2 * (st + j)];
+                int16_t* q = &z[2 * (st + j + half)];
+                int32_t c = dual_cos[j * step];
+                int32_t s = dual_sin[j * step];
+                int32_t tr = (q[0] * c - q[1] * s + (1 << 14)) >> 15;
+                int32_t ti = (q[0] * s + q[1] * c + (1 << 14)) >> 15;
+
+                q[0] = (int16_t)((p[0] - tr + 1) >> 1);
+                q[1] = (int16_t)((p[1] - ti + 1) >> 1);
+                p[0] = (int16_t)((p[0] + tr + 1) >> 1);
+                p[1] = (int16_t)((p[1] + ti + 1) >> 1);
+            }
+        }
+    }
+}
+
+#endif
+
+static int32_t dual_half(int32_t v)
+{
+    return (v + 1) >> 1;
+}
+
+void fbank_dual_fft(const int16_t* a, const int16_t* b, int32_t* spec_a, int32_t* spec_b)
+{
+    for (int n = 0; n < FBANK_DUAL_FFT_N; n++) {
+        dual_buf[2 * n] = a[n];
+        dual_buf[2 * n + 1] = b[n];
+    }
+    dual_cfft(dual_buf);
+
+    // Z*[N-k] for k = 0 is Z*[0], bin N/2 is dropped as in fft_calculate
+    for (int k = 0; k < FBANK_DUAL_FFT_N / 2; k++) {
+        int m = (FBANK_DUAL_FFT_N - k) & (FBANK_DUAL_FFT_N - 1);
+        int32_t zr = dual_buf[2 * k];
+        int32_t zi = dual_buf[2 * k + 1];
+        int32_t cr = dual_buf[2 * m];
+        int32_t ci = dual_buf[2 * m + 1];
+
+        spec_a[2 * k] = dual_half(zr + cr);
+        spec_a[2 * k + 1] = dual_half(zi - ci);
+        spec_b[2 * k] = dual_half(zi + ci);
+        spec_b[2 * k + 1] = dual_half(cr - zr);
+    }
+}
+
+void fbank_dual_fft_single(const int16_t* x, int32_t* spec)
+{
+    for (int n = 0; n < FBANK_DUAL_FFT_N; n++) {
+        dual_buf[2 * n] = x[n];
+        dual_buf[2 * n + 1] = 0;
+    }
+    dual_cfft(dual_buf);
+
+    for (int k = 0; k < FBANK_DUAL_FFT_N / 2; k++) {
+        spec[2 * k] = dual_buf[2 * k];
+        spec[2 * k + 1] = dual_buf[2 * k + 1];
+    }
+}
@@ -0,0 +1,129 @@
+#include <string.h>
+#include "fbank_mel_q15.h"
+#include "fbank_ref.h"
+
+// pair p covers fft bins 2p and 2p+1. mel bins pair_mel[p] ..
+// pair_mel[p] + pair_cnt[p] - 1 take the packed weights
+// pair_wgt[pair_ofs[p] ..], low half for bin 2p, high half for bin 2p+1
+static uint8_t pair_mel[FBANK_MEL_Q15_PAIRS];
+static uint8_t pair_cnt[FBANK_MEL_Q15_PAIRS];
+static uint16_t pair_ofs[FBANK_MEL_Q15_PAIRS];
+static uint32_t pair_wgt[FBANK_MEL_Q15_PAIRS * FBANK_MEL_Q15_MAX_COVER];
+static uint16_t pair_first = 0;
+static uint16_t pair_last = 0;
+
+// FBANK_FILTERS weights are Q16, one bit less keeps them positive in Q15
+static int16_t fbank_mel_q15_weight(const fbank_cfg_t* cfg, int k)
+{
+    if (k < cfg->start || k > cfg->end)
+        return 0;
+    return (int16_t)(cfg->melfiter[k - cfg->start] >> 1);
+}
+
+int fbank_mel_q15_init(void)
+{
+    uint16_t ofs = 0;
+    int lo = FBANK_MEL_Q15_BINS;
+    int hi = 0;
+
+    memset(pair_cnt, 0, sizeof(pair_cnt));
+
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        const fbank_cfg_t* cfg = &FBANK_FILTERS[m];
+        if (cfg->end >= FBANK_MEL_Q15_BINS || cfg->start > cfg->end)
+            return -1;
+        if (cfg->start < lo) {
+            lo = cfg->start;
+        }
+        if (cfg->end > hi) {
+            hi = cfg->end;
+        }
+    }
+
+    for (int p = lo / 2; p <= hi / 2; p++) {
+        int first = -1;
+        int last = -1;
+
+        for (int m = 0; m < _NUM_MEL_BINS; m++) {
+            if (fbank_mel_q15_weight(&FBANK_FILTERS[m], 2 * p) != 0 ||
+                fbank_mel_q15_weight(&FBANK_FILTERS[m], 2 * p + 1) != 0) {
+                if (first < 0) {
+                    first = m;
+                }
+                last = m;
+            }
+        }
+        pair_ofs[p] = ofs;
+        if (first < 0)
+            continue;
+        if (last - first + 1 > FBANK_MEL_Q15_MAX_COVER)
+            return -2;
+
+        pair_mel[p] = (uint8_t)first;
+        pair_cnt[p] = (uint8_t)(last - first + 1);
+        for (int m = first; m <= last; m++) {
+            uint16_t w0 = (uint16_t)fbank_mel_q15_weight(&FBANK_FILTERS[m], 2 * p);
+            uint16_t w1 = (uint16_t)fbank_mel_q15_weight(&FBANK_FILTERS[m], 2 * p + 1);
+            pair_wgt[ofs++] = ((uint32_t)w1 << 16) | w0;
+        }
+    }
+
+    pair_first = (uint16_t)(lo / 2);
+    pair_last = (uint16_t)(hi / 2);
+    return 0;
+}
+
+// lo*lo + hi*hi of two packed int16 pairs
+static inline int64_t fbank_mel_q15_mac(int64_t acc, uint32_t a, uint32_t b)
+{
+    acc += (int32_t)(int16_t)a * (int32_t)(int16_t)b;
+    acc += (int32_t)(int16_t)(a >> 16) * (int32_t)(int16_t)(b >> 16);
+    return acc;
+}
+
+void fbank_mel_q15(const int16_t* mag, int32_t* mel)
+{
+    const uint32_t* mag2 = (const uint32_t*)mag;
+    int64_t acc[_NUM_MEL_BINS + FBANK_MEL_Q15_MAX_COVER];
+
+    memset(acc, 0, sizeof(acc));
+
+    for (int p = pair_first; p <= pair_last; p++) {
+        uint32_t d = mag2[p];
+        const uint32_t* w = &pair_wgt[pair_ofs[p]];
+        int64_t* a = &acc[pair_mel[p]];
+
+        // straight line for the common counts, the plan holds no zeros
+        switch (pair_cnt[p]) {
+        case 3:
+            a[2] = fbank_mel_q15_mac(a[2], d, w[2]);
+            // fall through
+        case 2:
+            a[1] = fbank_mel_q15_mac(a[1], d, w[1]);
+            // fall through
+        case 1:
+            a[0] = fbank_mel_q15_mac(a[0], d, w[0]);
+            break;
+        default:
+            break;
+        }
+    }
+
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        mel[m] = (int32_t)(acc[m] >> 15);
+    }
+}
+
+void fbank_mel_q15_scalar(const int16_t* mag, int32_t* mel)
+{
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        const fbank_cfg_t* cfg = &FBANK_FILTERS[m];
+        int len = fbank_ref_mel_len(cfg);
+        int64_t acc = 0;
+
+        for (int i = 0; i < len; i++) {
+            acc += (int32_t)mag[cfg->start + i] * (int32_t)(int16_t)(cfg->melfiter[i] >> 1);
+        }
+        mel[m] = (int32_t)(acc >> 15);
+    }
+}
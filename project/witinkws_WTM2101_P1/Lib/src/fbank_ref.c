@@ -0,0 +1,293 @@
+#include <string.h>
+#include "fbank_ref.h"
+
+// sin(2*pi*k/512) in Q15 for k = 0..128, a table instead of libm so the
+// twiddles are the same on every platform
+static const int16_t fbank_ref_sin_q15[129] = {
+        0,   402,   804,  1206,  1608,  2009,  2411,  2811,  3212,  3612,  4011,  4410,
+     4808,  5205,  5602,  5998,  6393,  6787,  7180,  7571,  7962,  8351,  8740,  9127,
+     9512,  9896, 10279, 10660, 11039, 11417, 11793, 12167, 12540, 12910, 13279, 13646,
+    14010, 14373, 14733, 15091, 15447, 15800, 16151, 16500, 16846, 17190, 17531, 17869,
+    18205, 18538, 18868, 19195, 19520, 19841, 20160, 20475, 20788, 21097, 21403, 21706,
+    22006, 22302, 22595, 22884, 23170, 23453, 23732, 24008, 24279, 24548, 24812, 25073,
+    25330, 25583, 25833, 26078, 26320, 26557, 26791, 27020, 27246, 27467, 27684, 27897,
+    28106, 28311, 28511, 28707, 28899, 29086, 29269, 29448, 29622, 29792, 29957, 30118,
+    30274, 30425, 30572, 30715, 30853, 30986, 31114, 31238, 31357, 31471, 31581, 31686,
+    31786, 31881, 31972, 32058, 32138, 32214, 32286, 32352, 32413, 32470, 32522, 32568,
+    32610, 32647, 32679, 32706, 32729, 32746, 32758, 32766, 32767,
+};
+
+#define FBANK_REF_CFFT_N        (_NFFT / 2)
+#define FBANK_REF_CFFT_BITS     (8)
+
+// e^(-j*2*pi*k/512), k = 0..255
+static void fbank_ref_twiddle(int k, int32_t* c, int32_t* s)
+{
+    if (k <= 128) {
+        *c = fbank_ref_sin_q15[128 - k];
+        *s = -fbank_ref_sin_q15[k];
+    } else {
+        *c = -fbank_ref_sin_q15[k - 128];
+        *s = -fbank_ref_sin_q15[256 - k];
+    }
+}
+
+static int32_t fbank_ref_round_shift(int64_t v, int shift)
+{
+    return (int32_t)((v + ((int64_t)1 << (shift - 1))) >> shift);
+}
+
+static uint32_t fbank_ref_bitrev(uint32_t i)
+{
+    uint32_t r = 0;
+    for (int b = 0; b < FBANK_REF_CFFT_BITS; b++) {
+        r = (r << 1) | ((i >> b) & 1);
+    }
+    return r;
+}
+
+void fbank_ref_window(int32_t* words)
+{
+    for (int i = 0; i < _WIN_SIZE; i++) {
+        words[i] = (int32_t)(((int64_t)words[i] * povey_win[i]) >> FBANK_REF_WIN_SHIFT);
+    }
+}
+
+// one radix-2 DIT pass over zr/zi in bit reversed order. the forward one
+// halves both inputs of every butterfly (arithmetic shift) before the
+// twiddle, the inverse one runs on conjugate twiddles unscaled
+static void fbank_ref_cfft(int32_t* zr, int32_t* zi, int inverse)
+{
+    for (int len = 2, step = _NFFT / 2; len <= FBANK_REF_CFFT_N; len <<= 1, step >>= 1) {
+        int half = len / 2;
+        for (int st = 0; st < FBANK_REF_CFFT_N; st += len) {
+            for (int j = 0; j < half; j++) {
+                int32_t c, s, tr, ti;
+                int32_t ar = zr[st + j];
+                int32_t ai = zi[st + j];
+                int32_t br = zr[st + j + half];
+                int32_t bi = zi[st + j + half];
+
+                fbank_ref_twiddle(j * step, &c, &s);
+                if (inverse) {
+                    s = -s;
+                } else {
+                    ar >>= 1;
+                    ai >>= 1;
+                    br >>= 1;
+                    bi >>= 1;
+                }
+                tr = fbank_ref_round_shift((int64_t)br * c - (int64_t)bi * s, 15);
+                ti = fbank_ref_round_shift((int64_t)br * s + (int64_t)bi * c, 15);
+                zr[st + j] = ar + tr;
+                zi[st + j] = ai + ti;
+                zr[st + j + half] = ar - tr;
+                zi[st + j + half] = ai - ti;
+            }
+        }
+    }
+}
+
+// 256 point complex fft of z[n] = x[2n] + j*x[2n+1], then the real split
+// X[k] = (Fe + W^k * D / j) / 2 with Fe = Z[k] + Z*[N-k], D = Z[k] - Z*[N-k],
+// both halved first
+void fbank_ref_fft(const int32_t* in, int32_t* out)
+{
+    static int32_t zr[FBANK_REF_CFFT_N];
+    static int32_t zi[FBANK_REF_CFFT_N];
+
+    for (uint32_t n = 0; n < FBANK_REF_CFFT_N; n++) {
+        uint32_t r = fbank_ref_bitrev(n);
+        zr[r] = in[2 * n];
+        zi[r] = in[2 * n + 1];
+    }
+    fbank_ref_cfft(zr, zi, 0);
+
+    // bins k and N-k come from the same pair
+    for (int k = 0; k <= FBANK_REF_CFFT_N / 2; k++) {
+        int m = (FBANK_REF_CFFT_N - k) & (FBANK_REF_CFFT_N - 1);
+        int32_t er = fbank_ref_round_shift((int64_t)zr[k] + zr[m], 1);
+        int32_t ei = fbank_ref_round_shift((int64_t)zi[k] - zi[m], 1);
+        int32_t dr = fbank_ref_round_shift((int64_t)zr[k] - zr[m], 1);
+        int32_t di = fbank_ref_round_shift((int64_t)zi[k] + zi[m], 1);
+        int32_t c, s, tr, ti;
+
+        fbank_ref_twiddle(k, &c, &s);
+        tr = fbank_ref_round_shift((int64_t)dr * c - (int64_t)di * s, 15);
+        ti = fbank_ref_round_shift((int64_t)dr * s + (int64_t)di * c, 15);
+        out[2 * k] = fbank_ref_round_shift((int64_t)er + ti, 1);
+        out[2 * k + 1] = fbank_ref_round_shift((int64_t)ei - tr, 1);
+        if (k != 0 && k != m) {
+            out[2 * m] = fbank_ref_round_shift((int64_t)er - ti, 1);
+            out[2 * m + 1] = fbank_ref_round_shift(-(int64_t)ei - tr, 1);
+        }
+    }
+}
+
+// the split run backwards, Z[k] = Fe + j * W^-k * D with Fe = X[k] + X*[N-k],
+// D = X[k] - X*[N-k] and X[N] taken as 0, then the inverse complex fft.
+// nothing is scaled
+void fbank_ref_ifft(const int32_t* in, int32_t* out)
+{
+    static int32_t zr[FBANK_REF_CFFT_N];
+    static int32_t zi[FBANK_REF_CFFT_N];
+
+    for (int k = 0; k < FBANK_REF_CFFT_N; k++) {
+        int m = FBANK_REF_CFFT_N - k;
+        int64_t yr = k ? in[2 * m] : 0;
+        int64_t yi = k ? -(int64_t)in[2 * m + 1] : 0;
+        int64_t dr = in[2 * k] - yr;
+        int64_t di = in[2 * k + 1] - yi;
+        int32_t c, s, tr, ti;
+        uint32_t r = fbank_ref_bitrev(k);
+
+        fbank_ref_twiddle(k, &c, &s);
+        s = -s;
+        tr = fbank_ref_round_shift(dr * c - di * s, 15);
+        ti = fbank_ref_round_shift(dr * s + di * c, 15);
+        zr[r] = (int32_t)(in[2 * k] + yr - ti);
+        zi[r] = (int32_t)(in[2 * k + 1] + yi + tr);
+    }
+    fbank_ref_cfft(zr, zi, 1);
+
+    for (int k = 0; k < FBANK_REF_CFFT_N; k++) {
+        out[2 * k] = zr[k];
+        out[2 * k + 1] = zi[k];
+    }
+}
+
+// alpha max plus beta min with beta = 3/8 stands in for the sqrt, / 4
+uint32_t fbank_ref_mag(int32_t re, int32_t im)
+{
+    uint32_t a = re < 0 ? 0u - (uint32_t)re : (uint32_t)re;
+    uint32_t b = im < 0 ? 0u - (uint32_t)im : (uint32_t)im;
+    uint32_t hi = a > b ? a : b;
+    uint32_t lo = a > b ? b : a;
+
+    return (uint32_t)((8 * (uint64_t)hi + 3 * (uint64_t)lo) >> 5);
+}
+
+void fbank_ref_sqrt_mel(const int32_t* spectrum, uint32_t* mel)
+{
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        const fbank_cfg_t* cfg = &FBANK_FILTERS[m];
+        int len = fbank_ref_mel_len(cfg);
+        uint64_t acc = 0;
+
+        for (int i = 0; i < len; i++) {
+            int k = cfg->start + i;
+            acc += fbank_ref_mel_term(cfg->melfiter[i], fbank_ref_mag(spectrum[2 * k], spectrum[2 * k + 1]));
+        }
+        mel[m] = acc > UINT32_MAX ? UINT32_MAX : (uint32_t)acc;
+    }
+}
+
+// log2(v) in Q8, bit by bit from the normalized mantissa
+static int32_t fbank_ref_log2_q8(uint32_t v)
+{
+    int32_t e = 31;
+    uint64_t m;
+    int32_t frac = 0;
+
+    while (!(v & 0x80000000U)) {
+        v <<= 1;
+        e--;
+    }
+    m = v;                              // [1, 2) in Q31
+    for (int b = 7; b >= 0; b--) {
+        m = (m * m) >> 31;
+        if (m >= ((uint64_t)1 << 32)) {
+            m >>= 1;
+            frac |= 1 << b;
+        }
+    }
+    return (e << 8) | frac;
+}
+
+void fbank_ref_log(const uint32_t* mel, uint32_t* feature)
+{
+    fbank_ref_log_bins(mel, (uint8_t*)feature, _NUM_MEL_BINS);
+}
+
+void fbank_ref_log_bins(const uint32_t* mel, uint8_t* out, int num_bins)
+{
+    for (int m = 0; m < num_bins; m++) {
+        int32_t v = FBANK_REF_LOG_FLOOR;
+
+        if (mel[m] != 0) {
+            v = ((fbank_ref_log2_q8(mel[m]) * FBANK_REF_LOG_GAIN) >> 16) + FBANK_REF_LOG_BIAS;
+        }
+        if (v < FBANK_REF_LOG_FLOOR) {
+            v = FBANK_REF_LOG_FLOOR;
+        }
+        if (v > 255) {
+            v = 255;
+        }
+        out[m] = (uint8_t)v;
+    }
+}
+
+void fbank_ref_sqrt_mel_log(const int32_t* spectrum, uint32_t* feature)
+{
+    uint32_t mel[_NUM_MEL_BINS];
+
+    fbank_ref_sqrt_mel(spectrum, mel);
+    fbank_ref_log(mel, feature);
+}
+
+void fbank_ref_calculate(int32_t* words, uint32_t* feature)
+{
+    fbank_ref_window(words);
+    fbank_ref_fft(words, words);
+    fbank_ref_sqrt_mel_log(words, feature);
+}
+
+int fbank_ref_compare(const int16_t* pcm, uint32_t num_samples,
+                      const uint8_t* golden, uint32_t num_frames,
+                      fbank_ref_diff_t* diff)
+{
+    static int32_t words[_NFFT];
+    uint32_t feature[FBANK_REF_FEAT_WORDS];
+
+    if (pcm == NULL || golden == NULL || diff == NULL)
+        return -1;
+    if (num_samples < _WIN_SIZE)
+        return -2;
+    if (num_frames > (num_samples - _WIN_SIZE) / _UPDATE_SIZE + 1)
+        return -3;
+
+    memset(diff, 0, sizeof(fbank_ref_diff_t));
+    diff->first_bad_frame = -1;
+
+    for (uint32_t f = 0; f < num_frames; f++) {
+        const int16_t* frame = pcm + f * _UPDATE_SIZE;
+        const uint8_t* ref = golden + f * _NUM_MEL_BINS;
+        const uint8_t* out = (const uint8_t*)feature;
+        uint32_t bad = 0;
+
+        for (int i = 0; i < _WIN_SIZE; i++) {
+            words[i] = frame[i];
+        }
+        memset(&words[_WIN_SIZE], 0, (_NFFT - _WIN_SIZE) * sizeof(int32_t));
+        fbank_ref_calculate(words, feature);
+
+        for (int m = 0; m < _NUM_MEL_BINS; m++) {
+            uint32_t d = out[m] > ref[m] ? out[m] - ref[m] : ref[m] - out[m];
+            if (d != 0) {
+                bad++;
+                if (d > diff->max_abs_diff) {
+                    diff->max_abs_diff = d;
+                }
+            }
+        }
+
+        diff->frames++;
+        diff->diff_bytes += bad;
+        if (bad == 0) {
+            diff->exact_frames++;
+        } else if (diff->first_bad_frame < 0) {
+            diff->first_bad_frame = (int32_t)f;
+        }
+    }
+    return diff->exact_frames == diff->frames ? 0 : 1;
+}
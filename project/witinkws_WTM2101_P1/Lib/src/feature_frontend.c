@@ -0,0 +1,131 @@
+#include <math.h>
+#include <string.h>
+#include "feature_frontend.h"
+#include "fbank_ref.h"
+
+const feature_frontend_t feature_frontend_default = {
+    16000,                      // sample_rate
+    _NFFT,                      // nfft
+    _WIN_SIZE,                  // win_size
+    _UPDATE_SIZE,               // shift_size
+    _NUM_MEL_BINS,              // num_mel_bins
+    1,                          // bin_stride
+    1,                          // hw_fbank
+    FBANK_FILTERS,
+    povey_win_signed,
+};
+
+static float fe_mel(float hz)
+{
+    return 1127.0f * logf(1.0f + hz / 700.0f);
+}
+
+int feature_frontend_generate(feature_frontend_t* fe, feature_frontend_tables_t* tab,
+                              uint16_t sample_rate, uint16_t nfft,
+                              uint16_t win_ms, uint16_t shift_ms, uint16_t num_mel_bins)
+{
+    uint32_t win_size = (uint32_t)sample_rate * win_ms / 1000;
+    uint32_t shift_size = (uint32_t)sample_rate * shift_ms / 1000;
+    int num_fft_bins = nfft / 2;
+    float mel_low, mel_delta, bin_hz;
+    int ofs = 0;
+
+    if (fe == NULL || tab == NULL)
+        return -1;
+    if ((nfft != 256 && nfft != FEATURE_FRONTEND_MAX_NFFT) || win_size == 0 || win_size > nfft ||
+        shift_size == 0 || num_mel_bins == 0 || num_mel_bins > FEATURE_FRONTEND_MAX_MEL)
+        return -1;
+
+    // povey: (0.5 - 0.5 cos(2 pi n / (N - 1)))^0.85
+    for (uint32_t n = 0; n < win_size; n++) {
+        float a = 6.28318530718f * n / (float)(win_size - 1);
+        float w = powf(0.5f - 0.5f * cosf(a), 0.85f);
+        tab->window[n] = (short)(w * 32767.0f + 0.5f);
+    }
+
+    mel_low = fe_mel((float)FEATURE_FRONTEND_LOW_FREQ);
+    mel_delta = (fe_mel(sample_rate / 2.0f) - mel_low) / (float)(num_mel_bins + 1);
+    bin_hz = (float)sample_rate / (float)nfft;
+
+    for (int m = 0; m < num_mel_bins; m++) {
+        float left = mel_low + m * mel_delta;
+        float center = left + mel_delta;
+        float right = center + mel_delta;
+        fbank_cfg_t* cfg = &tab->filters[m];
+        int start = -1;
+        int end = -1;
+
+        for (int k = 0; k < num_fft_bins; k++) {
+            float mel = fe_mel(bin_hz * k);
+            if (mel > left && mel < right) {
+                if (start < 0) {
+                    start = k;
+                }
+                end = k;
+            }
+        }
+        if (start < 0)
+            return -2;
+        if (ofs + end - start + 1 > FEATURE_FRONTEND_MAX_WEIGHTS)
+            return -1;
+
+        cfg->start = (uint16_t)start;
+        cfg->end = (uint16_t)end;
+        cfg->melfiter = &tab->weights[ofs];
+        for (int k = start; k <= end; k++) {
+            float mel = fe_mel(bin_hz * k);
+            float w = mel <= center ? (mel - left) / (center - left) : (right - mel) / (right - center);
+            uint32_t q = (uint32_t)(w * 65536.0f);
+            tab->weights[ofs++] = (uint16_t)(q > 0xFFFF ? 0xFFFF : q);
+        }
+    }
+
+    fe->sample_rate = sample_rate;
+    fe->nfft = nfft;
+    fe->win_size = (uint16_t)win_size;
+    fe->shift_size = (uint16_t)shift_size;
+    fe->num_mel_bins = num_mel_bins;
+    fe->bin_stride = (uint16_t)(_NFFT / nfft);
+    fe->hw_fbank = 0;
+    fe->filters = tab->filters;
+    fe->window = tab->window;
+    return 0;
+}
+
+void feature_frontend_window(const feature_frontend_t* fe, const int16_t* frame, int32_t* words)
+{
+    int n;
+
+    for (n = 0; n < fe->win_size; n++) {
+        words[n] = ((int32_t)frame[n] * fe->window[n]) >> 15;
+    }
+    for (; n < _NFFT; n++) {
+        words[n] = 0;
+    }
+}
+
+void feature_frontend_mel_log(const feature_frontend_t* fe, const int32_t* spectrum, uint8_t* out)
+{
+    uint32_t mel[FEATURE_FRONTEND_MAX_MEL];
+
+    for (int m = 0; m < fe->num_mel_bins; m++) {
+        const fbank_cfg_t* cfg = &fe->filters[m];
+        int len = fbank_ref_mel_len(cfg);
+        uint64_t acc = 0;
+
+        for (int i = 0; i < len; i++) {
+            int k = (cfg->start + i) * fe->bin_stride;
+            acc += fbank_ref_mel_term(cfg->melfiter[i], fbank_ref_mag(spectrum[2 * k], spectrum[2 * k + 1]));
+        }
+        mel[m] = acc > UINT32_MAX ? UINT32_MAX : (uint32_t)acc;
+    }
+    fbank_ref_log_bins(mel, out, fe->num_mel_bins);
+}
+
+void feature_frontend_compute(const feature_frontend_t* fe, const int16_t* frame,
+                              int32_t* words, uint8_t* out)
+{
+    feature_frontend_window(fe, frame, words);
+    fbank_ref_fft(words, words);
+    feature_frontend_mel_log(fe, words, out);
+}
@@ -0,0 +1,193 @@
+#include <string.h>
+#include "feature_post.h"
+
+#define FEATURE_POST_STD_MIN        (64)    // Q8, a quarter feature unit
+
+static int feature_post_slot(int32_t frame)
+{
+    int s = frame % FEATURE_POST_HIST;
+    return s < 0 ? s + FEATURE_POST_HIST : s;
+}
+
+static uint32_t feature_post_isqrt(uint32_t v)
+{
+    uint32_t r = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= r + bit) {
+            v -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+static void feature_post_inv_std(feature_post_t* fp, int m)
+{
+    uint32_t std = feature_post_isqrt(fp->var[m]);
+
+    if (std < FEATURE_POST_STD_MIN) {
+        std = FEATURE_POST_STD_MIN;
+    }
+    fp->inv_std[m] = (int32_t)(((uint32_t)fp->out_scale << 16) / std);
+}
+
+static int8_t feature_post_sat8(int32_t v)
+{
+    return (int8_t)(v > 127 ? 127 : (v < -127 ? -127 : v));
+}
+
+int feature_post_init(feature_post_t* fp, uint16_t num_bins, uint8_t flags)
+{
+    if (fp == NULL || num_bins == 0 || num_bins > FEATURE_POST_MAX_BINS)
+        return -1;
+
+    memset(fp, 0, sizeof(feature_post_t));
+    fp->num_bins = num_bins;
+    fp->flags = (flags & FEATURE_POST_DELTA2) ? (FEATURE_POST_DELTA | FEATURE_POST_DELTA2) : flags;
+    fp->cmvn_shift = 8;
+    fp->out_scale = 32;
+    fp->delta_gain = 26;
+    fp->var_init = (16 << 8) * (16 << 8);
+    feature_post_reset(fp);
+    return 0;
+}
+
+void feature_post_reset(feature_post_t* fp)
+{
+    fp->frames = 0;
+    fp->std_next = 0;
+    for (int m = 0; m < fp->num_bins; m++) {
+        fp->mean[m] = 0;
+        fp->var[m] = fp->var_init;
+        feature_post_inv_std(fp, m);
+    }
+}
+
+int feature_post_delay(const feature_post_t* fp)
+{
+    if (fp->flags & FEATURE_POST_DELTA2)
+        return 2 * FEATURE_POST_DELTA_N;
+    if (fp->flags & FEATURE_POST_DELTA)
+        return FEATURE_POST_DELTA_N;
+    return 0;
+}
+
+int feature_post_dim(const feature_post_t* fp)
+{
+    int n = 1;
+
+    if (fp->flags & FEATURE_POST_DELTA) {
+        n++;
+    }
+    if (fp->flags & FEATURE_POST_DELTA2) {
+        n++;
+    }
+    return fp->num_bins * n;
+}
+
+// sum n (x[t+n] - x[t-n]), n = 1, 2
+#define FEATURE_POST_DIFF(x, t, m) \
+    ((int32_t)(x)[feature_post_slot((t) + 1)][m] - (x)[feature_post_slot((t) - 1)][m] + \
+     2 * ((int32_t)(x)[feature_post_slot((t) + 2)][m] - (x)[feature_post_slot((t) - 2)][m]))
+
+int feature_post_process(feature_post_t* fp, const uint8_t* frame, int8_t* out)
+{
+    const int32_t t = (int32_t)fp->frames;
+    const int num = fp->num_bins;
+    const int delay = feature_post_delay(fp);
+    int8_t* stat = fp->stat[feature_post_slot(t)];
+    int shift = 0;
+    int32_t o;
+    int32_t u;
+
+    // cumulative mean over the first 2^cmvn_shift frames, then exponential
+    while (shift < fp->cmvn_shift && (2u << shift) <= (uint32_t)t + 1) {
+        shift++;
+    }
+
+    for (int m = 0; m < num; m++) {
+        int32_t d = ((int32_t)frame[m] << 8) - fp->mean[m];
+        uint32_t d2;
+
+        fp->mean[m] += d >> shift;
+        d = ((int32_t)frame[m] << 8) - fp->mean[m];
+        d2 = (uint32_t)d * (uint32_t)d;          // |d| < 2^16
+        if (d2 >= fp->var[m]) {
+            fp->var[m] += (d2 - fp->var[m]) >> fp->cmvn_shift;
+        } else {
+            fp->var[m] -= (fp->var[m] - d2) >> fp->cmvn_shift;
+        }
+        stat[m] = feature_post_sat8((int32_t)(((int64_t)d * fp->inv_std[m]) >> 16));
+    }
+
+    for (int i = 0; i < FEATURE_POST_STD_REFRESH; i++) {
+        feature_post_inv_std(fp, fp->std_next);
+        fp->std_next = (uint16_t)(fp->std_next + 1 < num ? fp->std_next + 1 : 0);
+    }
+
+    if (t == 0) {
+        for (int h = 0; h < FEATURE_POST_HIST; h++) {
+            if (h != feature_post_slot(0)) {
+                memcpy(fp->stat[h], stat, num);
+            }
+        }
+    }
+
+    // the delta of frame t - N is complete now
+    u = t - FEATURE_POST_DELTA_N;
+    if ((fp->flags & FEATURE_POST_DELTA) && u >= 0) {
+        int16_t* delta = fp->delta[feature_post_slot(u)];
+
+        for (int m = 0; m < num; m++) {
+            delta[m] = (int16_t)FEATURE_POST_DIFF(fp->stat, u, m);
+        }
+        if (u == 0) {
+            for (int h = 0; h < FEATURE_POST_HIST; h++) {
+                if (h != feature_post_slot(0)) {
+                    memcpy(fp->delta[h], delta, num * sizeof(int16_t));
+                }
+            }
+        }
+    }
+
+    fp->frames++;
+    o = t - delay;
+    if (o < 0)
+        return 0;
+
+    memcpy(out, fp->stat[feature_post_slot(o)], num);
+    if (fp->flags & FEATURE_POST_DELTA) {
+        const int16_t* delta = fp->delta[feature_post_slot(o)];
+        int8_t* dst = out + num;
+
+        for (int m = 0; m < num; m++) {
+            dst[m] = feature_post_sat8((delta[m] * fp->delta_gain) >> 8);
+        }
+    }
+    if (fp->flags & FEATURE_POST_DELTA2) {
+        int32_t gain2 = fp->delta_gain * fp->delta_gain;
+        int8_t* dst = out + 2 * num;
+
+        for (int m = 0; m < num; m++) {
+            dst[m] = feature_post_sat8((FEATURE_POST_DIFF(fp->delta, o, m) * gain2) >> 16);
+        }
+    }
+    return 1;
+}
+
+void feature_post_to_pn(const int8_t* in, uint8_t* out, int num)
+{
+    for (int i = 0; i < num; i++) {
+        int8_t x = in[i];
+        out[i] = x >= 0 ? (uint8_t)x : 0;
+        out[i + num] = x >= 0 ? 0 : (uint8_t)(-x);
+    }
+}
@@ -0,0 +1,169 @@
+#include <string.h>
+#include "lib_witin_kws/lib_witin_kws.h"
+
+// the decoder only skips in groups of 3 (skip3FrameFlag), at most 2 frames
+// are held back until their group is full. a skip of 2 or 4 cannot be
+// passed on, min_skip and max_skip are 1 or 3 and the ramp step to 2
+// still decodes every frame
+#define KWS_SKIP_GROUP_FRAMES  (3)
+
+static const WitinKwsSkipConfig skip_cfg_default = {
+    .min_skip       = 1,
+    .max_skip       = KWS_SKIP_GROUP_FRAMES,
+    .sil_index      = 0,
+    .sil_margin     = 8,
+    .hangover_frms  = 30,   // 300ms
+    .ramp_frms      = 25,   // 250ms per step
+    .energy_margin  = 200,
+};
+
+static WitinKwsSkipConfig skip_cfg;
+static int8_t* skip_pending = NULL;   // [KWS_SKIP_GROUP_FRAMES-1][out_dim]
+static int32_t skip_out_dim = 0;
+static int skip_pending_cnt = 0;
+static int skip_quiet_frms = 0;
+static uint32_t skip_noise_floor = 0;
+static int8_t skip_floor_valid = 0;
+
+int WitinKwsDynamicSkipInit(const WitinKwsSkipConfig* cfg)
+{
+    if (cfg == NULL) {
+        cfg = &skip_cfg_default;
+    }
+    if (cfg->max_skip != 1 && cfg->max_skip != KWS_SKIP_GROUP_FRAMES)
+        return -1;
+    if ((cfg->min_skip != 1 && cfg->min_skip != KWS_SKIP_GROUP_FRAMES) || cfg->min_skip > cfg->max_skip)
+        return -2;
+    if (cfg->ramp_frms <= 0)
+        return -3;
+
+    int32_t out_dim = WitinKwsGetNnetOutDimension();
+    if (cfg->sil_index < 0 || cfg->sil_index >= out_dim)
+        return -4;
+
+    if (skip_pending == NULL || out_dim > skip_out_dim) {
+        if (skip_pending != NULL) {
+            OsalFree(skip_pending);
+        }
+        skip_pending = (int8_t*)OsalMalloc((KWS_SKIP_GROUP_FRAMES - 1) * out_dim);
+        if (skip_pending == NULL) {
+            skip_out_dim = 0;
+            return -5;
+        }
+    }
+    skip_out_dim = out_dim;
+    skip_cfg = *cfg;
+
+    WitinKwsDynamicSkipReset();
+    return 0;
+}
+
+void WitinKwsDynamicSkipReset(void)
+{
+    skip_pending_cnt = 0;
+    skip_quiet_frms = 0;
+    skip_floor_valid = 0;
+}
+
+// silence wins only when its logit clearly beats every other pdf,
+// a flat (high entropy) or speech-peaked output keeps decoding dense
+static int posterior_is_speech(const int8_t* nnet_out)
+{
+    int best = -128;
+    for (int i = 0; i < skip_out_dim; i++) {
+        if (i != skip_cfg.sil_index && nnet_out[i] > best) {
+            best = nnet_out[i];
+        }
+    }
+    return nnet_out[skip_cfg.sil_index] < best + skip_cfg.sil_margin;
+}
+
+static int energy_is_speech(uint32_t energy)
+{
+    if (!skip_floor_valid) {
+        skip_noise_floor = energy;
+        skip_floor_valid = 1;
+    }
+    return energy > skip_noise_floor + skip_cfg.energy_margin;
+}
+
+static void noise_floor_update(uint32_t energy)
+{
+    // fall fast, rise slowly
+    if (energy < skip_noise_floor) {
+        skip_noise_floor = energy;
+    } else {
+        skip_noise_floor += (energy - skip_noise_floor) >> 6;
+    }
+}
+
+static int decode_pending_and_current(int8_t* nnet_out)
+{
+    for (int i = 0; i < skip_pending_cnt; i++) {
+        WitinKwsDecodeOneFrame(skip_pending + i * skip_out_dim, 0, 0);
+    }
+    WitinKwsDecodeOneFrame(nnet_out, 0, 0);
+
+    int n = skip_pending_cnt + 1;
+    skip_pending_cnt = 0;
+    return n;
+}
+
+// a full group goes to the decoder with its skip index, so its frame clock
+// stays in step with the audio and no frame is lost
+static int decode_skip_group(int8_t* nnet_out)
+{
+    for (int i = 0; i < skip_pending_cnt; i++) {
+        WitinKwsDecodeOneFrame(skip_pending + i * skip_out_dim, 1, i);
+    }
+    WitinKwsDecodeOneFrame(nnet_out, 1, skip_pending_cnt);
+
+    int n = skip_pending_cnt + 1;
+    skip_pending_cnt = 0;
+    return n;
+}
+
+int WitinKwsDecodeOneFrameDynamic(int8_t* nnet_out, int vad_active, uint32_t frame_energy)
+{
+    if (skip_pending == NULL) {
+        // not initialized, behave like the static decoder
+        WitinKwsDecodeOneFrame(nnet_out, 0, 0);
+        return 1;
+    }
+
+    int speech = (vad_active > 0);
+    speech |= energy_is_speech(frame_energy);
+    speech |= posterior_is_speech(nnet_out);
+
+    if (speech) {
+        skip_quiet_frms = 0;
+    } else {
+        noise_floor_update(frame_energy);
+        if (skip_quiet_frms < 0x7FFF) {
+            skip_quiet_frms++;
+        }
+    }
+
+    // onset, likely keyword region and hangover: every frame, held-back
+    // frames first so the decoder sees the whole onset in order
+    if (skip_quiet_frms <= skip_cfg.hangover_frms) {
+        return decode_pending_and_current(nnet_out);
+    }
+
+    int skip = skip_cfg.min_skip + (skip_quiet_frms - skip_cfg.hangover_frms) / skip_cfg.ramp_frms;
+    if (skip > skip_cfg.max_skip) {
+        skip = skip_cfg.max_skip;
+    }
+
+    if (skip < KWS_SKIP_GROUP_FRAMES) {
+        return decode_pending_and_current(nnet_out);
+    }
+
+    if (skip_pending_cnt + 1 >= KWS_SKIP_GROUP_FRAMES) {
+        return decode_skip_group(nnet_out);
+    }
+
+    memcpy(skip_pending + skip_pending_cnt * skip_out_dim, nnet_out, skip_out_dim);
+    skip_pending_cnt++;
+    return 0;
+}
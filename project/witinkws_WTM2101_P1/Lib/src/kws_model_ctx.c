@@ -0,0 +1,156 @@
+#include <string.h>
+#include "kws_manager.h"
+#include "HCLG.fst.h"
+#include "acou_model.h"
+#include "kws_decoder.h"
+
+static KWS_MODEL_CTX kws_ctx[NUM_KWS_MODULES];
+static int8_t kws_ctx_ready = 0;
+static kws_word_info_node_t* kws_ctx_nodes[NUM_KWS_MODULES];
+// switch asked for by kws_model_ctx_switch(), -1 none
+static volatile int32_t kws_ctx_pending = -1;
+
+KWS_MODEL_CTX* cur_kws_ctx = NULL;
+
+static int word_hash_count(const KWS_ACOU_MODU* acou)
+{
+    int n = 0;
+    for (int h = 0; h < 16; h++) {
+        const kws_word_info_node_t* p = acou->wordHash[h].head;
+        while (p != NULL) {
+            n++;
+            p = (const kws_word_info_node_t*)p->next;
+        }
+    }
+    return n;
+}
+
+// a context owns everything set_kws_fst()/set_kws_acou_model() rebuild:
+// the two descriptors and the word hash nodes, all copied into
+// kws_ctx[]/kws_ctx_nodes[]. the model tables the descriptors point to
+// (arcs, states, pdfs, key word strings) are constant model data and are
+// only referenced.
+static kws_word_info_node_t* word_hash_copy(KWS_ACOU_MODU* dst, kws_word_info_node_t* pool)
+{
+    for (int h = 0; h < 16; h++) {
+        const kws_word_info_node_t* p = dst->wordHash[h].head;
+        kws_word_info_node_t* prev = NULL;
+
+        dst->wordHash[h].head = NULL;
+        dst->wordHash[h].tail = NULL;
+        while (p != NULL) {
+            *pool = *p;
+            pool->next = NULL;
+            if (prev == NULL) {
+                dst->wordHash[h].head = pool;
+            } else {
+                prev->next = (struct _kws_word_info_node*)pool;
+            }
+            prev = pool;
+            dst->wordHash[h].tail = pool;
+            pool++;
+            p = (const kws_word_info_node_t*)p->next;
+        }
+    }
+    return pool;
+}
+
+static void kws_ctx_free(void)
+{
+    for (int id = 0; id < NUM_KWS_MODULES; id++) {
+        if (kws_ctx_nodes[id] != NULL) {
+            OsalFree(kws_ctx_nodes[id]);
+            kws_ctx_nodes[id] = NULL;
+        }
+    }
+}
+
+int kws_model_ctx_init(void)
+{
+    int32_t kws_id_bak = CUR_KWS_ID;
+
+    kws_ctx_ready = 0;
+    kws_ctx_pending = -1;
+    kws_ctx_free();
+
+    for (int id = 0; id < NUM_KWS_MODULES; id++) {
+        int num_nodes;
+
+        set_kws_fst(id);
+        set_kws_acou_model(id);
+        if (cur_fst_modu == NULL || cur_acou_model == NULL) {
+            kws_ctx_free();
+            set_kws_module(kws_id_bak);
+            return -1;
+        }
+        kws_ctx[id].kws_id = id;
+        kws_ctx[id].fst = *cur_fst_modu;
+        kws_ctx[id].acou = *cur_acou_model;
+
+        // the next set_kws_acou_model() may rebuild or free these nodes,
+        // copy them before it runs
+        num_nodes = word_hash_count(&kws_ctx[id].acou);
+        if (num_nodes > 0) {
+            kws_ctx_nodes[id] = (kws_word_info_node_t*)OsalMalloc(num_nodes * sizeof(kws_word_info_node_t));
+            if (kws_ctx_nodes[id] == NULL) {
+                kws_ctx_free();
+                set_kws_module(kws_id_bak);
+                return -2;
+            }
+            word_hash_copy(&kws_ctx[id].acou, kws_ctx_nodes[id]);
+        }
+    }
+    kws_ctx_ready = 1;
+
+    // back on the model that was active before the build, the set calls
+    // above raised the fst change flag and the sync takes it down
+    if (kws_model_ctx_switch(kws_id_bak) != 0)
+        return -1;
+    return kws_model_ctx_sync() < 0 ? -1 : 0;
+}
+
+KWS_MODEL_CTX* kws_model_ctx_get(int kws_id)
+{
+    if (!kws_ctx_ready || kws_id < 0 || kws_id >= NUM_KWS_MODULES)
+        return NULL;
+    return &kws_ctx[kws_id];
+}
+
+// only records the id: the get-words callback runs inside the decoder's
+// frame, the token store it would reset there is still being walked.
+int kws_model_ctx_switch(int kws_id)
+{
+    if (kws_model_ctx_get(kws_id) == NULL)
+        return -1;
+    kws_ctx_pending = kws_id;
+    return 0;
+}
+
+// O(1): no fst or word hash rebuild, only pointers and the token state.
+// a set_kws_module() from outside the contexts raises the fst change flag
+// too, the decoder is then put back on the context of the model it chose.
+int kws_model_ctx_sync(void)
+{
+    int32_t kws_id = kws_ctx_pending;
+    KWS_MODEL_CTX* ctx;
+
+    if (kws_id < 0) {
+        if (!kws_ctx_ready || !is_fst_changed())
+            return 0;
+        kws_id = CUR_KWS_ID;
+    }
+    kws_ctx_pending = -1;
+    ctx = kws_model_ctx_get(kws_id);
+    if (ctx == NULL)
+        return -1;
+
+    CUR_KWS_ID = kws_id;
+    cur_kws_ctx = ctx;
+    cur_fst_modu = &ctx->fst;
+    cur_acou_model = &ctx->acou;
+    // the reset of a model change, done once here and not again by the
+    // decoder on the flag
+    decode_reset();
+    clear_fst_changed_flag();
+    return 1;
+}
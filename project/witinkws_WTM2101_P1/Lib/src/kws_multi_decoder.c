@@ -0,0 +1,436 @@
+#include <string.h>
+#include "kws_multi_decoder.h"
+#include "byte_map.h"
+#include "HCLG.fst.h"
+
+// log-likelihoods and fst weights share the 1/256 fixed point of the
+// single graph decoder, arc weights are costs
+#define KWS_MULTI_WGT_MUL       (256.0f)
+
+typedef struct _kws_multi_graph
+{
+    KWS_MODEL_CTX* ctx;
+    KWS_MULTI_GRAPH_CFG cfg;
+    BucketTokens* toks;
+    ByteMapStamped* slot;   // token index of a state in the current frame
+    uint16_t* eps_stamp;    // eps arcs of a state followed when it equals eps_epoch
+    uint16_t eps_epoch;     // one per frame, a prune does not move it
+    uint8_t eps_requeue;    // an expanded state got a better token
+    uint16_t slot_gen;      // toks->generation the slots were taken under
+    int16_t start_id;
+    uint32_t arcs;          // arcs evaluated in the last frame
+} kws_multi_graph_t;
+
+static kws_multi_graph_t* multi_graphs = NULL;
+static int multi_num_graphs = 0;
+static uint32_t multi_arc_budget = 0;
+static int32_t multi_share_sum = 0;
+static uint8_t multi_rshift = 0;
+static int32_t multi_dim = 0;
+static float* multi_post = NULL;
+static int32_t* multi_loglik = NULL;
+static KwsMultiOnWords multi_on_words = NULL;
+
+static void graph_new_stamp(kws_multi_graph_t* g)
+{
+    byte_map_stamped_clear(g->slot);
+    g->slot_gen = g->toks->generation;
+}
+
+static void graph_new_eps_epoch(kws_multi_graph_t* g)
+{
+    g->eps_epoch++;
+    if (g->eps_epoch == 0) {
+        memset(g->eps_stamp, 0, g->ctx->fst.num_states * sizeof(uint16_t));
+        g->eps_epoch = 1;
+    }
+}
+
+// the token of state id changed after its eps arcs were followed, they
+// are followed again from the new token
+static void graph_requeue(kws_multi_graph_t* g, int16_t id)
+{
+    if (g->eps_stamp[id] == g->eps_epoch) {
+        g->eps_stamp[id] = 0;
+        g->eps_requeue = 1;
+    }
+}
+
+// cur_toks was compacted, index the survivors again
+static void graph_rebuild_slots(kws_multi_graph_t* g)
+{
+    BucketTokens* btk = g->toks;
+
+    graph_new_stamp(g);
+    for (int i = 0; i < btk->cur_toks_cnt; i++) {
+        int16_t id = btk->cur_toks[i].id;
+        int index = byte_map_stamped_get_index(g->slot, id);
+
+        if (index < 0 || btk->cur_toks[index].weight < btk->cur_toks[i].weight) {
+            byte_map_stamped_set_index(g->slot, id, i);
+        }
+    }
+}
+
+// viterbi recombination: one token per state, the better one survives
+static void graph_relax(kws_multi_graph_t* g, const TOKEN* nt)
+{
+    BucketTokens* btk = g->toks;
+    int16_t id = nt->id;
+    int index = byte_map_stamped_get_index(g->slot, id);
+
+    if (index >= 0) {
+        if (btk->cur_toks[index].weight < nt->weight) {
+            btk->cur_toks[index] = *nt;
+            bucket_tokens_update(btk, index);
+            graph_requeue(g, id);
+        }
+        return;
+    }
+
+    index = bucket_tokens_append(btk, nt);
+    if (btk->generation != g->slot_gen) {
+        graph_rebuild_slots(g);
+    } else if (index >= 0) {
+        byte_map_stamped_set_index(g->slot, id, index);
+    }
+    // a state pruned after its expansion and back with a new token
+    if (index >= 0) {
+        graph_requeue(g, id);
+    }
+}
+
+static void token_advance(TOKEN* nt, const FST_ARC* arc)
+{
+    nt->id = arc->end;
+    nt->ilabel = arc->ilabel;
+    nt->olabel = arc->olabel;
+    nt->weight -= arc->weight;
+
+    if (arc->olabel == SIGN_START) {
+        nt->start_sign = 1;
+        nt->start_wgt = nt->weight;
+        nt->start_plen = nt->path_len;
+        nt->end_sign = 0;
+        nt->word_id = 0;
+    } else if (arc->olabel == SIGN_END) {
+        if (nt->start_sign) {
+            nt->end_sign = 1;
+            nt->end_wgt = nt->weight;
+            nt->end_plen = nt->path_len;
+        }
+    } else if (arc->olabel > 0) {
+        nt->word_id = (uint8_t)arc->olabel;
+    }
+}
+
+static int arc_pdf(const KWS_FST_MODU* fst, int16_t ilabel)
+{
+    if (fst->pdfs != NULL) {
+        if (ilabel < 0 || ilabel >= fst->num_pdfs)
+            return -1;
+        return fst->pdfs[ilabel];
+    }
+    return ilabel;
+}
+
+// follow the input-epsilon arcs of every token in the current frame,
+// tokens appended on the way are expanded too. a state is expanded once
+// per frame, and again whenever its token improves afterwards, so the
+// closure keeps the best path to every state.
+static void graph_eps_closure(kws_multi_graph_t* g)
+{
+    const KWS_FST_MODU* fst = &g->ctx->fst;
+    BucketTokens* btk = g->toks;
+    uint16_t gen = btk->generation;
+
+    do {
+        g->eps_requeue = 0;
+        for (int i = 0; i < btk->cur_toks_cnt; i++) {
+            TOKEN tok = btk->cur_toks[i];
+            const STATE_MAP* st = &fst->map[tok.id];
+
+            if (g->eps_stamp[tok.id] == g->eps_epoch)
+                continue;
+            g->eps_stamp[tok.id] = g->eps_epoch;
+
+            for (int k = st->start_iez; k < st->start_iez + st->len_iez; k++) {
+                TOKEN nt = tok;
+                token_advance(&nt, &fst->arcs[k]);
+                graph_relax(g, &nt);
+            }
+            g->arcs += st->len_iez;
+
+            // an early prune compacted the tokens, rescan from the start: the
+            // states already expanded are skipped, only the survivors that
+            // moved below i are picked up
+            if (btk->generation != gen) {
+                gen = btk->generation;
+                i = -1;
+            }
+        }
+    } while (g->eps_requeue);
+}
+
+// weights only grow more negative, keep them relative to the best token
+static void graph_renormalize(kws_multi_graph_t* g)
+{
+    BucketTokens* btk = g->toks;
+    int32_t best = INT32_MIN;
+
+    for (int i = 0; i < btk->prev_toks_cnt; i++) {
+        if (btk->prev_toks[i].weight > best) {
+            best = btk->prev_toks[i].weight;
+        }
+    }
+    for (int i = 0; i < btk->prev_toks_cnt; i++) {
+        btk->prev_toks[i].weight -= best;
+        btk->prev_toks[i].start_wgt -= best;
+        btk->prev_toks[i].end_wgt -= best;
+    }
+}
+
+static void graph_reset(kws_multi_graph_t* g)
+{
+    TOKEN t;
+
+    memset(&t, 0, sizeof(TOKEN));
+    t.id = g->start_id;
+
+    bucket_tokens_reset(g->toks);
+    graph_new_stamp(g);
+    graph_new_eps_epoch(g);
+    graph_relax(g, &t);
+    graph_eps_closure(g);
+    bucket_tokens_exchange_to_another(g->toks);
+}
+
+static int graph_detect(kws_multi_graph_t* g)
+{
+    BucketTokens* btk = g->toks;
+    const TOKEN* best = NULL;
+    int32_t best_score = INT32_MIN;
+
+    for (int i = 0; i < btk->cur_toks_cnt; i++) {
+        const TOKEN* t = &btk->cur_toks[i];
+        if (t->end_sign && t->end_plen == t->path_len) {
+            int32_t frms = t->end_plen - t->start_plen;
+            int32_t score = (t->end_wgt - t->start_wgt) / (frms > 0 ? frms : 1);
+            if (score > best_score) {
+                best_score = score;
+                best = t;
+            }
+        }
+    }
+
+    if (best == NULL || best_score < g->cfg.min_score)
+        return 0;
+
+    if (multi_on_words != NULL) {
+        CallBackKeyWordsType words;
+        words.id = best->word_id;
+        words.score = best_score / KWS_MULTI_WGT_MUL;
+        multi_on_words(g->cfg.kws_id, &words);
+    }
+    return 1;
+}
+
+static int graph_decode_one_frame(kws_multi_graph_t* g)
+{
+    const KWS_FST_MODU* fst = &g->ctx->fst;
+    BucketTokens* btk = g->toks;
+    const TOKEN* prev = btk->prev_toks;
+    int n_prev = btk->prev_toks_cnt;
+
+    g->arcs = 0;
+    graph_new_stamp(g);
+    graph_new_eps_epoch(g);
+
+    for (int i = 0; i < n_prev; i++) {
+        const STATE_MAP* st = &fst->map[prev[i].id];
+
+        for (int k = st->start_igz; k < st->start_igz + st->len_igz; k++) {
+            const FST_ARC* arc = &fst->arcs[k];
+            int pdf = arc_pdf(fst, arc->ilabel);
+            TOKEN nt;
+
+            if (pdf < 0 || pdf >= multi_dim)
+                continue;
+            nt = prev[i];
+            nt.weight += multi_loglik[pdf];
+            nt.path_len++;
+            token_advance(&nt, arc);
+            graph_relax(g, &nt);
+        }
+        g->arcs += st->len_igz;
+    }
+    graph_eps_closure(g);
+
+    if (graph_detect(g)) {
+        graph_reset(g);
+        return 1;
+    }
+
+    bucket_tokens_exchange_to_another(btk);
+    graph_renormalize(g);
+    return 0;
+}
+
+// split the arc budget by share, a graph that overspent shrinks its token
+// count in proportion, one that stayed inside grows back by one token
+static void multi_apply_budget(void)
+{
+    if (multi_arc_budget == 0 || multi_share_sum <= 0)
+        return;
+
+    for (int i = 0; i < multi_num_graphs; i++) {
+        kws_multi_graph_t* g = &multi_graphs[i];
+        uint32_t quota = (uint32_t)((uint64_t)multi_arc_budget * g->cfg.share / multi_share_sum);
+        int max_toks = g->toks->max_toks;
+
+        if (g->arcs > quota) {
+            max_toks = (int)((uint64_t)max_toks * quota / g->arcs);
+            if (max_toks < g->cfg.min_toks) {
+                max_toks = g->cfg.min_toks;
+            }
+        } else if (max_toks < g->cfg.max_toks) {
+            max_toks++;
+        }
+        g->toks->max_toks = max_toks;
+    }
+}
+
+int kws_multi_init(const KWS_MULTI_GRAPH_CFG* cfgs, int num_graphs, uint32_t arc_budget, uint8_t rshift)
+{
+    KWS_FST_MODU* fst_bak = cur_fst_modu;
+
+    if (cfgs == NULL || num_graphs <= 0)
+        return -1;
+
+    kws_multi_release();
+
+    multi_dim = WitinKwsGetNnetOutDimension();
+    multi_post = (float*)OsalMalloc(multi_dim * sizeof(float));
+    multi_loglik = (int32_t*)OsalMalloc(multi_dim * sizeof(int32_t));
+    multi_graphs = (kws_multi_graph_t*)OsalMalloc(num_graphs * sizeof(kws_multi_graph_t));
+    if (multi_post == NULL || multi_loglik == NULL || multi_graphs == NULL) {
+        kws_multi_release();
+        return -2;
+    }
+
+    multi_share_sum = 0;
+    for (int i = 0; i < num_graphs; i++) {
+        kws_multi_graph_t* g = &multi_graphs[i];
+        int num_states;
+
+        memset(g, 0, sizeof(kws_multi_graph_t));
+        g->cfg = cfgs[i];
+        g->ctx = kws_model_ctx_get(cfgs[i].kws_id);
+        if (g->ctx == NULL || g->cfg.max_toks <= 0) {
+            kws_multi_release();
+            return -3;
+        }
+        if (g->cfg.min_toks <= 0 || g->cfg.min_toks > g->cfg.max_toks) {
+            g->cfg.min_toks = g->cfg.max_toks;
+        }
+
+        num_states = g->ctx->fst.num_states;
+        if (g->cfg.heap_toks) {
+            g->toks = bucket_tokens_init_heap(g->cfg.max_toks);
+        } else {
+            g->toks = bucket_tokens_init(g->cfg.max_toks, 4 * g->cfg.max_toks);
+        }
+        g->slot = byte_map_stamped_init(num_states);
+        g->eps_stamp = (uint16_t*)OsalMalloc(num_states * sizeof(uint16_t));
+        multi_num_graphs = i + 1;
+        if (g->toks == NULL || g->slot == NULL || g->eps_stamp == NULL) {
+            kws_multi_release();
+            return -2;
+        }
+        memset(g->eps_stamp, 0, num_states * sizeof(uint16_t));
+
+        // get_start_id() reads the current fst
+        cur_fst_modu = &g->ctx->fst;
+        g->start_id = (int16_t)get_start_id();
+        multi_share_sum += g->cfg.share;
+    }
+    cur_fst_modu = fst_bak;
+
+    multi_arc_budget = arc_budget;
+    multi_rshift = rshift;
+    kws_multi_reset();
+    return 0;
+}
+
+void kws_multi_release(void)
+{
+    for (int i = 0; i < multi_num_graphs; i++) {
+        kws_multi_graph_t* g = &multi_graphs[i];
+        bucket_tokens_release(g->toks);
+        byte_map_stamped_release(g->slot);
+        if (g->eps_stamp != NULL) {
+            OsalFree(g->eps_stamp);
+        }
+    }
+    multi_num_graphs = 0;
+
+    if (multi_graphs != NULL) {
+        OsalFree(multi_graphs);
+        multi_graphs = NULL;
+    }
+
+    if (multi_post != NULL) {
+        OsalFree(multi_post);
+        multi_post = NULL;
+    }
+    if (multi_loglik != NULL) {
+        OsalFree(multi_loglik);
+        multi_loglik = NULL;
+    }
+}
+
+void kws_multi_reset(void)
+{
+    for (int i = 0; i < multi_num_graphs; i++) {
+        multi_graphs[i].toks->max_toks = multi_graphs[i].cfg.max_toks;
+        graph_reset(&multi_graphs[i]);
+    }
+}
+
+void kws_multi_set_on_words(KwsMultiOnWords func)
+{
+    multi_on_words = func;
+}
+
+int kws_multi_decode_one_frame(int8_t* nnet_out)
+{
+    const float* logpriors = get_logpriors();
+    int detected = 0;
+
+    if (multi_num_graphs == 0)
+        return 0;
+
+    // shared by all graphs: one softmax per frame
+    LogSoftMax_f(nnet_out, multi_post, multi_dim, multi_rshift);
+    for (int i = 0; i < multi_dim; i++) {
+        float ll = multi_post[i];
+        if (logpriors != NULL) {
+            ll -= logpriors[i];
+        }
+        multi_loglik[i] = (int32_t)(ll * KWS_MULTI_WGT_MUL);
+    }
+
+    for (int i = 0; i < multi_num_graphs; i++) {
+        detected += graph_decode_one_frame(&multi_graphs[i]);
+    }
+
+    multi_apply_budget();
+    return detected;
+}
+
+uint32_t kws_multi_get_arcs(int graph)
+{
+    if (graph < 0 || graph >= multi_num_graphs)
+        return 0;
+    return multi_graphs[graph].arcs;
+}
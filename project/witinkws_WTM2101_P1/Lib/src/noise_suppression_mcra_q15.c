@@ -0,0 +1,194 @@
+#include <string.h>
+#include "noise_suppression_mcra_q15.h"
+
+static int16_t ns_sat16(int32_t v)
+{
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+// a * b in Q15, saturated
+static int16_t ns_mul_q15(int16_t a, int16_t b)
+{
+    return ns_sat16(((int32_t)a * b) >> 15);
+}
+
+// x += (t - x) * coef, every step saturated
+static int16_t ns_step_q15(int16_t x, int16_t t, int16_t coef)
+{
+    return ns_sat16(x + ns_mul_q15(ns_sat16(t - x), coef));
+}
+
+static int16_t ns_q15(float v)
+{
+    if (v >= 1.0f)
+        return NS_MCRA_Q15_ONE;
+    if (v <= -1.0f)
+        return -32768;
+    return (int16_t)(v * 32768.0f + (v >= 0.0f ? 0.5f : -0.5f));
+}
+
+static uint16_t ns_q8(float v)
+{
+    if (v <= 0.0f)
+        return 0;
+    if (v >= 255.0f)
+        return 0xFFFF;
+    return (uint16_t)(v * 256.0f + 0.5f);
+}
+
+static void ns_param_convert(NsMcraQ15Handle *self)
+{
+    const NsMcraParam *f = &self->ns_param_f;
+    NsMcraQ15Param *q = &self->ns_param;
+
+    q->alpha_s = ns_q15(f->alpha_s);
+    q->alpha_p = ns_q15(f->alpha_p);
+    q->alpha_d = ns_q15(f->alpha_d);
+    q->floor = ns_q15(f->floor);
+    q->mask_nn_th = ns_q15(f->mask_nn_th);
+    q->mask_nn_I = ns_q15(f->mask_nn_I);
+    q->mask_ns_min = ns_q15(f->mask_ns_min);
+    q->a_low = ns_q15(f->a_low);
+    q->a_high = ns_q15(f->a_high);
+    q->delta = ns_q8(f->delta);
+    q->res = ns_q8(f->res);
+    q->refresh_len = f->refresh_len > 0 ? f->refresh_len : 1;
+}
+
+int noise_suppress_mcra_q15_init(NsMcraQ15Handle *self, const NsMcraParam *param)
+{
+    if (self == NULL)
+        return -1;
+
+    memset(self, 0, sizeof(NsMcraQ15Handle));
+    if (param != NULL) {
+        self->ns_param_f = *param;
+    } else {
+        self->ns_param_f.alpha_s = 0.8f;
+        self->ns_param_f.delta = 5.0f;
+        self->ns_param_f.alpha_p = 0.2f;
+        self->ns_param_f.alpha_d = 0.95f;
+        self->ns_param_f.refresh_len = 100;
+        self->ns_param_f.floor = 0.1f;
+        self->ns_param_f.mask_nn_th = 0.5f;
+        self->ns_param_f.mask_nn_I = 0.5f;
+        self->ns_param_f.mask_ns_min = 0.1f;
+        self->ns_param_f.a_low = 0.3f;
+        self->ns_param_f.a_high = 0.8f;
+        self->ns_param_f.res = 1.0f;
+    }
+    ns_param_convert(self);
+    return 0;
+}
+
+int noise_suppress_mcra_q15_set_param(NsMcraQ15Handle *self, float nn_denoise_level, float a_low)
+{
+    if (self == NULL)
+        return -1;
+
+    self->ns_param_f.mask_nn_I = nn_denoise_level;
+    self->ns_param_f.a_low = a_low;
+    ns_param_convert(self);
+    return 0;
+}
+
+// 1 - a in Q15 with one as 32768, held to 32767 only for a = 0
+static int16_t ns_one_minus(int16_t a)
+{
+    int32_t v = 32768 - a;
+    return (int16_t)(v > NS_MCRA_Q15_ONE ? NS_MCRA_Q15_ONE : v);
+}
+
+// S += (1 - alpha) * (P - S), coef is 1 - alpha in Q15
+static uint32_t ns_smooth32(uint32_t s, uint32_t p, int32_t coef)
+{
+    int64_t d = (int64_t)p - (int64_t)s;
+    return (uint32_t)((int64_t)s + ((d * coef) >> 15));
+}
+
+int noise_suppress_mcra_q15_process(NsMcraQ15Handle *self, const uint32_t *power, const int16_t *mask_nn, int frame_idx, int16_t *mask_ns)
+{
+    const NsMcraQ15Param *q;
+    int32_t s_coef;
+    int32_t g_min;
+    int refresh;
+    int16_t one_m_ap, one_m_ad, c_rise, c_fall;
+
+    if (self == NULL || power == NULL || mask_ns == NULL)
+        return -1;
+
+    q = &self->ns_param;
+    s_coef = 32768 - q->alpha_s;
+    g_min = q->floor > q->mask_ns_min ? q->floor : q->mask_ns_min;
+    refresh = frame_idx > 0 && (frame_idx % q->refresh_len) == 0;
+
+    one_m_ap = ns_one_minus(q->alpha_p);
+    one_m_ad = ns_one_minus(q->alpha_d);
+    c_rise = ns_one_minus(q->a_low);
+    c_fall = ns_one_minus(q->a_high);
+
+    if (frame_idx == 0) {
+        for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+            self->Scur[k] = power[k];
+            self->Smin[k] = power[k];
+            self->Stmp[k] = power[k];
+            self->lambda_d[k] = power[k];
+            self->phat[k] = 0;
+            self->mask_smooth[k] = NS_MCRA_Q15_ONE;
+        }
+    }
+
+    for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+        uint32_t s = ns_smooth32(self->Scur[k], power[k], s_coef);
+        int16_t vad, nd;
+        uint32_t lambda;
+        uint64_t noise;
+        int32_t gain;
+
+        // smoothing and minimum tracking
+        self->Scur[k] = s;
+        if (refresh) {
+            self->Smin[k] = self->Stmp[k] < s ? self->Stmp[k] : s;
+            self->Stmp[k] = s;
+        } else {
+            if (s < self->Smin[k]) {
+                self->Smin[k] = s;
+            }
+            if (s < self->Stmp[k]) {
+                self->Stmp[k] = s;
+            }
+        }
+        vad = ((uint64_t)s << 8) > (uint64_t)self->Smin[k] * q->delta ? NS_MCRA_Q15_ONE : 0;
+
+        // speech presence and 1 - alpha_d_t = (1 - alpha_d) * (1 - p).
+        // stepping p by the difference lets it settle within one lsb of 1,
+        // where the noise update then stops as in float
+        self->phat[k] = ns_step_q15(self->phat[k], vad, one_m_ap);
+        nd = ns_mul_q15(one_m_ad, ns_sat16(NS_MCRA_Q15_ONE - self->phat[k]));
+
+        // noise update and gain
+        lambda = ns_smooth32(self->lambda_d[k], power[k], nd);
+        noise = ((uint64_t)lambda * q->res) >> 8;
+        self->lambda_d[k] = lambda;
+        if (power[k] == 0 || noise >= power[k]) {
+            gain = g_min;
+        } else {
+            // (P - N) / P with P shifted down to 16 bits, a 32 bit divide
+            uint32_t d = power[k] - (uint32_t)noise;
+            int sh = power[k] >= 65536 ? 16 - __builtin_clz(power[k]) : 0;
+
+            gain = (int32_t)(((d >> sh) << 15) / (power[k] >> sh));
+            gain = gain < g_min ? g_min : (gain > NS_MCRA_Q15_ONE ? NS_MCRA_Q15_ONE : gain);
+        }
+        if (mask_nn != NULL && mask_nn[k] < q->mask_nn_th) {
+            gain = (gain * q->mask_nn_I) >> 15;
+        }
+
+        // mask smoothing, a_low while the gain rises, a_high while it falls
+        self->mask_smooth[k] = ns_step_q15(self->mask_smooth[k], (int16_t)gain,
+                                           self->mask_smooth[k] < gain ? c_rise : c_fall);
+        mask_ns[k] = self->mask_smooth[k];
+    }
+
+    return 0;
+}
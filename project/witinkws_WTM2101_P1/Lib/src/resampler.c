@@ -0,0 +1,296 @@
+#include <math.h>
+#include <string.h>
+#include "resampler.h"
+
+#ifdef PLATFORM_RSIC_V_N307
+#include "riscv_math.h"
+#endif
+
+#define RESAMPLER_KAISER_BETA       (5.5f)      // about 58 dB stop band
+#define RESAMPLER_PASS              (0.4f)      // pass band edge, of the lower rate
+#define RESAMPLER_MAX_RATIO         (1024)
+
+static int16_t resampler_sat16(int32_t v)
+{
+    return (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+}
+
+static float resampler_bessel_i0(float x)
+{
+    float sum = 1.0f;
+    float term = 1.0f;
+
+    for (int k = 1; k < 32; k++) {
+        term *= (x * 0.5f / k) * (x * 0.5f / k);
+        sum += term;
+        if (term < sum * 1e-7f)
+            break;
+    }
+    return sum;
+}
+
+// tap i of a kaiser windowed sinc of len taps, cut at fc of the rate (0 .. 0.5)
+static float resampler_tap(uint32_t i, uint32_t len, float fc)
+{
+    float t = (float)i - (len - 1) * 0.5f;
+    float r = len > 1 ? 2.0f * i / (len - 1) - 1.0f : 0.0f;
+    float w = resampler_bessel_i0(RESAMPLER_KAISER_BETA * sqrtf(1.0f - r * r)) / resampler_bessel_i0(RESAMPLER_KAISER_BETA);
+    float x = 3.14159265359f * 2.0f * fc * t;
+
+    return 2.0f * fc * (t == 0.0f ? 1.0f : sinf(x) / x) * w;
+}
+
+// cut off of a len tap kaiser low pass whose pass band ends at pass (both
+// of the rate it runs at): the middle of the transition band it can have
+static float resampler_cutoff(float pass, uint32_t len)
+{
+    float atten = RESAMPLER_KAISER_BETA / 0.1102f + 8.7f;
+    float width = (atten - 8.0f) / (2.285f * 6.28318530718f * (len - 1));
+
+    return pass + 0.5f * width;
+}
+
+static int16_t resampler_q15(float v)
+{
+    float q = v * 32768.0f;
+    return (int16_t)(q >= 32767.0f ? 32767 : (q <= -32768.0f ? -32768 : lroundf(q)));
+}
+
+// the folded kernel keeps the exact sum in 32 bits while sum |c| < 2
+static int resampler_fits32(const int16_t *c, uint16_t taps)
+{
+    uint32_t sum = 0;
+
+    for (int j = 0; j < taps; j++) {
+        sum += c[j] < 0 ? -c[j] : c[j];
+    }
+    return sum < 65536;
+}
+
+/* decimator */
+
+#ifdef PLATFORM_RSIC_V_N307
+
+static void resampler_decim_generic(resampler_decim_t *dec, const int16_t *in, int16_t *out)
+{
+    riscv_fir_decimate_instance_q15 inst;
+
+    inst.M = dec->factor;
+    inst.numTaps = dec->taps;
+    inst.pCoeffs = dec->coeffs;
+    inst.pState = dec->state;
+    riscv_fir_decimate_q15(&inst, in, out, dec->block);
+}
+
+#else
+
+// the plain C path of riscv_fir_decimate_q15: 64 bit sum, >> 15, saturated
+static void resampler_decim_generic(resampler_decim_t *dec, const int16_t *in, int16_t *out)
+{
+    int keep = dec->taps - 1;
+
+    memcpy(dec->state + keep, in, dec->block * sizeof(int16_t));
+    for (int n = 0; n < dec->block / dec->factor; n++) {
+        const int16_t *x = dec->state + n * dec->factor;
+        int64_t acc = 0;
+
+        for (int j = 0; j < dec->taps; j++) {
+            acc += (int32_t)dec->coeffs[j] * x[j];
+        }
+        acc >>= 15;
+        out[n] = (int16_t)(acc > 32767 ? 32767 : (acc < -32768 ? -32768 : acc));
+    }
+    memmove(dec->state, dec->state + dec->block, keep * sizeof(int16_t));
+}
+
+#endif
+
+// 3:1 with a symmetric filter: the two samples under one coefficient are
+// added first, half the multiplies, and the sum stays in 32 bits
+static void resampler_decim_fast3(resampler_decim_t *dec, const int16_t *in, int16_t *out)
+{
+    const int16_t *c = dec->coeffs;
+    int keep = dec->taps - 1;
+    int half = dec->taps / 2;
+
+    memcpy(dec->state + keep, in, dec->block * sizeof(int16_t));
+    for (int n = 0; n < dec->block / 3; n++) {
+        const int16_t *lo = dec->state + 3 * n;
+        const int16_t *hi = lo + keep;
+        int32_t acc = (dec->taps & 1) ? (int32_t)c[half] * lo[half] : 0;
+
+        for (int j = 0; j < half; j++) {
+            acc += c[j] * ((int32_t)*lo++ + *hi--);
+        }
+        out[n] = resampler_sat16(acc >> 15);
+    }
+    memmove(dec->state, dec->state + dec->block, keep * sizeof(int16_t));
+}
+
+int resampler_decim_init(resampler_decim_t *dec, uint8_t factor, uint16_t block, const int16_t *coeffs, uint16_t taps)
+{
+    if (dec == NULL || factor < 2 || factor > 8 || block == 0 || block > RESAMPLER_MAX_BLOCK || block % factor)
+        return -1;
+
+    memset(dec, 0, sizeof(resampler_decim_t));
+    dec->factor = factor;
+    dec->block = block;
+
+    if (coeffs == NULL) {
+        float fc;
+        float sum = 0.0f;
+
+        taps = factor == 3 ? RESAMPLER_3TO1_TAPS : 24 * factor;
+        if (taps > RESAMPLER_MAX_TAPS) {
+            taps = RESAMPLER_MAX_TAPS;
+        }
+        fc = resampler_cutoff(RESAMPLER_PASS / factor, taps);
+        for (int i = 0; i < taps; i++) {
+            sum += resampler_tap(i, taps, fc);
+        }
+        for (int i = 0; i < taps; i++) {
+            dec->coeffs[i] = resampler_q15(resampler_tap(i, taps, fc) / sum);
+        }
+    } else {
+        if (taps == 0 || taps > RESAMPLER_MAX_TAPS)
+            return -1;
+        memcpy(dec->coeffs, coeffs, taps * sizeof(int16_t));
+    }
+    dec->taps = taps;
+
+    dec->fast = factor == 3 && resampler_fits32(dec->coeffs, taps);
+    for (int j = 0; j < taps / 2 && dec->fast; j++) {
+        dec->fast = dec->coeffs[j] == dec->coeffs[taps - 1 - j];
+    }
+    return 0;
+}
+
+void resampler_decim_reset(resampler_decim_t *dec)
+{
+    memset(dec->state, 0, sizeof(dec->state));
+}
+
+int resampler_decim_process(resampler_decim_t *dec, const int16_t *in, int16_t *out)
+{
+    if (dec->fast) {
+        resampler_decim_fast3(dec, in, out);
+    } else {
+        resampler_decim_generic(dec, in, out);
+    }
+    return dec->block / dec->factor;
+}
+
+/* rational */
+
+static uint32_t resampler_gcd(uint32_t a, uint32_t b)
+{
+    while (b != 0) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+int resampler_rational_init(resampler_rational_t *rs, uint32_t rate_in, uint32_t rate_out, uint16_t taps,
+                            int16_t *coeffs, uint32_t coeff_len)
+{
+    uint32_t g, up, down, len, stored;
+    float fc, sum = 0.0f;
+
+    if (rs == NULL || coeffs == NULL || rate_in == 0 || rate_out == 0)
+        return -1;
+    if (taps == 0) {
+        taps = RESAMPLER_PHASE_TAPS;
+    }
+    if (taps > RESAMPLER_MAX_PHASE_TAPS)
+        return -1;
+
+    g = resampler_gcd(rate_in, rate_out);
+    up = rate_out / g;
+    down = rate_in / g;
+    if (up > RESAMPLER_MAX_RATIO || down > RESAMPLER_MAX_RATIO)
+        return -1;
+    stored = (up + 1) / 2;
+    if (coeff_len < RESAMPLER_RATIONAL_COEFF_LEN(up, taps))
+        return -2;
+
+    memset(rs, 0, sizeof(resampler_rational_t));
+    rs->up = (uint16_t)up;
+    rs->down = (uint16_t)down;
+    rs->taps = taps;
+    rs->coeffs = coeffs;
+
+    // prototype of up * taps at rate_in * up, a gain of up makes each phase about 1
+    len = up * taps;
+    fc = resampler_cutoff(RESAMPLER_PASS * (rate_in < rate_out ? rate_in : rate_out) / ((float)rate_in * up), len);
+    for (uint32_t i = 0; i < len; i++) {
+        sum += resampler_tap(i, len, fc);
+    }
+    for (uint32_t p = 0; p < stored; p++) {
+        for (uint32_t j = 0; j < taps; j++) {
+            coeffs[p * taps + j] = resampler_q15(resampler_tap(p + j * up, len, fc) * up / sum);
+        }
+        if (!resampler_fits32(coeffs + p * taps, taps))
+            return -1;
+    }
+
+    resampler_rational_reset(rs);
+    return 0;
+}
+
+void resampler_rational_reset(resampler_rational_t *rs)
+{
+    memset(rs->buf, 0, sizeof(rs->buf));
+    rs->phase = 0;
+    rs->next = 0;
+}
+
+uint32_t resampler_rational_max_out(const resampler_rational_t *rs, uint32_t num)
+{
+    return (uint32_t)(((uint64_t)num * rs->up + rs->down - 1) / rs->down) + 1;
+}
+
+int resampler_rational_process(resampler_rational_t *rs, const int16_t *in, uint32_t num, int16_t *out)
+{
+    int keep = rs->taps - 1;
+    int stored = (rs->up + 1) / 2;
+    int count = 0;
+
+    if (rs == NULL || in == NULL || out == NULL || num > RESAMPLER_MAX_BLOCK)
+        return -1;
+
+    memcpy(rs->buf + keep, in, num * sizeof(int16_t));
+
+    // output m sits at m * down on the up-sampled grid: newest input
+    // next, phase p, y = sum_j g_p[j] * x[next - j]
+    while (rs->next < (int32_t)num) {
+        const int16_t *x = rs->buf + keep + rs->next;
+        int32_t acc = 0;
+
+        if (rs->phase < stored) {
+            const int16_t *c = rs->coeffs + rs->phase * rs->taps;
+
+            for (int j = 0; j < rs->taps; j++) {
+                acc += c[j] * x[-j];
+            }
+        } else {
+            // g_p[j] = g_(up - 1 - p)[taps - 1 - j], oldest input first
+            const int16_t *c = rs->coeffs + (rs->up - 1 - rs->phase) * rs->taps;
+
+            x -= keep;
+            for (int j = 0; j < rs->taps; j++) {
+                acc += c[j] * x[j];
+            }
+        }
+        out[count++] = resampler_sat16((acc + (1 << 14)) >> 15);
+
+        rs->phase += rs->down;
+        rs->next += rs->phase / rs->up;
+        rs->phase %= rs->up;
+    }
+
+    rs->next -= num;
+    memmove(rs->buf, rs->buf + num, keep * sizeof(int16_t));
+    return count;
+}
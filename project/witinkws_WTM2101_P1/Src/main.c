@@ -56,6 +56,9 @@
 #include "LibNPU.h"
 #include "witin_npu_interface.h"
 #include "mnist_data.h"
+#ifdef BUCKET_TOKENS_BENCH
+#include "bucket_tokens.h"
+#endif
 
 
 #define MIN(X, Y)  ((X) < (Y) ? (X) : (Y))
@@ -214,6 +217,10 @@ void main(void)
     uart_open();
     printf_output_redirect_set(USE_PRINTF);
     printf("uart ok\r\n");
+#ifdef BUCKET_TOKENS_BENCH
+    // RAM_BENCH configuration only
+    bucket_tokens_bench();
+#endif
 
     int ret = npu_init();
     if(ret){
@@ -0,0 +1,81 @@
+#include <stddef.h>
+#include "core_host.h"
+#include "rcc.h"
+
+uint32_t core_host_hz = 24576000;
+
+static uint64_t core_cycle;
+static rv_csr_t core_mstatus = MSTATUS_MIE;
+static uint32_t core_wfi;
+static core_host_wfi_hook_t core_wfi_hook;
+
+void core_host_reset(uint32_t hz, core_host_wfi_hook_t wfi)
+{
+    core_host_hz = hz;
+    core_cycle = 0;
+    core_mstatus = MSTATUS_MIE;
+    core_wfi = 0;
+    core_wfi_hook = wfi;
+}
+
+void core_host_advance(uint64_t cycles)
+{
+    core_cycle += cycles;
+}
+
+rv_csr_t core_host_mie(void)
+{
+    return core_mstatus & MSTATUS_MIE;
+}
+
+uint32_t core_host_wfi_count(void)
+{
+    return core_wfi;
+}
+
+rv_csr_t core_host_csr_read_clear(rv_csr_t val)
+{
+    rv_csr_t old = core_mstatus;
+
+    core_mstatus &= ~val;
+    return old;
+}
+
+void core_host_csr_set(rv_csr_t val)
+{
+    core_mstatus |= val;
+}
+
+void __enable_irq(void)
+{
+    core_mstatus |= MSTATUS_MIE;
+}
+
+void __disable_irq(void)
+{
+    core_mstatus &= ~MSTATUS_MIE;
+}
+
+// a pending interrupt wakes the core whatever MIE is
+void __WFI(void)
+{
+    core_wfi++;
+    if (core_wfi_hook != NULL) {
+        core_wfi_hook();
+    }
+}
+
+uint64_t __get_rv_cycle(void)
+{
+    return core_cycle;
+}
+
+uint32_t RCC_Get_SYSClk(void)
+{
+    return core_host_hz;
+}
+
+uint8_t RCC_AHB_Get_ClkDiv(void)
+{
+    return 0;
+}
@@ -0,0 +1,22 @@
+#ifndef CORE_HOST_H
+#define CORE_HOST_H
+
+#include <stdint.h>
+#include "nmsis_core.h"
+
+// the core clock RCC_Get_SYSClk reports, the AHB divider is 1
+extern uint32_t core_host_hz;
+
+// called by __WFI in place of sleeping: advance the clock with
+// core_host_advance and run the interrupt that wakes the core. with no
+// hook __WFI only counts
+typedef void (*core_host_wfi_hook_t)(void);
+
+void core_host_reset(uint32_t hz, core_host_wfi_hook_t wfi);
+void core_host_advance(uint64_t cycles);
+
+// MSTATUS.MIE, 0 or MSTATUS_MIE
+rv_csr_t core_host_mie(void);
+uint32_t core_host_wfi_count(void);
+
+#endif // CORE_HOST_H
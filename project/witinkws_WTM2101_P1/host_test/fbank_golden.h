@@ -0,0 +1,14 @@
+#ifndef FBANK_GOLDEN_H
+#define FBANK_GOLDEN_H
+
+#include <stdint.h>
+
+// the board checks of the SDK fft example, sram words in and out
+extern const uint32_t fbank_golden_ifft_wdata[512];
+extern const uint32_t fbank_golden_ifft_odata[512];
+extern const uint32_t fbank_golden_fft_wdata[512];
+extern const uint32_t fbank_golden_fft_odata[512];
+extern const uint32_t fbank_golden_fbank_wdata[512];
+extern const uint32_t fbank_golden_fbank_rdata[10];
+
+#endif // FBANK_GOLDEN_H
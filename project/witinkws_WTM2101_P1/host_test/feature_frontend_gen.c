@@ -0,0 +1,55 @@
+// host generator: prints the tables of one front end as C, to be built in
+// as const data instead of generating them at startup
+//
+//   feature_frontend_gen <name> <sample_rate> <nfft> <win_ms> <shift_ms> <num_mel_bins>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "feature_frontend.h"
+#include "fbank_ref.h"
+
+static feature_frontend_t gen_fe;
+static feature_frontend_tables_t gen_tab;
+
+int main(int argc, char** argv)
+{
+    const char* name;
+    int ret;
+
+    if (argc < 7) {
+        printf("usage: %s <name> <sample_rate> <nfft> <win_ms> <shift_ms> <num_mel_bins>\n", argv[0]);
+        return 2;
+    }
+    name = argv[1];
+    ret = feature_frontend_generate(&gen_fe, &gen_tab, (uint16_t)atoi(argv[2]), (uint16_t)atoi(argv[3]),
+                                    (uint16_t)atoi(argv[4]), (uint16_t)atoi(argv[5]), (uint16_t)atoi(argv[6]));
+    if (ret != 0) {
+        fprintf(stderr, "feature_frontend_generate: %d\n", ret);
+        return 1;
+    }
+
+    printf("// %u Hz, %u point fft, %u/%u samples, %u mel bins\n",
+           gen_fe.sample_rate, gen_fe.nfft, gen_fe.win_size, gen_fe.shift_size, gen_fe.num_mel_bins);
+    printf("#include \"feature_frontend.h\"\n\n");
+    for (int m = 0; m < gen_fe.num_mel_bins; m++) {
+        const fbank_cfg_t* cfg = &gen_fe.filters[m];
+        printf("static uint16_t %s_w%d[] = {", name, m);
+        for (int i = 0; i < fbank_ref_mel_len(cfg); i++) {
+            printf(i ? ",%u" : "%u", cfg->melfiter[i]);
+        }
+        printf("};\n");
+    }
+    printf("\nstatic const fbank_cfg_t %s_filters[%u] = {", name, gen_fe.num_mel_bins);
+    for (int m = 0; m < gen_fe.num_mel_bins; m++) {
+        printf("%s{%u,%u,%s_w%d}", m ? "," : "", gen_fe.filters[m].start, gen_fe.filters[m].end, name, m);
+    }
+    printf("};\n\nstatic const short %s_window[%u] = {", name, gen_fe.win_size);
+    for (int n = 0; n < gen_fe.win_size; n++) {
+        printf("%s%s%d", n ? "," : "", n % 16 ? "" : "\n    ", gen_fe.window[n]);
+    }
+    printf("\n};\n\nconst feature_frontend_t %s = {\n", name);
+    printf("    %u, %u, %u, %u, %u, %u, 0, %s_filters, %s_window,\n};\n",
+           gen_fe.sample_rate, gen_fe.nfft, gen_fe.win_size, gen_fe.shift_size,
+           gen_fe.num_mel_bins, gen_fe.bin_stride, name, name);
+    return 0;
+}
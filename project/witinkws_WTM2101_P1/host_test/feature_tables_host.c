@@ -0,0 +1,167 @@
+// host copy of the feature tables Library.a carries for the device build,
+// generated with the Kaldi formulas of feature_frontend_generate()
+// (16 kHz, 512 point fft, 400 sample povey window, 40 mel bins from 20 Hz).
+// Library.a is not in the tree, so these are not a copy of its tables.
+// the block uses the upper byte of each weight only (fbank_ref_mel_term),
+// and with these tables fbank_ref_calculate gives the board bytes of the
+// SDK fft example exactly (test_fbank_ref).
+
+#include "feature_tools.h"
+
+static uint16_t host_mel_w0[] = {16718, 61842, 25917};
+static uint16_t host_mel_w1[] = {39618, 49814, 9723};
+static uint16_t host_mel_w2[] = {15721, 55812, 36606};
+static uint16_t host_mel_w3[] = {28929, 64826, 28759};
+static uint16_t host_mel_w4[] = {709, 36776, 59395, 25589};
+static uint16_t host_mel_w5[] = {6140, 39946, 58347, 26536};
+static uint16_t host_mel_w6[] = {7188, 38999, 61173, 31134, 1910};
+static uint16_t host_mel_w7[] = {4362, 34401, 63625, 38992, 11271};
+static uint16_t host_mel_w8[] = {26543, 54264, 49780, 23414};
+static uint16_t host_mel_w9[] = {15755, 42121, 63213, 38076, 13512};
+static uint16_t host_mel_w10[] = {2322, 27459, 52023, 55031, 31538, 8545};
+static uint16_t host_mel_w11[] = {10504, 33997, 56990, 51569, 29516, 7906};
+static uint16_t host_mel_w12[] = {13967, 36019, 57629, 52256, 31479, 11094};
+static uint16_t host_mel_w13[] = {13279, 34056, 54441, 56624, 36982, 17691};
+static uint16_t host_mel_w14[] = {8911, 28553, 47844, 64276, 45651, 27343, 9341};
+static uint16_t host_mel_w15[] = {1259, 19884, 38192, 56194, 57170, 39750, 22606, 5731};
+static uint16_t host_mel_w16[] = {8365, 25785, 42929, 59804, 54651, 38288, 22169, 6288};
+static uint16_t host_mel_w17[] = {10884, 27247, 43366, 59247, 56173, 40747, 25538, 10540};
+static uint16_t host_mel_w18[] = {9362, 24788, 39997, 54995, 61284, 46692, 32295, 18088, 4065};
+static uint16_t host_mel_w19[] = {4251, 18843, 33240, 47447, 61470, 55759, 42092, 28596, 15267, 2100};
+static uint16_t host_mel_w20[] = {9776, 23443, 36939, 50268, 63435, 54629, 41776, 29075, 16522, 4113};
+static uint16_t host_mel_w21[] = {10906, 23759, 36460, 49013, 61422, 57381, 45251, 33257, 21394, 9660};
+static uint16_t host_mel_w22[] = {8154, 20284, 32278, 44141, 55875, 63589, 52105, 40743, 29498, 18370, 7355};
+static uint16_t host_mel_w23[] = {1946, 13430, 24792, 36037, 47165, 58180, 61988, 51194, 40507, 29925, 19445, 9067};
+static uint16_t host_mel_w24[] = {3547, 14341, 25028, 35610, 46090, 56468, 64324, 54141, 44054, 34060, 24158, 14346, 4623};
+static uint16_t host_mel_w25[] = {1211, 11394, 21481, 31475, 41377, 51189, 60912, 60522, 50971, 41504, 32119, 22815, 13591, 4445};
+static uint16_t host_mel_w26[] = {5013, 14564, 24031, 33416, 42720, 51944, 61090, 60912, 51918, 42999, 34153, 25379, 16676, 8043};
+static uint16_t host_mel_w27[] = {4623, 13617, 22536, 31382, 40156, 48859, 57492, 65014, 56516, 48085, 39720, 31418, 23181, 15006, 6892};
+static uint16_t host_mel_w28[] = {521, 9019, 17450, 25815, 34117, 42354, 50530, 58643, 64374, 56381, 48446, 40570, 32750, 24987, 17279, 9626, 2027};
+static uint16_t host_mel_w29[] = {1161, 9154, 17089, 24966, 32785, 40548, 48256, 55909, 63508, 60017, 52523, 45081, 37690, 30350, 23059, 15817, 8624, 1478};
+static uint16_t host_mel_w30[] = {5518, 13012, 20454, 27845, 35185, 42476, 49718, 56911, 64057, 59915, 52863, 45856, 38894, 31978, 25105, 18276, 11490, 4746};
+static uint16_t host_mel_w31[] = {5620, 12672, 19679, 26641, 33557, 40430, 47259, 54045, 60789, 63580, 56920, 50300, 43721, 37182, 30682, 24221, 17799, 11414, 5068};
+static uint16_t host_mel_w32[] = {1955, 8615, 15235, 21814, 28353, 34853, 41314, 47736, 54121, 60467, 64294, 58021, 51785, 45584, 39418, 33288, 27192, 21131, 15104, 9110, 3149};
+static uint16_t host_mel_w33[] = {1241, 7514, 13750, 19951, 26117, 32247, 38343, 44404, 50431, 56425, 62386, 62757, 56861, 50997, 45165, 39365, 33595, 27857, 22148, 16470, 10821, 5202};
+static uint16_t host_mel_w34[] = {2778, 8674, 14538, 20370, 26170, 31940, 37678, 43387, 49065, 54714, 60333, 65148, 59587, 54054, 48550, 43074, 37625, 32203, 26809, 21441, 16100, 10786, 5498, 235};
+static uint16_t host_mel_w35[] = {387, 5948, 11481, 16985, 22461, 27910, 33332, 38726, 44094, 49435, 54749, 60037, 65300, 60534, 55322, 50135, 44973, 39836, 34723, 29634, 24569, 19528, 14511, 9516, 4544};
+static uint16_t host_mel_w36[] = {5001, 10213, 15400, 20562, 25699, 30812, 35901, 40966, 46007, 51024, 56019, 60991, 65132, 60206, 55302, 50421, 45561, 40724, 35907, 31113, 26339, 21587, 16855, 12145, 7454, 2784};
+static uint16_t host_mel_w37[] = {403, 5329, 10233, 15114, 19974, 24811, 29628, 34422, 39196, 43948, 48680, 53390, 58081, 62751, 63670, 59040, 54430, 49839, 45268, 40717, 36184, 31670, 27176, 22699, 18242, 13802, 9381, 4978, 593};
+static uint16_t host_mel_w38[] = {1865, 6495, 11105, 15696, 20267, 24818, 29351, 33865, 38359, 42836, 47293, 51733, 56154, 60557, 64942, 61762, 57412, 53079, 48764, 44466, 40186, 35922, 31675, 27445, 23231, 19033, 14852, 10687, 6538, 2405};
+static uint16_t host_mel_w39[] = {3773, 8123, 12456, 16771, 21069, 25349, 29613, 33860, 38090, 42304, 46502, 50683, 54848, 58997, 63130, 63824, 59722, 55636, 51565, 47510, 43470, 39445, 35435, 31440, 27459, 23493, 19542, 15605, 11682, 7774, 3880};
+
+const fbank_cfg_t FBANK_FILTERS[_NUM_MEL_BINS] = {
+    {1, 3, host_mel_w0},
+    {3, 5, host_mel_w1},
+    {4, 6, host_mel_w2},
+    {6, 8, host_mel_w3},
+    {7, 10, host_mel_w4},
+    {9, 12, host_mel_w5},
+    {11, 15, host_mel_w6},
+    {13, 17, host_mel_w7},
+    {16, 19, host_mel_w8},
+    {18, 22, host_mel_w9},
+    {20, 25, host_mel_w10},
+    {23, 28, host_mel_w11},
+    {26, 31, host_mel_w12},
+    {29, 34, host_mel_w13},
+    {32, 38, host_mel_w14},
+    {35, 42, host_mel_w15},
+    {39, 46, host_mel_w16},
+    {43, 50, host_mel_w17},
+    {47, 55, host_mel_w18},
+    {51, 60, host_mel_w19},
+    {56, 65, host_mel_w20},
+    {61, 70, host_mel_w21},
+    {66, 76, host_mel_w22},
+    {71, 82, host_mel_w23},
+    {77, 89, host_mel_w24},
+    {83, 96, host_mel_w25},
+    {90, 103, host_mel_w26},
+    {97, 111, host_mel_w27},
+    {104, 120, host_mel_w28},
+    {112, 129, host_mel_w29},
+    {121, 138, host_mel_w30},
+    {130, 148, host_mel_w31},
+    {139, 159, host_mel_w32},
+    {149, 170, host_mel_w33},
+    {160, 183, host_mel_w34},
+    {171, 195, host_mel_w35},
+    {184, 209, host_mel_w36},
+    {196, 224, host_mel_w37},
+    {210, 239, host_mel_w38},
+    {225, 255, host_mel_w39},
+};
+
+const unsigned short povey_win[_WIN_SIZE] = {
+    0, 17, 56, 112, 183, 268, 365, 475, 595, 727, 869, 1022,
+    1184, 1356, 1538, 1728, 1928, 2136, 2352, 2577, 2810, 3051, 3299, 3555,
+    3819, 4090, 4368, 4653, 4945, 5244, 5549, 5861, 6179, 6503, 6834, 7170,
+    7512, 7860, 8214, 8573, 8938, 9308, 9683, 10063, 10448, 10837, 11232, 11631,
+    12034, 12442, 12854, 13271, 13691, 14115, 14543, 14975, 15410, 15849, 16291, 16737,
+    17185, 17637, 18092, 18549, 19009, 19472, 19937, 20405, 20875, 21347, 21821, 22297,
+    22775, 23255, 23736, 24219, 24703, 25189, 25676, 26164, 26653, 27143, 27633, 28125,
+    28616, 29109, 29601, 30094, 30588, 31081, 31574, 32067, 32560, 33052, 33544, 34035,
+    34526, 35016, 35504, 35993, 36479, 36965, 37450, 37933, 38414, 38895, 39373, 39850,
+    40324, 40797, 41268, 41737, 42203, 42667, 43129, 43588, 44044, 44498, 44949, 45397,
+    45842, 46284, 46723, 47159, 47591, 48020, 48446, 48867, 49286, 49700, 50111, 50517,
+    50920, 51319, 51713, 52103, 52489, 52871, 53248, 53621, 53989, 54352, 54711, 55065,
+    55414, 55758, 56096, 56430, 56759, 57083, 57401, 57714, 58021, 58323, 58620, 58911,
+    59196, 59476, 59750, 60018, 60280, 60537, 60787, 61032, 61270, 61502, 61729, 61949,
+    62163, 62370, 62571, 62766, 62955, 63137, 63313, 63482, 63645, 63801, 63950, 64093,
+    64230, 64360, 64483, 64599, 64709, 64811, 64907, 64997, 65079, 65155, 65224, 65286,
+    65341, 65389, 65431, 65465, 65493, 65513, 65527, 65534, 65534, 65527, 65513, 65493,
+    65465, 65431, 65389, 65341, 65286, 65224, 65155, 65079, 64997, 64907, 64811, 64709,
+    64599, 64483, 64360, 64230, 64093, 63950, 63801, 63645, 63482, 63313, 63137, 62955,
+    62766, 62571, 62370, 62163, 61949, 61729, 61502, 61270, 61032, 60787, 60537, 60280,
+    60018, 59750, 59476, 59196, 58911, 58620, 58323, 58021, 57714, 57401, 57083, 56759,
+    56430, 56096, 55758, 55414, 55065, 54711, 54352, 53989, 53621, 53248, 52871, 52489,
+    52103, 51713, 51319, 50920, 50517, 50111, 49700, 49286, 48867, 48445, 48020, 47591,
+    47159, 46723, 46284, 45842, 45397, 44949, 44498, 44044, 43588, 43129, 42667, 42203,
+    41737, 41268, 40797, 40324, 39850, 39373, 38895, 38414, 37933, 37450, 36965, 36479,
+    35992, 35504, 35016, 34526, 34035, 33544, 33052, 32559, 32067, 31574, 31081, 30588,
+    30094, 29601, 29109, 28616, 28125, 27633, 27143, 26653, 26164, 25676, 25189, 24703,
+    24219, 23736, 23255, 22775, 22297, 21821, 21347, 20875, 20405, 19937, 19472, 19009,
+    18549, 18092, 17637, 17185, 16737, 16291, 15849, 15410, 14975, 14543, 14115, 13691,
+    13271, 12854, 12442, 12034, 11631, 11232, 10837, 10448, 10063, 9683, 9308, 8938,
+    8573, 8214, 7860, 7512, 7170, 6834, 6503, 6179, 5861, 5549, 5244, 4945,
+    4653, 4368, 4090, 3819, 3555, 3299, 3051, 2810, 2577, 2352, 2136, 1928,
+    1728, 1538, 1356, 1184, 1022, 869, 727, 595, 475, 365, 268, 183,
+    112, 56, 17, 0
+};
+
+const short povey_win_signed[_WIN_SIZE] = {
+    0, 9, 28, 56, 92, 134, 183, 237, 298, 364, 435, 511,
+    592, 678, 769, 864, 964, 1068, 1176, 1288, 1405, 1525, 1650, 1778,
+    1909, 2045, 2184, 2326, 2472, 2622, 2774, 2930, 3089, 3252, 3417, 3585,
+    3756, 3930, 4107, 4287, 4469, 4654, 4841, 5031, 5224, 5419, 5616, 5815,
+    6017, 6221, 6427, 6635, 6845, 7058, 7272, 7487, 7705, 7924, 8146, 8368,
+    8593, 8818, 9046, 9274, 9504, 9736, 9968, 10202, 10437, 10673, 10910, 11148,
+    11387, 11627, 11868, 12109, 12352, 12594, 12838, 13082, 13326, 13571, 13816, 14062,
+    14308, 14554, 14801, 15047, 15294, 15540, 15787, 16033, 16280, 16526, 16772, 17017,
+    17263, 17507, 17752, 17996, 18239, 18482, 18725, 18966, 19207, 19447, 19686, 19924,
+    20162, 20398, 20634, 20868, 21101, 21333, 21564, 21794, 22022, 22249, 22474, 22698,
+    22921, 23142, 23361, 23579, 23795, 24010, 24222, 24433, 24642, 24850, 25055, 25258,
+    25460, 25659, 25856, 26051, 26244, 26435, 26624, 26810, 26994, 27176, 27355, 27532,
+    27706, 27878, 28048, 28215, 28379, 28541, 28700, 28856, 29010, 29161, 29310, 29455,
+    29598, 29738, 29874, 30009, 30140, 30268, 30393, 30515, 30635, 30751, 30864, 30974,
+    31081, 31185, 31285, 31383, 31477, 31568, 31656, 31740, 31822, 31900, 31975, 32046,
+    32114, 32179, 32241, 32299, 32354, 32405, 32453, 32498, 32539, 32577, 32611, 32642,
+    32670, 32694, 32715, 32732, 32746, 32756, 32763, 32767, 32767, 32763, 32756, 32746,
+    32732, 32715, 32694, 32670, 32642, 32611, 32577, 32539, 32498, 32453, 32405, 32354,
+    32299, 32241, 32179, 32114, 32046, 31975, 31900, 31822, 31740, 31656, 31568, 31477,
+    31383, 31285, 31185, 31081, 30974, 30864, 30751, 30635, 30515, 30393, 30268, 30140,
+    30009, 29874, 29738, 29598, 29455, 29310, 29161, 29010, 28856, 28700, 28541, 28379,
+    28215, 28048, 27878, 27706, 27532, 27355, 27176, 26994, 26810, 26624, 26435, 26244,
+    26051, 25856, 25659, 25460, 25258, 25055, 24850, 24642, 24433, 24222, 24010, 23795,
+    23579, 23361, 23142, 22921, 22698, 22474, 22249, 22022, 21794, 21564, 21333, 21101,
+    20868, 20634, 20398, 20162, 19924, 19686, 19447, 19207, 18966, 18725, 18482, 18239,
+    17996, 17752, 17507, 17263, 17017, 16772, 16526, 16279, 16033, 15787, 15540, 15294,
+    15047, 14801, 14554, 14308, 14062, 13816, 13571, 13326, 13082, 12838, 12594, 12352,
+    12109, 11868, 11627, 11387, 11148, 10910, 10673, 10437, 10202, 9968, 9736, 9504,
+    9274, 9046, 8818, 8593, 8368, 8146, 7924, 7705, 7487, 7272, 7058, 6845,
+    6635, 6427, 6221, 6017, 5815, 5616, 5419, 5224, 5031, 4841, 4654, 4469,
+    4287, 4107, 3930, 3756, 3585, 3417, 3252, 3089, 2930, 2774, 2622, 2472,
+    2326, 2184, 2045, 1909, 1778, 1650, 1525, 1405, 1288, 1176, 1068, 964,
+    864, 769, 678, 592, 511, 435, 364, 298, 237, 183, 134, 92,
+    56, 28, 9, 0
+};
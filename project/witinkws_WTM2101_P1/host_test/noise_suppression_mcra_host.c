@@ -0,0 +1,100 @@
+// host float MCRA: the recursion documented in noise_suppression_mcra_q15.h
+// in float, so the Q15 version can be checked on the host. it is not the
+// noise_suppress_mcra_* of Library.a, which is not in the tree: the Sr
+// state of NsMcraHandle suggests the library smooths differently, it is
+// left unused here. same defaults as the Q15 init.
+
+#include <string.h>
+#include "noise_suppression_mcra.h"
+
+int noise_suppress_mcra_init(NsMcraHandle *self)
+{
+    if (self == NULL)
+        return -1;
+
+    memset(self, 0, sizeof(NsMcraHandle));
+    self->ns_param.alpha_s = 0.8f;
+    self->ns_param.delta = 5.0f;
+    self->ns_param.alpha_p = 0.2f;
+    self->ns_param.alpha_d = 0.95f;
+    self->ns_param.refresh_len = 100;
+    self->ns_param.floor = 0.1f;
+    self->ns_param.mask_nn_th = 0.5f;
+    self->ns_param.mask_nn_I = 0.5f;
+    self->ns_param.mask_ns_min = 0.1f;
+    self->ns_param.a_low = 0.3f;
+    self->ns_param.a_high = 0.8f;
+    self->ns_param.res = 1.0f;
+    return 0;
+}
+
+int noise_suppress_mcra_set_param(NsMcraHandle *self, float nn_denoise_level, float a_low)
+{
+    if (self == NULL)
+        return -1;
+
+    self->ns_param.mask_nn_I = nn_denoise_level;
+    self->ns_param.a_low = a_low;
+    return 0;
+}
+
+int noise_suppress_mcra_process(NsMcraHandle *self, float *power, float *mask_nn, int frame_idx, float *mask_ns)
+{
+    const NsMcraParam *q;
+    float g_min;
+    int refresh;
+
+    if (self == NULL || power == NULL || mask_ns == NULL)
+        return -1;
+
+    q = &self->ns_param;
+    g_min = q->floor > q->mask_ns_min ? q->floor : q->mask_ns_min;
+    refresh = frame_idx > 0 && (frame_idx % q->refresh_len) == 0;
+
+    if (frame_idx == 0) {
+        for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+            self->Scur[k] = power[k];
+            self->Smin[k] = power[k];
+            self->Stmp[k] = power[k];
+            self->lambda_d[k] = power[k];
+            self->phat[k] = 0.0f;
+            self->mask_smooth[k] = 1.0f;
+        }
+    }
+
+    for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+        float s = q->alpha_s * self->Scur[k] + (1.0f - q->alpha_s) * power[k];
+        float noise, gain, a;
+
+        self->Scur[k] = s;
+        if (refresh) {
+            self->Smin[k] = self->Stmp[k] < s ? self->Stmp[k] : s;
+            self->Stmp[k] = s;
+        } else {
+            if (s < self->Smin[k]) {
+                self->Smin[k] = s;
+            }
+            if (s < self->Stmp[k]) {
+                self->Stmp[k] = s;
+            }
+        }
+        self->vad[k] = s > q->delta * self->Smin[k] ? 1.0f : 0.0f;
+        self->phat[k] = q->alpha_p * self->phat[k] + (1.0f - q->alpha_p) * self->vad[k];
+        self->alpha_d_t[k] = q->alpha_d + (1.0f - q->alpha_d) * self->phat[k];
+        self->lambda_d[k] = self->alpha_d_t[k] * self->lambda_d[k] + (1.0f - self->alpha_d_t[k]) * power[k];
+
+        noise = q->res * self->lambda_d[k];
+        gain = power[k] > NS_MCRA_EPS ? (power[k] - noise) / power[k] : g_min;
+        gain = gain < g_min ? g_min : (gain > 1.0f ? 1.0f : gain);
+        if (mask_nn != NULL && mask_nn[k] < q->mask_nn_th) {
+            gain *= q->mask_nn_I;
+        }
+        self->sub_speech[k] = gain;
+
+        a = self->mask_smooth[k] < gain ? q->a_low : q->a_high;
+        self->mask_smooth[k] = a * self->mask_smooth[k] + (1.0f - a) * gain;
+        mask_ns[k] = self->mask_smooth[k];
+    }
+
+    return 0;
+}
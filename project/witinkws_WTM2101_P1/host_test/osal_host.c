@@ -0,0 +1,42 @@
+// host allocator behind the library's OsalMalloc/OsalFree and the heap's
+// pvPortMalloc/vPortFree, counts the live blocks so a test can check its
+// paths release everything
+
+#include <stdlib.h>
+#include "osal_host.h"
+
+static int osal_live = 0;
+
+void* OsalMalloc(uint32_t size)
+{
+    void* p = malloc(size);
+
+    if (p != NULL) {
+        osal_live++;
+    }
+    return p;
+}
+
+int OsalFree(void *ptr)
+{
+    if (ptr == NULL)
+        return 0;
+    osal_live--;
+    free(ptr);
+    return 1;
+}
+
+void* pvPortMalloc(size_t size)
+{
+    return OsalMalloc((uint32_t)size);
+}
+
+void vPortFree(void *ptr)
+{
+    OsalFree(ptr);
+}
+
+int osal_host_live(void)
+{
+    return osal_live;
+}
@@ -0,0 +1,16 @@
+#ifndef OSAL_HOST_H
+#define OSAL_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+void* OsalMalloc(uint32_t size);
+int OsalFree(void *ptr);
+
+void* pvPortMalloc(size_t size);
+void vPortFree(void *ptr);
+
+// OsalMalloc/pvPortMalloc blocks not yet freed
+int osal_host_live(void);
+
+#endif // OSAL_HOST_H
@@ -0,0 +1,40 @@
+#ifndef NMSIS_CORE_HOST_H
+#define NMSIS_CORE_HOST_H
+
+// host stand-in for the N307 core header. WTM2101.h includes it after the
+// peripheral declarations, so the device headers can be used as they are
+// by modules that only touch the core: the cycle counter, MSTATUS.MIE and
+// WFI are modelled in core_host.c, the peripherals are not.
+
+#include <stdint.h>
+
+typedef unsigned long rv_csr_t;
+
+#define CSR_MSTATUS                 0x300
+#define MSTATUS_MIE                 0x00000008
+
+extern rv_csr_t core_host_csr_read_clear(rv_csr_t val);
+extern void core_host_csr_set(rv_csr_t val);
+
+// only MSTATUS is modelled
+#define __RV_CSR_READ_CLEAR(csr, val)   core_host_csr_read_clear(val)
+#define __RV_CSR_CLEAR(csr, val)        ((void)core_host_csr_read_clear(val))
+#define __RV_CSR_SET(csr, val)          core_host_csr_set(val)
+
+extern void __enable_irq(void);
+extern void __disable_irq(void);
+extern void __WFI(void);
+extern uint64_t __get_rv_cycle(void);
+
+#define __enable_mcycle_counter()
+#define __NOP()
+
+// the compiler macros of nmsis_gcc.h the NMSIS DSP sources use, and the
+// C versions of __SSAT, __CLZ and the rest, __DSP_PRESENT is not set
+#define __ASM                       __asm
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#include "core_compatiable.h"
+
+#endif // NMSIS_CORE_HOST_H
@@ -0,0 +1,10 @@
+#ifndef WTM2101_CONFIG_HOST_H
+#define WTM2101_CONFIG_HOST_H
+
+// host stand-in of the library configuration, only the drivers whose
+// declarations the host tested modules need. core_host.c defines the
+// functions they call
+#include "WTM2101.h"
+#include "rcc.h"
+
+#endif // WTM2101_CONFIG_HOST_H
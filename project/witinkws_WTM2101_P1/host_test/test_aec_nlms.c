@@ -0,0 +1,186 @@
+// host test: a music like far end (tones and noise) is played through a
+// room response of AEC_NLMS_TEST_IR samples into the microphone with a
+// little noise, frames of 400 samples every 160 go through fbank_dual_fft
+// with the reference. it stands in for the FBANK block fft that
+// fbank_aec_calculate uses on the device, same layout and 1/512 scaling:
+//   - the echo return loss enhancement after AEC_NLMS_TEST_CONVERGE_S s
+//     is at least AEC_NLMS_TEST_ERLE_DB
+//   - a near end talker over the music keeps its level within
+//     AEC_NLMS_TEST_NEAR_DB and the echo stays cancelled after it
+//   - a reference at -32768 in both parts of every bin, its power is
+//     2^31, is cancelled like any other
+//   - time per frame
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "aec_nlms.h"
+#include "fbank_dual_fft.h"
+
+#define AEC_NLMS_TEST_RATE          (16000)
+#define AEC_NLMS_TEST_WIN           (400)
+#define AEC_NLMS_TEST_SHIFT         (160)
+#define AEC_NLMS_TEST_IR            (240)       // 15 ms
+#define AEC_NLMS_TEST_SECONDS       (12)
+#define AEC_NLMS_TEST_CONVERGE_S    (3)
+#define AEC_NLMS_TEST_ERLE_DB       (15.0)
+#define AEC_NLMS_TEST_NEAR_DB       (3.0)
+#define AEC_NLMS_TEST_LEN           (AEC_NLMS_TEST_RATE * AEC_NLMS_TEST_SECONDS)
+
+static int16_t test_far[AEC_NLMS_TEST_LEN];
+static int16_t test_near[AEC_NLMS_TEST_LEN];
+static int16_t test_mic[AEC_NLMS_TEST_LEN];
+static double test_ir[AEC_NLMS_TEST_IR];
+static int16_t test_window[AEC_NLMS_TEST_WIN];
+static aec_nlms_t test_aec;
+static uint32_t test_seed = 7;
+
+static double test_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double test_noise(void)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return ((int32_t)(test_seed >> 8) - (1 << 23)) / (double)(1 << 23);
+}
+
+static void test_signals(void)
+{
+    static const double notes[4] = { 220.0, 330.0, 440.0, 587.0 };
+    double e = 1.0;
+
+    for (int i = 0; i < AEC_NLMS_TEST_IR; i++, e *= 0.985) {
+        test_ir[i] = (i == 24 ? 0.6 : 0.0) + 0.25 * e * test_noise();
+    }
+    for (int i = 0; i < AEC_NLMS_TEST_WIN; i++) {
+        test_window[i] = (int16_t)lround(32767.0 * (0.5 - 0.5 * cos(6.283185307179586 * i / AEC_NLMS_TEST_WIN)));
+    }
+
+    for (int n = 0; n < AEC_NLMS_TEST_LEN; n++) {
+        double t = (double)n / AEC_NLMS_TEST_RATE, v = 0.0;
+        int bar = (int)(t * 2.0);
+
+        for (int j = 0; j < 4; j++) {
+            double f = notes[(j + bar) % 4] * (1 + (j & 1));
+
+            v += 2500.0 * sin(6.283185307179586 * fmod(f * t, 1.0));
+        }
+        test_far[n] = (int16_t)lround(v + 1500.0 * test_noise());
+
+        // the near talker, 6.5 to 8 s: a 1.2 kHz buzz with a 4 Hz syllable rate
+        v = 0.0;
+        if (t >= 6.5 && t < 8.0) {
+            v = 4000.0 * fabs(sin(6.283185307179586 * 4.0 * t)) * sin(6.283185307179586 * fmod(1200.0 * t, 1.0));
+        }
+        test_near[n] = (int16_t)lround(v);
+    }
+
+    for (int n = 0; n < AEC_NLMS_TEST_LEN; n++) {
+        double v = test_near[n] + 30.0 * test_noise();
+
+        for (int i = 0; i < AEC_NLMS_TEST_IR && i <= n; i++) {
+            v += test_ir[i] * test_far[n - i];
+        }
+        test_mic[n] = (int16_t)lround(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+static void test_frame(const int16_t *x, int16_t *frame)
+{
+    memset(frame, 0, FBANK_DUAL_FFT_N * sizeof(int16_t));
+    for (int i = 0; i < AEC_NLMS_TEST_WIN; i++) {
+        frame[i] = (int16_t)(((int32_t)x[i] * test_window[i]) >> 15);
+    }
+}
+
+static double test_db(double num, double den)
+{
+    return 10.0 * log10((num + 1e-9) / (den + 1e-9));
+}
+
+// mic = ref, all bins at the corner of the int16 range
+static int test_full_scale(void)
+{
+    static int32_t mic[FBANK_DUAL_FFT_N], ref[FBANK_DUAL_FFT_N];
+    static aec_nlms_t aec;
+    uint64_t in_energy, out_energy;
+
+    aec_nlms_init(&aec, 4, 128);
+    for (int f = 0; f < 50; f++) {
+        for (int k = 0; k < 2 * 128; k++) {
+            ref[k] = -32768;
+            mic[k] = -32768;
+        }
+        aec_nlms_process(&aec, mic, ref, 1);
+        aec_nlms_take_energy(&aec, &in_energy, &out_energy);
+    }
+    printf("full scale reference: %.1f dB\n", test_db((double)in_energy, (double)out_energy));
+    return test_db((double)in_energy, (double)out_energy) < AEC_NLMS_TEST_ERLE_DB;
+}
+
+int main(void)
+{
+    static int16_t mic[FBANK_DUAL_FFT_N], ref[FBANK_DUAL_FFT_N], near[FBANK_DUAL_FFT_N];
+    static int32_t spec_mic[FBANK_DUAL_FFT_N], spec_ref[FBANK_DUAL_FFT_N], spec_near[FBANK_DUAL_FFT_N];
+    int frames = (AEC_NLMS_TEST_LEN - AEC_NLMS_TEST_WIN) / AEC_NLMS_TEST_SHIFT;
+    int bins = 128;
+    double echo_in = 0, echo_out = 0, after_in = 0, after_out = 0, near_ref = 0, near_out = 0;
+    double t_aec = 0;
+    int fail = 0;
+
+    test_signals();
+    aec_nlms_init(&test_aec, 4, bins);
+
+    for (int f = 0; f < frames; f++) {
+        double t = (double)(f * AEC_NLMS_TEST_SHIFT + AEC_NLMS_TEST_WIN) / AEC_NLMS_TEST_RATE;
+        double e_in = 0, e_out = 0, e_near = 0;
+        double t0;
+
+        test_frame(test_mic + f * AEC_NLMS_TEST_SHIFT, mic);
+        test_frame(test_far + f * AEC_NLMS_TEST_SHIFT, ref);
+        test_frame(test_near + f * AEC_NLMS_TEST_SHIFT, near);
+        fbank_dual_fft(mic, ref, spec_mic, spec_ref);
+        fbank_dual_fft_single(near, spec_near);
+
+        for (int k = 0; k < bins; k++) {
+            e_in += (double)spec_mic[2 * k] * spec_mic[2 * k] + (double)spec_mic[2 * k + 1] * spec_mic[2 * k + 1];
+        }
+        t0 = test_now();
+        aec_nlms_process(&test_aec, spec_mic, spec_ref, 1);
+        t_aec += test_now() - t0;
+        for (int k = 0; k < bins; k++) {
+            e_out += (double)spec_mic[2 * k] * spec_mic[2 * k] + (double)spec_mic[2 * k + 1] * spec_mic[2 * k + 1];
+            e_near += (double)spec_near[2 * k] * spec_near[2 * k] + (double)spec_near[2 * k + 1] * spec_near[2 * k + 1];
+        }
+
+        if (t >= AEC_NLMS_TEST_CONVERGE_S && t < 6.5) {
+            echo_in += e_in;
+            echo_out += e_out;
+        } else if (t >= 7.0 && t < 7.9) {
+            near_ref += e_near;
+            near_out += e_out;
+        } else if (t >= 8.5) {
+            after_in += e_in;
+            after_out += e_out;
+        }
+    }
+
+    printf("erle %.1f dB, near end %+.1f dB, erle after the near end %.1f dB, resets %lu\n",
+           test_db(echo_in, echo_out), test_db(near_out, near_ref), test_db(after_in, after_out),
+           (unsigned long)test_aec.resets);
+    printf("%.2f us per frame (%d bins, %d taps)\n", t_aec * 1e6 / frames, bins, test_aec.taps);
+    fail |= test_db(echo_in, echo_out) < AEC_NLMS_TEST_ERLE_DB;
+    fail |= fabs(test_db(near_out, near_ref)) > AEC_NLMS_TEST_NEAR_DB;
+    fail |= test_db(after_in, after_out) < AEC_NLMS_TEST_ERLE_DB;
+    fail |= test_full_scale();
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
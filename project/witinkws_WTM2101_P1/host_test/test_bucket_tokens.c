@@ -0,0 +1,207 @@
+// host test of the bucket/radix token store against a stable sort of the
+// same candidates:
+//   - every frame keeps exactly the best max_toks weights, ties at the
+//     cutoff go to the earlier tokens, with and without the early prune
+//     of a small capacity
+//   - a weight raised in place (recombination) is kept by the select
+//   - the heap store keeps the same best max_toks weights, a raised
+//     weight is not the next one replaced
+//   - every OsalMalloc block is released again
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bucket_tokens.h"
+#include "osal_host.h"
+
+#define BUCKET_TEST_FRAMES      (300)
+#define BUCKET_TEST_EXPAND      (6)
+
+typedef struct
+{
+    int32_t weight;
+    int16_t id;
+} test_ref_t;
+
+static uint32_t test_seed = 2101;
+
+static int32_t test_rand(void)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return (int32_t)((test_seed >> 8) & 0xFFFF);
+}
+
+// larger weight first, earlier token first among equals
+static int test_cmp_ref(const void* a, const void* b)
+{
+    const test_ref_t* ra = (const test_ref_t*)a;
+    const test_ref_t* rb = (const test_ref_t*)b;
+
+    if (ra->weight != rb->weight)
+        return (ra->weight < rb->weight) - (ra->weight > rb->weight);
+    return ra->id - rb->id;
+}
+
+static int test_cmp_id(const void* a, const void* b)
+{
+    return ((const test_ref_t*)a)->id - ((const test_ref_t*)b)->id;
+}
+
+// larger weight first
+static int test_cmp_wgt(const void* a, const void* b)
+{
+    int32_t wa = ((const test_ref_t*)a)->weight;
+    int32_t wb = ((const test_ref_t*)b)->weight;
+
+    return (wa < wb) - (wa > wb);
+}
+
+// capacity 0 is the heap store, its ties at the cutoff may go to any
+// token, only the kept weights are compared
+static int test_frames(int n, int capacity, int spread)
+{
+    int n_cand = n * BUCKET_TEST_EXPAND;
+    BucketTokens* btk = capacity > 0 ? bucket_tokens_init(n, capacity) : bucket_tokens_init_heap(n);
+    test_ref_t* ref = (test_ref_t*)malloc(n_cand * sizeof(test_ref_t));
+    test_ref_t* got = (test_ref_t*)malloc(n * sizeof(test_ref_t));
+    int bad = 0;
+
+    if (btk == NULL || ref == NULL || got == NULL) {
+        printf("no memory\n");
+        bad = 1;
+        goto out;
+    }
+
+    for (int f = 0; f < BUCKET_TEST_FRAMES; f++) {
+        int kept;
+
+        for (int i = 0; i < n_cand; i++) {
+            TOKEN t;
+
+            memset(&t, 0, sizeof(t));
+            t.weight = -f * 256 - test_rand() % spread;
+            t.id = (int16_t)i;
+            ref[i].weight = t.weight;
+            ref[i].id = t.id;
+            bucket_tokens_append(btk, &t);
+        }
+        kept = bucket_tokens_exchange_to_another(btk);
+
+        qsort(ref, n_cand, sizeof(test_ref_t), test_cmp_ref);
+        qsort(ref, n, sizeof(test_ref_t), capacity > 0 ? test_cmp_id : test_cmp_wgt);
+        for (int i = 0; i < kept && i < n; i++) {
+            got[i].weight = btk->prev_toks[i].weight;
+            got[i].id = capacity > 0 ? btk->prev_toks[i].id : 0;
+            ref[i].id = capacity > 0 ? ref[i].id : 0;
+        }
+        qsort(got, kept < n ? kept : n, sizeof(test_ref_t), capacity > 0 ? test_cmp_id : test_cmp_wgt);
+        if (kept != n) {
+            bad++;
+            continue;
+        }
+        for (int i = 0; i < n; i++) {
+            if (ref[i].weight != got[i].weight || ref[i].id != got[i].id) {
+                bad++;
+                break;
+            }
+        }
+    }
+    printf("%s tokens %3d, capacity %3d, spread %5d: bad frames %d\n", capacity > 0 ? "bucket" : "heap  ", n,
+           btk->capacity, spread, bad);
+
+out:
+    bucket_tokens_release(btk);
+    free(got);
+    free(ref);
+    return bad;
+}
+
+// a token that starts worst and is raised above all others must survive
+static int test_update(void)
+{
+    BucketTokens* btk = bucket_tokens_init(4, 16);
+    int index = -1;
+    int found = 0;
+
+    for (int i = 0; i < 12; i++) {
+        TOKEN t;
+        int k;
+
+        memset(&t, 0, sizeof(t));
+        t.weight = i == 0 ? -1000 : -i;
+        t.id = (int16_t)i;
+        k = bucket_tokens_append(btk, &t);
+        if (i == 0) {
+            index = k;
+        }
+    }
+    btk->cur_toks[index].weight = 10;
+    bucket_tokens_update(btk, index);
+    bucket_tokens_select(btk);
+    for (int i = 0; i < btk->cur_toks_cnt; i++) {
+        found |= btk->cur_toks[i].id == 0 && btk->cur_toks[i].weight == 10;
+    }
+    printf("recombination: %s\n", found ? "kept" : "lost");
+    bucket_tokens_release(btk);
+    return !found;
+}
+
+// the heap store: a token raised from worst to best must not be the one a
+// better newcomer replaces, the newcomers take the other three places
+static int test_heap_update(void)
+{
+    BucketTokens* btk = bucket_tokens_init_heap(4);
+    int index = -1;
+    int found = 0;
+
+    for (int i = 0; i < 12; i++) {
+        TOKEN t;
+        int k;
+
+        memset(&t, 0, sizeof(t));
+        t.weight = i < 4 ? -1000 * (i == 0) - i : 5;
+        t.id = (int16_t)i;
+        k = bucket_tokens_append(btk, &t);
+        if (i == 0) {
+            index = k;
+        }
+        if (i == 3) {
+            btk->cur_toks[index].weight = 10;
+            bucket_tokens_update(btk, index);
+        }
+    }
+    for (int i = 0; i < btk->cur_toks_cnt; i++) {
+        found += btk->cur_toks[i].id == 0 && btk->cur_toks[i].weight == 10;
+        found += 10 * (btk->cur_toks[i].weight == 5);
+    }
+    printf("heap recombination: %s\n", found == 31 ? "kept" : "lost");
+    bucket_tokens_release(btk);
+    return found != 31;
+}
+
+int main(void)
+{
+    static const int sizes[] = { 20, 50, 100 };
+    int fail = 0;
+
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        int n = sizes[i];
+
+        // no early prune, then a prune every 2n appends
+        fail |= test_frames(n, n * BUCKET_TEST_EXPAND, 2400) != 0;
+        fail |= test_frames(n, 2 * n, 2400) != 0;
+        // few distinct weights, lots of ties at the cutoff
+        fail |= test_frames(n, 2 * n, 7) != 0;
+        fail |= test_frames(n, 0, 2400) != 0;
+        fail |= test_frames(n, 0, 7) != 0;
+    }
+    fail |= test_update();
+    fail |= test_heap_update();
+    if (osal_host_live() != 0) {
+        printf("%d blocks not released\n", osal_host_live());
+        fail = 1;
+    }
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,53 @@
+// host test of the stamped map of byte_map.h:
+//   - a state reads empty until set, then its token index, in this frame
+//   - byte_map_stamped_clear empties every state without touching them
+//   - an index set just before the 16 bit stamp wraps does not come back
+//     when the stamp returns to the same value
+//   - every OsalMalloc block is released again
+
+#include <stdio.h>
+#include "byte_map.h"
+#include "osal_host.h"
+
+#define TEST_STATES             (300)
+
+int main(void)
+{
+    ByteMapStamped* map = byte_map_stamped_init(TEST_STATES);
+    int fail = 0;
+
+    fail |= map == NULL || byte_map_stamped_init(0) != NULL;
+    for (int id = 0; id < TEST_STATES; id++) {
+        fail |= byte_map_stamped_get_index(map, id) != -1;
+    }
+
+    byte_map_stamped_set_index(map, 7, 0);
+    byte_map_stamped_set_index(map, 299, 1234);
+    byte_map_stamped_set_index(map, 7, 42);
+    fail |= byte_map_stamped_get_index(map, 7) != 42;
+    fail |= byte_map_stamped_get_index(map, 299) != 1234;
+    fail |= byte_map_stamped_get_index(map, 8) != -1;
+
+    byte_map_stamped_clear(map);
+    fail |= byte_map_stamped_get_index(map, 7) != -1 || byte_map_stamped_get_index(map, 299) != -1;
+    byte_map_stamped_set_index(map, 8, 3);
+    fail |= byte_map_stamped_get_index(map, 8) != 3;
+
+    // state 9 set in the last frame before the wrap, a full cycle of
+    // frames later the stamp is the same again
+    while (map->stamp != 0xFFFF) {
+        byte_map_stamped_clear(map);
+    }
+    byte_map_stamped_set_index(map, 9, 5);
+    for (int f = 0; f < 0xFFFF; f++) {
+        byte_map_stamped_clear(map);
+        fail |= byte_map_stamped_get_index(map, 9) != -1;
+    }
+    fail |= map->stamp != 0xFFFF;
+
+    byte_map_stamped_release(map);
+    fail |= osal_host_live() != 0;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,136 @@
+// host test with 1 kHz tones of a far (-36 dBFS) and a near (-6 dBFS)
+// talker over -60 dBFS noise:
+//   - both end up at the target within DIGITAL_AGC_TEST_TOL_DB
+//   - the noise alone does not pull the gain up
+//   - a +33 dB step never takes the output over the limit
+//   - with analog steering a -48 dBFS talker moves the pga up and still
+//     reaches the target
+//   - time per 10 ms block
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "digital_agc.h"
+
+#define DIGITAL_AGC_TEST_RATE       (16000)
+#define DIGITAL_AGC_TEST_BLOCK      (160)
+#define DIGITAL_AGC_TEST_TOL_DB     (2.0)
+#define DIGITAL_AGC_TEST_BENCH      (20000)
+#define DIGITAL_AGC_TEST_BENCH_BLOCKS (400)
+
+static digital_agc_t test_agc;
+static int16_t test_bench[DIGITAL_AGC_TEST_BENCH_BLOCKS][DIGITAL_AGC_TEST_BLOCK];
+static uint32_t test_seed = 1;
+static int test_code = 32;                      // analog code of the simulated pga
+
+static double test_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static double test_noise(void)
+{
+    test_seed = test_seed * 1664525u + 1013904223u;
+    return ((int32_t)(test_seed >> 8) - (1 << 23)) / (double)(1 << 23);
+}
+
+// one block of a 1 kHz tone at level_db (0 is off) over -60 dBFS noise,
+// scaled by the analog gain against code 32
+static void test_block(int16_t *pcm, uint32_t *t, double level_db)
+{
+    double ana = pow(10.0, (test_code - 32) * 0.75 / 20.0);
+    double amp = level_db < 0 ? 32768.0 * pow(10.0, level_db / 20.0) : 0.0;
+
+    for (int i = 0; i < DIGITAL_AGC_TEST_BLOCK; i++, (*t)++) {
+        double v = amp * sin(6.283185307179586 * fmod(1000.0 * *t / DIGITAL_AGC_TEST_RATE, 1.0));
+
+        v = (v + 32.8 * test_noise()) * ana;
+        pcm[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : lround(v)));
+    }
+}
+
+static int test_ana_set(int code)
+{
+    test_code = code;
+    return 0;
+}
+
+// runs seconds of a level through the agc, the output peak of the last
+// half in dBFS, *over is set when a sample passed the limit
+static double test_run(double seconds, double level_db, int *over)
+{
+    int16_t pcm[DIGITAL_AGC_TEST_BLOCK];
+    static uint32_t t = 0;
+    int blocks = (int)(seconds * DIGITAL_AGC_TEST_RATE / DIGITAL_AGC_TEST_BLOCK);
+    int32_t peak = 0;
+
+    for (int b = 0; b < blocks; b++) {
+        test_block(pcm, &t, level_db);
+        digital_agc_process(&test_agc, pcm, pcm);
+        for (int i = 0; i < DIGITAL_AGC_TEST_BLOCK; i++) {
+            int32_t v = abs(pcm[i]);
+
+            if (v > test_agc.limit + test_agc.limit / 1024 + 1) {
+                *over = 1;
+            }
+            if (b >= blocks / 2 && v > peak) {
+                peak = v;
+            }
+        }
+    }
+    return 20.0 * log10((peak + 1) / 32768.0);
+}
+
+int main(void)
+{
+    double target_db = 20.0 * log10(8231 / 32768.0);
+    int16_t pcm[DIGITAL_AGC_TEST_BLOCK];
+    uint32_t t = 0;
+    int over = 0, fail = 0;
+    double far, near, t0, us;
+    int32_t gain;
+
+    digital_agc_init(&test_agc, DIGITAL_AGC_TEST_RATE, DIGITAL_AGC_TEST_BLOCK);
+
+    test_run(3.0, 0.0, &over);
+    printf("noise only: gain %ld/1024\n", (long)test_agc.gain);
+    fail |= test_agc.gain != DIGITAL_AGC_GAIN_ONE;
+
+    far = test_run(6.0, -36.0, &over);
+    gain = test_agc.gain;
+    near = test_run(3.0, -6.0, &over);
+    printf("far -36 dBFS: %.1f dBFS (gain %ld/1024), near -6 dBFS: %.1f dBFS, target %.1f\n",
+           far, (long)gain, near, target_db);
+    fail |= fabs(far - target_db) > DIGITAL_AGC_TEST_TOL_DB || fabs(near - target_db) > DIGITAL_AGC_TEST_TOL_DB;
+
+    test_run(6.0, -36.0, &over);
+    test_run(1.0, -3.0, &over);
+    printf("step -36 -> -3 dBFS: %s, limited blocks %lu\n", over ? "over the limit" : "under the limit",
+           (unsigned long)test_agc.limited_blocks);
+    fail |= over;
+
+    digital_agc_init(&test_agc, DIGITAL_AGC_TEST_RATE, DIGITAL_AGC_TEST_BLOCK);
+    digital_agc_set_analog(&test_agc, test_ana_set, 32, 28, 52, DIGITAL_AGC_TEST_RATE);
+    far = test_run(30.0, -48.0, &over);
+    printf("analog: -48 dBFS at code 32 -> code %d, %.1f dBFS, gain %ld/1024, %lu steps\n",
+           test_code, far, (long)test_agc.gain, (unsigned long)test_agc.ana_steps);
+    fail |= test_code <= 32 || fabs(far - target_db) > DIGITAL_AGC_TEST_TOL_DB || over;
+
+    for (int b = 0; b < DIGITAL_AGC_TEST_BENCH_BLOCKS; b++) {
+        test_block(test_bench[b], &t, (b / 100) % 2 ? -20.0 : -40.0);
+    }
+    t0 = test_now();
+    for (int i = 0; i < DIGITAL_AGC_TEST_BENCH; i++) {
+        digital_agc_process(&test_agc, test_bench[i % DIGITAL_AGC_TEST_BENCH_BLOCKS], pcm);
+    }
+    us = (test_now() - t0) * 1e6 / DIGITAL_AGC_TEST_BENCH;
+    printf("%.2f us per %d sample block\n", us, DIGITAL_AGC_TEST_BLOCK);
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,202 @@
+// host test of echo_ref.c on the core_host.c clock. the tx and the rx dma of
+// two instances move blocks of 8 frames at 16 kHz, rx starts 40.25 frames
+// after tx. each dma interrupt comes in up to 1.5 frames late and stamps
+// its position with that late cycle count, the tx one also queues the block
+// 16 frames ahead through the tap. a captured block of 160 frames is read
+// with its reference as soon as it is in:
+//   - every reference sample is the tx frame echo_ref reports for it,
+//     rx_end - offset - delay back, the offset is -40 give or take the
+//     jitter of the first measurement
+//   - the jitter moves no offset
+//   - a tx block that never reaches the tap is one gap, the reference
+//     comes back after it
+//   - an rx block lost by the dma moves the offset once, to within
+//     ECHO_REF_SLACK of the new -48
+//   - MIE is back as the caller had it
+
+#include <stdio.h>
+#include <string.h>
+#include "core_host.h"
+#include "echo_ref.h"
+
+#define TEST_RATE                   (16000)
+#define TEST_CYCLES                 (1536)      // core cycles per frame
+#define TEST_BLOCK                  (8)         // frames per dma block
+#define TEST_AHEAD                  (16)        // frames queued past tx_frames
+#define TEST_RX_START               (40 * TEST_CYCLES + TEST_CYCLES / 4)
+#define TEST_JITTER                 (TEST_CYCLES * 3 / 2)
+#define TEST_DELAY                  (32)
+#define TEST_READ                   (160)
+
+static Hal_I2s_InitTypeDef test_tx, test_rx;
+static uint8_t test_ring[2048];
+static uint64_t test_tx_due, test_rx_due;      // end of the next block
+static uint64_t test_tx_irq_at, test_rx_irq_at;
+static uint32_t test_seed = 1;
+static int test_skip_tx;                        // tx blocks the tap does not see
+static int test_fail;
+
+int hal_i2s_tx_tap_config(Hal_I2s_InitTypeDef *i2s_instance,
+                          void(*tx_tap)(struct Hal_I2s_InitTypeDef *i2s_instance, const void *frames, int count, uint32_t first_frame))
+{
+    i2s_instance->stamp.tx_tap = tx_tap;
+    return 1;
+}
+
+int hal_i2s_stamp_get(Hal_I2s_InitTypeDef *i2s_instance, Hal_I2s_Stamp_Typedef *stamp)
+{
+    *stamp = i2s_instance->stamp;
+    return 1;
+}
+
+// the played sample of tx frame f, never 0
+static int16_t test_sample(uint32_t f)
+{
+    return (int16_t)(f % 30000 + 1);
+}
+
+static uint64_t test_jitter(void)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return (test_seed >> 8) % (TEST_JITTER + 1);
+}
+
+static void test_queue(uint32_t first)
+{
+    int16_t frames[TEST_BLOCK * 2];
+
+    for (int i = 0; i < TEST_BLOCK; i++) {
+        frames[2 * i] = test_sample(first + i);
+        frames[2 * i + 1] = 0;
+    }
+    test_tx.stamp.tx_tap(&test_tx, frames, TEST_BLOCK, first);
+}
+
+static void test_tx_irq(void)
+{
+    test_tx.stamp.tx_frames += TEST_BLOCK;
+    test_tx.stamp.tx_timestamp = __get_rv_cycle();
+    if (test_skip_tx > 0) {
+        test_skip_tx--;
+    } else {
+        test_queue(test_tx.stamp.tx_frames + TEST_AHEAD - TEST_BLOCK);
+    }
+    test_tx_due += TEST_BLOCK * TEST_CYCLES;
+    test_tx_irq_at = test_tx_due + test_jitter();
+}
+
+static void test_rx_irq(void)
+{
+    test_rx.stamp.rx_frames += TEST_BLOCK;
+    test_rx.stamp.rx_timestamp = __get_rv_cycle();
+    test_rx_due += TEST_BLOCK * TEST_CYCLES;
+    test_rx_irq_at = test_rx_due + test_jitter();
+}
+
+// the next captured block and its reference, returns the played frames of
+// it. bad counts the reference samples that are not the tx frame echo_ref
+// reports for them
+static int test_read(uint32_t *bad)
+{
+    static uint32_t rx_read;
+    int16_t ref[TEST_READ];
+    echo_ref_stats_t stats;
+    uint32_t start;
+    int played;
+
+    while (test_rx.stamp.rx_frames < rx_read + TEST_READ) {
+        if (test_tx_irq_at <= test_rx_irq_at) {
+            core_host_advance(test_tx_irq_at - __get_rv_cycle());
+            test_tx_irq();
+        } else {
+            core_host_advance(test_rx_irq_at - __get_rv_cycle());
+            test_rx_irq();
+        }
+    }
+    rx_read += TEST_READ;
+
+    played = echo_ref_read(ref, TEST_READ);
+    test_fail |= core_host_mie() != MSTATUS_MIE;
+    echo_ref_get_stats(&stats);
+    start = rx_read - stats.offset - TEST_DELAY - TEST_READ;
+    for (int i = 0; i < TEST_READ; i++) {
+        *bad += ref[i] != 0 && ref[i] != test_sample(start + i);
+    }
+    return played;
+}
+
+int main(void)
+{
+    echo_ref_stats_t stats;
+    uint32_t bad = 0, silent = 0;
+    int16_t ref[TEST_READ];
+
+    core_host_reset(TEST_CYCLES * TEST_RATE, NULL);
+    test_tx.lrclk_frequency = TEST_RATE;
+    test_tx.width_word = HAL_I2S_16BITS_WIDTH_WORD;
+    test_rx = test_tx;
+    test_fail |= echo_ref_read(ref, TEST_READ) >= 0;
+    test_fail |= echo_ref_init(&test_tx, &test_rx, test_ring, 1000, TEST_DELAY, 0) != -2;
+    test_fail |= echo_ref_init(&test_tx, &test_rx, test_ring, sizeof(test_ring), TEST_DELAY, 0) != 0;
+
+    // the first blocks go out before the first interrupt
+    for (uint32_t f = 0; f < TEST_AHEAD; f += TEST_BLOCK) {
+        test_queue(f);
+    }
+    test_tx_due = TEST_BLOCK * TEST_CYCLES;
+    test_rx_due = TEST_RX_START + TEST_BLOCK * TEST_CYCLES;
+    test_tx_irq_at = test_tx_due + test_jitter();
+    test_rx_irq_at = test_rx_due + test_jitter();
+
+    // jitter only. the first read flushes what came before it, the second
+    // one starts with frames already flushed, all played after that
+    for (int b = 0; b < 200; b++) {
+        int played = test_read(&bad);
+
+        silent += b > 1 && played != TEST_READ;
+    }
+    echo_ref_get_stats(&stats);
+    printf("jitter: offset %ld, realigns %lu, silent blocks %lu, bad samples %lu\n", (long)stats.offset,
+           (unsigned long)stats.realigns, (unsigned long)silent, (unsigned long)bad);
+    test_fail |= stats.offset > -39 || stats.offset < -41;
+    test_fail |= stats.realigns != 0 || stats.gaps != 0 || stats.dropped != 0;
+    test_fail |= silent != 0 || bad != 0;
+
+    // a tx block missed by the tap, the ring is flushed once
+    test_skip_tx = 1;
+    for (int b = 0; b < 4; b++) {
+        test_read(&bad);
+    }
+    silent = 0;
+    for (int b = 0; b < 50; b++) {
+        silent += test_read(&bad) != TEST_READ;
+    }
+    echo_ref_get_stats(&stats);
+    printf("tx gap: offset %ld, gaps %lu, silent blocks %lu, bad samples %lu\n", (long)stats.offset,
+           (unsigned long)stats.gaps, (unsigned long)silent, (unsigned long)bad);
+    test_fail |= stats.gaps != 1 || stats.realigns != 0 || stats.offset > -39 || stats.offset < -41;
+    test_fail |= silent != 0 || bad != 0;
+
+    // the rx dma loses a block, rx is 8 frames further behind
+    test_rx_due += TEST_BLOCK * TEST_CYCLES;
+    test_rx_irq_at += TEST_BLOCK * TEST_CYCLES;
+    silent = 0;
+    for (int b = 0; b < 100; b++) {
+        silent += test_read(&bad) != TEST_READ;
+    }
+    echo_ref_get_stats(&stats);
+    printf("rx drop: offset %ld, realigns %lu, silent blocks %lu, bad samples %lu\n", (long)stats.offset,
+           (unsigned long)stats.realigns, (unsigned long)silent, (unsigned long)bad);
+    test_fail |= stats.realigns != 1 || stats.offset > -48 + ECHO_REF_SLACK || stats.offset < -48 - ECHO_REF_SLACK;
+    test_fail |= silent != 0 || bad != 0;
+
+    // a caller with the interrupts masked keeps them masked
+    __disable_irq();
+    echo_ref_read(ref, TEST_READ);
+    test_fail |= core_host_mie() != 0;
+    __enable_irq();
+
+    echo_ref_print();
+    printf("%s\n", test_fail ? "FAIL" : "PASS");
+    return test_fail;
+}
@@ -0,0 +1,111 @@
+// host test of energy_gate.c at 16 kHz, 160 sample blocks, on the plain C
+// biquad:
+//   - bad sizes are refused, a band above 0.45 fs is cut or refused
+//   - low noise keeps the gate closed
+//   - a 1 kHz tone opens it on its first block (ONSET), the history holds
+//     the last ENERGY_GATE_LOOKBACK blocks in order, the current one last
+//   - after the tone the gate holds for the hangover, then closes
+//   - a noise floor 20 dB up opens it once, the floor follows and the gate
+//     closes again
+//   - the duty counts the open blocks
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "energy_gate.h"
+
+#define TEST_RATE                   (16000)
+#define TEST_BLOCK                  (160)
+
+static energy_gate_t test_gate;
+static int16_t test_pcm[TEST_BLOCK];
+static uint32_t test_seed = 2101;
+static uint32_t test_n;
+
+static int test_noise(int amp)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return (int)((test_seed >> 8) % (uint32_t)(2 * amp + 1)) - amp;
+}
+
+// one block of noise plus a tone, the sample count stamps it
+static int test_push(int noise, int tone_amp, float tone_hz)
+{
+    for (int i = 0; i < TEST_BLOCK; i++, test_n++) {
+        test_pcm[i] = (int16_t)(test_noise(noise) + tone_amp * sinf(6.28318530718f * tone_hz * test_n / TEST_RATE));
+    }
+    return energy_gate_push(&test_gate, test_pcm);
+}
+
+int main(void)
+{
+    int ret, opened = 0, closed_after = -1, onsets = 0, hist_bad = 0;
+    uint32_t first;
+    int fail = 0;
+
+    fail |= energy_gate_init(&test_gate, TEST_RATE, 0) != -1;
+    fail |= energy_gate_init(&test_gate, TEST_RATE, ENERGY_GATE_MAX_BLOCK + 1) != -1;
+    fail |= energy_gate_init(&test_gate, 1000, 10) != -1;
+    fail |= energy_gate_init(&test_gate, 8000, 80) != 0;
+    fail |= energy_gate_init(&test_gate, TEST_RATE, TEST_BLOCK) != 0;
+
+    // quiet
+    for (int b = 0; b < 200; b++) {
+        opened |= test_push(30, 0, 0) != ENERGY_GATE_CLOSED;
+    }
+    fail |= opened || energy_gate_duty(&test_gate) != 0;
+
+    // the tone
+    first = test_n;
+    ret = test_push(30, 3000, 1000);
+    fail |= ret != ENERGY_GATE_ONSET;
+    fail |= energy_gate_history_count(&test_gate) != ENERGY_GATE_LOOKBACK;
+    fail |= memcmp(energy_gate_history(&test_gate, ENERGY_GATE_LOOKBACK - 1), test_pcm, sizeof(test_pcm)) != 0;
+    fail |= energy_gate_history(&test_gate, ENERGY_GATE_LOOKBACK) != NULL || energy_gate_history(&test_gate, -1) != NULL;
+    for (int b = 1; b < 50; b++) {
+        fail |= test_push(30, 3000, 1000) != ENERGY_GATE_OPEN;
+    }
+    // the history is the last blocks of the tone, oldest first
+    for (int i = 0; i < ENERGY_GATE_LOOKBACK; i++) {
+        const int16_t* h = energy_gate_history(&test_gate, i);
+        uint32_t n = first + (50 - ENERGY_GATE_LOOKBACK + i) * TEST_BLOCK;
+        int16_t tone = (int16_t)(3000 * sinf(6.28318530718f * 1000.0f * n / TEST_RATE));
+
+        hist_bad += h == NULL || h[0] < tone - 30 || h[0] > tone + 30;
+    }
+    fail |= hist_bad != 0;
+
+    // quiet again
+    for (int b = 0; b < 100 && closed_after < 0; b++) {
+        if (test_push(30, 0, 0) == ENERGY_GATE_CLOSED) {
+            closed_after = b;
+        }
+    }
+    printf("tone: onset on its first block, closed %d blocks after it, hangover %d\n",
+           closed_after, test_gate.hangover);
+    fail |= closed_after < test_gate.hangover || closed_after > test_gate.hangover + 4;
+    printf("duty %u per mille over %u blocks\n", energy_gate_duty(&test_gate), test_gate.blocks);
+    fail |= energy_gate_duty(&test_gate) != test_gate.open_blocks * 1000 / test_gate.blocks;
+    fail |= test_gate.open_blocks != 50 + (uint32_t)closed_after;
+
+    // the background comes up 20 dB and stays
+    closed_after = -1;
+    for (int b = 0; b < 3000 && closed_after < 0; b++) {
+        ret = test_push(300, 0, 0);
+        onsets += ret == ENERGY_GATE_ONSET;
+        if (onsets && ret == ENERGY_GATE_CLOSED) {
+            closed_after = b;
+        }
+    }
+    printf("noise 20 dB up: %d onsets, closed after %d blocks\n", onsets, closed_after);
+    fail |= onsets != 1 || closed_after < 0;
+    for (int b = 0; b < 200; b++) {
+        fail |= test_push(300, 0, 0) != ENERGY_GATE_CLOSED;
+    }
+
+    energy_gate_reset(&test_gate);
+    fail |= energy_gate_history_count(&test_gate) != 0 || energy_gate_duty(&test_gate) != 0;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,85 @@
+// host test of the fbank_dma.c stage machine:
+//   - the upload and FBANK interrupts in either order start the download
+//     exactly once, from whichever comes second
+//   - the next DMA interrupt finishes, repeated or stray interrupts do
+//     nothing
+//   - a second calculation is refused until the first one has ended
+//   - every sequence of up to 6 interrupts: at most one download and one
+//     finish, finish only after the download
+
+#include <stdio.h>
+#include "fbank_dma_stage.h"
+
+#define TEST_SEQ_LEN                (6)
+
+static int test_fail;
+
+static void test_order(int fbank_first)
+{
+    fbank_dma_stage_t s = {0};
+
+    test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_NONE;
+    test_fail |= fbank_dma_stage_fbank_done(&s) != FBANK_DMA_ACT_NONE;
+
+    test_fail |= fbank_dma_stage_begin(&s) != 0;
+    test_fail |= fbank_dma_stage_begin(&s) >= 0;
+    if (fbank_first) {
+        test_fail |= fbank_dma_stage_fbank_done(&s) != FBANK_DMA_ACT_NONE;
+        test_fail |= fbank_dma_stage_fbank_done(&s) != FBANK_DMA_ACT_NONE;
+        test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_DOWNLOAD;
+    } else {
+        test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_NONE;
+        test_fail |= fbank_dma_stage_fbank_done(&s) != FBANK_DMA_ACT_DOWNLOAD;
+    }
+    test_fail |= fbank_dma_stage_fbank_done(&s) != FBANK_DMA_ACT_NONE;
+    test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_FINISH;
+    test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_NONE;
+    test_fail |= fbank_dma_stage_begin(&s) >= 0;
+    fbank_dma_stage_end(&s);
+    test_fail |= fbank_dma_stage_dma_done(&s) != FBANK_DMA_ACT_NONE;
+    test_fail |= fbank_dma_stage_begin(&s) != 0;
+    test_fail |= !(s.stage == 0 && s.downloading == 0);
+}
+
+// bit i of seq picks the i-th interrupt: 1 DMA, 0 FBANK
+static void test_sequences(void)
+{
+    for (int len = 0; len <= TEST_SEQ_LEN; len++) {
+        for (int seq = 0; seq < (1 << len); seq++) {
+            fbank_dma_stage_t s = {0};
+            int up = 0, fb = 0, download = 0, finish = 0;
+
+            fbank_dma_stage_begin(&s);
+            for (int i = 0; i < len; i++) {
+                fbank_dma_act_t act;
+
+                if (seq & (1 << i)) {
+                    act = fbank_dma_stage_dma_done(&s);
+                    up++;
+                } else {
+                    act = fbank_dma_stage_fbank_done(&s);
+                    fb++;
+                }
+                if (act == FBANK_DMA_ACT_DOWNLOAD) {
+                    test_fail |= !(up >= 1 && fb >= 1 && !download);
+                    download++;
+                } else if (act == FBANK_DMA_ACT_FINISH) {
+                    test_fail |= !(download && !finish && (seq & (1 << i)));
+                    finish++;
+                }
+            }
+            test_fail |= !(download == (up >= 1 && fb >= 1));
+            test_fail |= !(s.running == 1);
+        }
+    }
+}
+
+int main(void)
+{
+    test_order(0);
+    test_order(1);
+    test_sequences();
+
+    printf("%s\n", test_fail ? "FAIL" : "PASS");
+    return test_fail;
+}
@@ -0,0 +1,131 @@
+// host test of fbank_dual_fft, built twice: on the host radix-2 fft and on
+// the device path, riscv_cfft_q15 of the NMSIS DSP sources
+// (PLATFORM_RSIC_V_N307):
+//   - the split against two fbank_dual_fft_single calls on random
+//     channels, they differ by rounding only
+//   - the ramp of the SDK fft example in either channel against the
+//     FBANK block output fft_odata
+//   - random channels against a double DFT scaled by 1/512
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "fbank_dual_fft.h"
+#include "fbank_golden.h"
+
+#define TEST_ROUNDS             (20)
+#define TEST_BOARD_MAX          (6)
+#ifdef PLATFORM_RSIC_V_N307
+// riscv_cfft_q15 truncates the 1/4 of each radix-4 stage, the split and
+// the single fft each carry that
+#define TEST_SPLIT_MAX          (24)
+#define TEST_DFT_MAX            (16.0)
+#else
+#define TEST_SPLIT_MAX          (4)     // one rounding of each half
+#define TEST_DFT_MAX            (4.0)
+#endif
+
+static int16_t test_a[FBANK_DUAL_FFT_N];
+static int16_t test_b[FBANK_DUAL_FFT_N];
+static int32_t test_spec_a[FBANK_DUAL_FFT_N];
+static int32_t test_spec_b[FBANK_DUAL_FFT_N];
+static uint32_t test_seed = 2101;
+
+static void test_random(void)
+{
+    for (int n = 0; n < FBANK_DUAL_FFT_N; n++) {
+        test_seed = test_seed * 1103515245u + 12345u;
+        test_a[n] = n < _WIN_SIZE ? (int16_t)(test_seed >> 16) : 0;
+        test_seed = test_seed * 1103515245u + 12345u;
+        test_b[n] = n < _WIN_SIZE ? (int16_t)(test_seed >> 16) : 0;
+    }
+}
+
+static int32_t test_max_diff(const int32_t* x, const int32_t* y, int32_t max)
+{
+    for (int i = 0; i < FBANK_DUAL_FFT_N; i++) {
+        int32_t d = abs(x[i] - y[i]);
+        if (d > max) {
+            max = d;
+        }
+    }
+    return max;
+}
+
+static int32_t test_split(void)
+{
+    static int32_t ref_a[FBANK_DUAL_FFT_N];
+    static int32_t ref_b[FBANK_DUAL_FFT_N];
+    int32_t max = 0;
+
+    for (int r = 0; r < TEST_ROUNDS; r++) {
+        test_random();
+        fbank_dual_fft(test_a, test_b, test_spec_a, test_spec_b);
+        fbank_dual_fft_single(test_a, ref_a);
+        fbank_dual_fft_single(test_b, ref_b);
+        max = test_max_diff(test_spec_a, ref_a, max);
+        max = test_max_diff(test_spec_b, ref_b, max);
+    }
+    return max;
+}
+
+static int32_t test_board(void)
+{
+    const int32_t* odata = (const int32_t*)fbank_golden_fft_odata;
+    int32_t max;
+
+    for (int n = 0; n < FBANK_DUAL_FFT_N; n++) {
+        test_a[n] = (int16_t)fbank_golden_fft_wdata[n];
+        test_b[n] = 0;
+    }
+    fbank_dual_fft(test_a, test_b, test_spec_a, test_spec_b);
+    max = test_max_diff(test_spec_a, odata, 0);
+    fbank_dual_fft(test_b, test_a, test_spec_a, test_spec_b);
+    return test_max_diff(test_spec_b, odata, max);
+}
+
+static double test_dft_err(const int16_t* x, const int32_t* spec, double max)
+{
+    for (int k = 0; k < FBANK_DUAL_FFT_N / 2; k++) {
+        double re = 0.0, im = 0.0;
+
+        for (int n = 0; n < FBANK_DUAL_FFT_N; n++) {
+            double a = 2.0 * 3.14159265358979323846 * k * n / FBANK_DUAL_FFT_N;
+            re += x[n] * cos(a);
+            im -= x[n] * sin(a);
+        }
+        re = fabs(spec[2 * k] - re / FBANK_DUAL_FFT_N);
+        im = fabs(spec[2 * k + 1] - im / FBANK_DUAL_FFT_N);
+        max = re > max ? re : max;
+        max = im > max ? im : max;
+    }
+    return max;
+}
+
+static double test_dft(void)
+{
+    double max = 0.0;
+
+    for (int r = 0; r < 4; r++) {
+        test_random();
+        fbank_dual_fft(test_a, test_b, test_spec_a, test_spec_b);
+        max = test_dft_err(test_a, test_spec_a, max);
+        max = test_dft_err(test_b, test_spec_b, max);
+    }
+    return max;
+}
+
+int main(void)
+{
+    int32_t split = test_split();
+    int32_t board = test_board();
+    double dft = test_dft();
+    int fail = 0;
+
+    printf("dual fft: split vs single ffts %d, vs fft_odata %d, vs dft %.2f (bound %.0f)\n",
+           (int)split, (int)board, dft, TEST_DFT_MAX);
+    fail |= split > TEST_SPLIT_MAX || board > TEST_BOARD_MAX || dft > TEST_DFT_MAX;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
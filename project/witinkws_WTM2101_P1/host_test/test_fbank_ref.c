@@ -0,0 +1,126 @@
+// host test of the fbank_ref integer model on the host table copy, bit
+// exact against the board vectors of the SDK fft example (fbank_golden.c):
+//   - fbank_ref_fft of the ramp gives fft_odata
+//   - fbank_ref_ifft of ifft_wdata gives ifft_odata
+//   - fbank_ref_calculate of fbank_wdata gives the 40 bytes of fbank_rdata,
+//     fbank_ref_compare finds the frame exact and a corrupted byte in it
+//
+// with arguments it replays a board capture instead:
+//   test_fbank_ref <pcm s16le> <golden u8, 40 bytes per frame>
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "fbank_ref.h"
+#include "fbank_golden.h"
+
+static void* fbank_ref_load(const char* path, uint32_t* size)
+{
+    FILE* fp = fopen(path, "rb");
+    void* buf = NULL;
+    long len;
+
+    if (fp == NULL)
+        return NULL;
+    fseek(fp, 0, SEEK_END);
+    len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (len > 0) {
+        buf = malloc(len);
+        if (buf != NULL && fread(buf, 1, len, fp) != (size_t)len) {
+            free(buf);
+            buf = NULL;
+        }
+    }
+    fclose(fp);
+    *size = (uint32_t)len;
+    return buf;
+}
+
+static int fbank_ref_replay(const char* pcm_path, const char* golden_path)
+{
+    uint32_t pcm_size = 0;
+    uint32_t golden_size = 0;
+    int16_t* pcm;
+    uint8_t* golden;
+    fbank_ref_diff_t diff;
+    int ret;
+
+    pcm = (int16_t*)fbank_ref_load(pcm_path, &pcm_size);
+    golden = (uint8_t*)fbank_ref_load(golden_path, &golden_size);
+    if (pcm == NULL || golden == NULL) {
+        printf("can not read %s or %s\n", pcm_path, golden_path);
+        free(golden);
+        free(pcm);
+        return 2;
+    }
+
+    ret = fbank_ref_compare(pcm, pcm_size / 2, golden, golden_size / _NUM_MEL_BINS, &diff);
+    free(golden);
+    free(pcm);
+    if (ret < 0) {
+        printf("golden has more frames than the pcm: %d\n", ret);
+        return 2;
+    }
+    printf("frames %u, exact %u, diff bytes %u, max diff %u, first bad frame %d\n",
+           diff.frames, diff.exact_frames, diff.diff_bytes, diff.max_abs_diff, diff.first_bad_frame);
+    return ret;
+}
+
+// words of a stage that differ from the board
+static int fbank_ref_test_words(const char* name, const int32_t* out, const uint32_t* golden, int n)
+{
+    int bad = 0;
+
+    for (int i = 0; i < n; i++) {
+        bad += (uint32_t)out[i] != golden[i];
+    }
+    printf("%s: %d of %d words differ\n", name, bad, n);
+    return bad != 0;
+}
+
+static int fbank_ref_test_fbank(void)
+{
+    static int32_t words[_NFFT];
+    static int16_t pcm[_WIN_SIZE];
+    uint8_t golden[_NUM_MEL_BINS];
+    uint32_t feature[FBANK_REF_FEAT_WORDS];
+    fbank_ref_diff_t diff;
+    int fail = 0;
+
+    for (int i = 0; i < _NFFT; i++) {
+        words[i] = (int32_t)fbank_golden_fbank_wdata[i];
+    }
+    fbank_ref_calculate(words, feature);
+    fail |= fbank_ref_test_words("fbank", (const int32_t*)feature, fbank_golden_fbank_rdata, FBANK_REF_FEAT_WORDS);
+
+    // the same frame as pcm through fbank_ref_compare
+    for (int i = 0; i < _WIN_SIZE; i++) {
+        pcm[i] = (int16_t)fbank_golden_fbank_wdata[i];
+    }
+    memcpy(golden, fbank_golden_fbank_rdata, _NUM_MEL_BINS);
+    fail |= fbank_ref_compare(pcm, _WIN_SIZE, golden, 1, &diff) != 0;
+    golden[5] += 3;
+    fail |= fbank_ref_compare(pcm, _WIN_SIZE, golden, 1, &diff) != 1;
+    fail |= diff.first_bad_frame != 0 || diff.diff_bytes != 1 || diff.max_abs_diff != 3;
+    fail |= fbank_ref_compare(pcm, _WIN_SIZE, golden, 2, &diff) >= 0;
+    return fail;
+}
+
+int main(int argc, char** argv)
+{
+    static int32_t words[_NFFT];
+    int fail = 0;
+
+    if (argc >= 3)
+        return fbank_ref_replay(argv[1], argv[2]);
+
+    fbank_ref_fft((const int32_t*)fbank_golden_fft_wdata, words);
+    fail |= fbank_ref_test_words("fft", words, fbank_golden_fft_odata, _NFFT);
+    fbank_ref_ifft((const int32_t*)fbank_golden_ifft_wdata, words);
+    fail |= fbank_ref_test_words("ifft", words, fbank_golden_ifft_odata, _NFFT);
+    fail |= fbank_ref_test_fbank();
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,65 @@
+// host test of feature_frontend.c against the board frame of the SDK fft
+// example (fbank_golden.c), the FBANK block's own 40 bytes:
+//   - a descriptor generated for 16 kHz, 512 points, 25/10 ms and 40 bins
+//     has the mel ranges of FBANK_FILTERS, and its software path gives the
+//     board bytes to within one step, on the log scale of the block
+//   - feature_frontend_default on the software path does the same
+//   - sizes the generator cannot serve are refused
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "feature_frontend.h"
+#include "fbank_ref.h"
+#include "fbank_golden.h"
+
+// the Q15 window rounds apart from the Q16 povey_win of the block
+#define TEST_MAX_DIFF               (1)
+
+static feature_frontend_t test_fe;
+static feature_frontend_tables_t test_tab;
+static int16_t test_pcm[_NFFT];
+static int32_t test_words[_NFFT];
+
+static int test_board(const char* name, const feature_frontend_t* fe)
+{
+    const uint8_t* golden = (const uint8_t*)fbank_golden_fbank_rdata;
+    uint8_t out[FEATURE_FRONTEND_MAX_MEL];
+    int max = 0, diff = 0;
+
+    feature_frontend_compute(fe, test_pcm, test_words, out);
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        int d = abs(out[m] - golden[m]);
+
+        diff += d != 0;
+        max = d > max ? d : max;
+    }
+    printf("%s: %d of %d bins off the board, by at most %d\n", name, diff, _NUM_MEL_BINS, max);
+    return max > TEST_MAX_DIFF;
+}
+
+int main(void)
+{
+    int ranges = 0;
+    int fail = 0;
+
+    for (int i = 0; i < _NFFT; i++) {
+        test_pcm[i] = (int16_t)fbank_golden_fbank_wdata[i];
+    }
+
+    fail |= feature_frontend_generate(&test_fe, &test_tab, 16000, 512, 25, 10, 40) != 0;
+    fail |= test_fe.win_size != _WIN_SIZE || test_fe.shift_size != _UPDATE_SIZE || test_fe.hw_fbank;
+    for (int m = 0; m < _NUM_MEL_BINS; m++) {
+        ranges += test_fe.filters[m].start != FBANK_FILTERS[m].start || test_fe.filters[m].end != FBANK_FILTERS[m].end;
+    }
+    fail |= ranges != 0;
+    fail |= test_board("generated 16 kHz", &test_fe);
+    fail |= test_board("default", &feature_frontend_default);
+
+    fail |= feature_frontend_generate(&test_fe, &test_tab, 16000, 1024, 25, 10, 40) != -1;
+    fail |= feature_frontend_generate(&test_fe, &test_tab, 8000, 256, 40, 10, 40) != -1;
+    fail |= feature_frontend_generate(&test_fe, &test_tab, 8000, 256, 25, 10, FEATURE_FRONTEND_MAX_MEL + 1) != -1;
+    fail |= feature_frontend_generate(&test_fe, &test_tab, 8000, 256, 25, 10, FEATURE_FRONTEND_MAX_MEL) != 0;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
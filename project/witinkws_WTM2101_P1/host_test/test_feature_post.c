@@ -0,0 +1,153 @@
+// host test of feature_post.c, 40 bins with delta-deltas:
+//   - the first output is input frame 0, outputs lag by feature_post_delay()
+//   - delta and delta-delta of every output, the first ones included, are
+//     the Kaldi sums over the static outputs with frame 0 (and its delta)
+//     repeated before the start
+//   - a constant input gives its mean exactly and a static part of 0
+//   - the running mean: over the first 2^cmvn_shift frames it follows the
+//     cumulative mean only as closely as the power-of-two divide lets it,
+//     after a step it moves 1 - 1/e of the way in 2^cmvn_shift frames and
+//     stops within one feature unit, where the shifted step truncates to 0
+//   - to_pn splits the signs
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "feature_post.h"
+
+#define TEST_BINS                   (40)
+#define TEST_FRAMES                 (200)
+// the mean in feature units within the warm-up, see feature_post.h
+#define TEST_WARMUP_MAX             (12.0)
+
+static feature_post_t test_fp;
+static uint8_t test_in[TEST_FRAMES][TEST_BINS];
+static int8_t test_out[TEST_FRAMES][3 * TEST_BINS];
+static uint32_t test_seed = 2101;
+
+static int test_rand(int n)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return (int)((test_seed >> 8) % (uint32_t)n);
+}
+
+static int8_t test_sat8(int32_t v)
+{
+    return (int8_t)(v > 127 ? 127 : (v < -127 ? -127 : v));
+}
+
+// frame o of x, the frames before 0 repeat frame 0
+static int32_t test_at(const int32_t* x, int o)
+{
+    return x[o < 0 ? 0 : o];
+}
+
+static int32_t test_diff(const int32_t* x, int o)
+{
+    return test_at(x, o + 1) - test_at(x, o - 1) + 2 * (test_at(x, o + 2) - test_at(x, o - 2));
+}
+
+// deltas from the static outputs, n outputs
+static int test_deltas(int n)
+{
+    static int32_t s[TEST_FRAMES], d[TEST_FRAMES];
+    int32_t gain = test_fp.delta_gain;
+    int bad = 0;
+
+    for (int m = 0; m < TEST_BINS; m++) {
+        for (int o = 0; o < n; o++) {
+            s[o] = test_out[o][m];
+        }
+        for (int o = 0; o + 2 < n; o++) {
+            d[o] = test_diff(s, o);
+            bad += test_out[o][TEST_BINS + m] != test_sat8((d[o] * gain) >> 8);
+        }
+        for (int o = 0; o + 4 < n; o++) {
+            bad += test_out[o][2 * TEST_BINS + m] != test_sat8((test_diff(d, o) * gain * gain) >> 16);
+        }
+    }
+    return bad;
+}
+
+// a step from a to b: the mean in feature units after n frames of b
+static double test_step(int a, int b, int n)
+{
+    uint8_t frame[TEST_BINS];
+    int8_t out[3 * TEST_BINS];
+
+    feature_post_reset(&test_fp);
+    memset(frame, a, sizeof(frame));
+    for (int t = 0; t < 4096; t++) {
+        feature_post_process(&test_fp, frame, out);
+    }
+    memset(frame, b, sizeof(frame));
+    for (int t = 0; t < n; t++) {
+        feature_post_process(&test_fp, frame, out);
+    }
+    return test_fp.mean[0] / 256.0;
+}
+
+int main(void)
+{
+    uint8_t frame[TEST_BINS];
+    int8_t out[3 * TEST_BINS];
+    uint8_t pn[2 * TEST_BINS];
+    double sum = 0.0, warmup = 0.0;
+    int n = 0, bad;
+    int fail = 0;
+
+    fail |= feature_post_init(&test_fp, 0, 0) != -1 || feature_post_init(&test_fp, FEATURE_POST_MAX_BINS + 1, 0) != -1;
+    fail |= feature_post_init(&test_fp, TEST_BINS, FEATURE_POST_DELTA2) != 0;
+    fail |= feature_post_delay(&test_fp) != 4 || feature_post_dim(&test_fp) != 3 * TEST_BINS;
+
+    // a slow tone per bin plus noise, the mean tracked against the exact
+    // cumulative one of bin 0
+    for (int t = 0; t < TEST_FRAMES; t++) {
+        for (int m = 0; m < TEST_BINS; m++) {
+            test_in[t][m] = (uint8_t)(128 + 60 * sin(0.05 * t + m) + test_rand(40) - 20);
+        }
+        sum += test_in[t][0];
+        if (feature_post_process(&test_fp, test_in[t], test_out[n]) == 1) {
+            n++;
+        }
+        fail |= n != (t >= 4 ? t - 3 : 0);
+        warmup = fmax(warmup, fabs(test_fp.mean[0] / 256.0 - sum / (t + 1)));
+    }
+    bad = test_deltas(n);
+    printf("deltas: %d outputs, %d values off the Kaldi sums\n", n, bad);
+    fail |= bad != 0;
+    printf("warm-up mean: %.2f off the cumulative mean at most\n", warmup);
+    fail |= warmup > TEST_WARMUP_MAX;
+
+    // a constant input is its own mean
+    feature_post_reset(&test_fp);
+    memset(frame, 100, sizeof(frame));
+    for (int t = 0; t < 20; t++) {
+        if (feature_post_process(&test_fp, frame, out) == 1) {
+            for (int i = 0; i < 3 * TEST_BINS; i++) {
+                fail |= out[i] != 0;
+            }
+        }
+    }
+    fail |= test_fp.mean[0] != 100 << 8 || test_fp.mean[TEST_BINS - 1] != 100 << 8;
+
+    // exponential window of 2^8 frames
+    {
+        double one = (test_step(60, 160, 256) - 60) / 100;
+        double left = 160 - test_step(60, 160, 8 * 256);
+
+        printf("step: %.3f of the way after 256 frames, %.2f units left after 2048\n", one, left);
+        fail |= fabs(one - (1.0 - exp(-1.0))) > 0.02 || left < 0.0 || left > 1.0;
+    }
+
+    feature_post_to_pn(test_out[10], pn, TEST_BINS);
+    for (int m = 0; m < TEST_BINS; m++) {
+        int8_t x = test_out[10][m];
+
+        fail |= pn[m] != (x > 0 ? x : 0) || pn[m + TEST_BINS] != (x < 0 ? -x : 0);
+    }
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,130 @@
+// host test of frame_sched.c on the core_host.c clock, 10 ms frames at
+// 1 MHz. the audio interrupt ticks every period, while the core sleeps in
+// WFI or while a stage works:
+//   - a frame within its period is not late, its idle time is the sleep
+//     up to the tick and its latency runs from the tick
+//   - a frame over its period counts one miss, the tick that came in
+//     meanwhile is pending so no sleep comes before the next frame
+//   - a backlog over FRAME_SCHED_TICK_DEPTH drops the oldest ticks, the
+//     kept ones are measured from their own tick stamps
+//   - a negative stage skips the rest of the frame
+//   - MIE is back as the caller had it after every frame
+
+#include <stdio.h>
+#include "core_host.h"
+#include "frame_sched.h"
+
+#define TEST_HZ                     (1000000)
+#define TEST_PERIOD                 (10000)     // cycles, 10 ms
+
+static uint64_t test_next_tick;
+static uint32_t test_work[2];
+static int test_ret[2];
+static uint32_t test_calls[2];
+
+// move the clock to t, ticking on the way
+static void test_run_to(uint64_t t)
+{
+    while (test_next_tick <= t) {
+        core_host_advance(test_next_tick - __get_rv_cycle());
+        frame_sched_tick();
+        test_next_tick += TEST_PERIOD;
+    }
+    core_host_advance(t - __get_rv_cycle());
+}
+
+// the core sleeps to the next frame interrupt
+static void test_wfi(void)
+{
+    test_run_to(test_next_tick);
+}
+
+static int test_stage(void *arg)
+{
+    int i = (int)(intptr_t)arg;
+
+    test_calls[i]++;
+    test_run_to(__get_rv_cycle() + test_work[i]);
+    return test_ret[i];
+}
+
+static int test_frame(frame_sched_record_t *rec)
+{
+    return frame_sched_log_read(rec, 1) == 1;
+}
+
+int main(void)
+{
+    frame_sched_record_t rec;
+    frame_sched_stats_t stats;
+    uint32_t wfi;
+    int fail = 0;
+
+    core_host_reset(TEST_HZ, test_wfi);
+    test_next_tick = 2000;
+    fail |= frame_sched_init(0) >= 0;
+    fail |= frame_sched_init(TEST_PERIOD * 1000000ull / TEST_HZ) != 0;
+    fail |= frame_sched_add("a", test_stage, (void *)0) != 0;
+    fail |= frame_sched_add("b", test_stage, (void *)1) != 1;
+
+    // within the period: slept 2000 to the tick, 3000 + 4000 of work
+    test_work[0] = 3000;
+    test_work[1] = 4000;
+    fail |= frame_sched_run() != 0;
+    fail |= !test_frame(&rec);
+    fail |= rec.idle_cycles != 2000 || rec.busy_cycles != 7000 || rec.latency_cycles != 7000;
+    fail |= rec.stage_cycles[0] != 3000 || rec.stage_cycles[1] != 4000;
+    fail |= rec.late || rec.backlog != 0;
+    fail |= core_host_mie() != MSTATUS_MIE;
+
+    // tick 1 at 12000, 12000 of work runs over the period and tick 2
+    // comes in at 22000. irqs masked by the caller stay masked
+    test_work[1] = 9000;
+    __disable_irq();
+    fail |= frame_sched_run() != 1;
+    fail |= core_host_mie() != 0;
+    __enable_irq();
+    fail |= !test_frame(&rec);
+    fail |= rec.latency_cycles != 12000 || !rec.late || rec.backlog != 1;
+
+    // tick 2 is pending, no sleep
+    wfi = core_host_wfi_count();
+    test_work[1] = 1000;
+    fail |= frame_sched_run() != 2;
+    fail |= core_host_wfi_count() != wfi;
+    fail |= !test_frame(&rec);
+    fail |= rec.idle_cycles != 0 || rec.late;
+    fail |= rec.latency_cycles != 28000 - 22000;
+
+    // held off over six ticks, 32000 .. 82000. the oldest two are dropped,
+    // the others run at 88000 with no work
+    test_run_to(88000);
+    test_work[0] = 0;
+    test_work[1] = 0;
+    for (int i = 0; i < 4; i++) {
+        uint32_t lat = 88000 - (52000 + i * TEST_PERIOD);
+
+        fail |= frame_sched_run() != 5u + i;
+        fail |= !test_frame(&rec);
+        fail |= rec.latency_cycles != lat || rec.late != (lat > TEST_PERIOD);
+        fail |= rec.backlog != 3 - i;
+    }
+
+    // a negative return skips stage b
+    test_ret[0] = -1;
+    test_calls[1] = 0;
+    fail |= frame_sched_run() != 9;
+    fail |= test_calls[1] != 0;
+    fail |= !test_frame(&rec);
+    fail |= rec.stage_cycles[1] != 0;
+
+    // misses: frame 1 and the held off frames 5, 6 and 7
+    frame_sched_get_stats(&stats);
+    printf("frames %u, misses %u, dropped %u, max latency %u cycles\n",
+           stats.frames, stats.misses, stats.dropped, stats.max_latency_cycles);
+    fail |= stats.frames != 8 || stats.misses != 4 || stats.dropped != 2;
+    fail |= stats.max_latency_cycles != 36000;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,213 @@
+/*
+ * host test of hal_pcm: every kernel is compared with a plain indexed loop
+ * like the one hal_i2s used before, with aligned and misaligned buffers and
+ * odd frame numbers, then both are timed on blocks of HAL_PCM_BENCH_FRAMES
+ * frames. the exit code is 1 for a mismatch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "hal_pcm.h"
+
+#define HAL_PCM_BENCH_FRAMES    320
+#define HAL_PCM_BENCH_LOOPS     2000
+
+static uint64_t hal_pcm_bench_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+#define HAL_PCM_BENCH_UNIT      "ns"
+
+static int32_t bench_src32[HAL_PCM_BENCH_FRAMES * HAL_PCM_MAX_CHANNELS + 2];
+static int16_t bench_src16[HAL_PCM_BENCH_FRAMES * HAL_PCM_MAX_CHANNELS + 2];
+static int16_t bench_ch[2][HAL_PCM_MAX_CHANNELS][HAL_PCM_BENCH_FRAMES + 2];
+static int16_t bench_out[2][HAL_PCM_BENCH_FRAMES * HAL_PCM_MAX_CHANNELS + 2];
+
+static void bench_ref_deinterleave_16(const volatile int16_t *src,int16_t **dst,int channels,int frames)
+{
+    for(int i = 0; i < frames; i++)
+        for(int c = 0; c < channels; c++)
+            if(dst[c])
+                dst[c][i] = src[i * channels + c];
+}
+
+static void bench_ref_deinterleave_32_to_16(const volatile int32_t *src,int16_t **dst,int channels,int frames,int shift)
+{
+    for(int i = 0; i < frames; i++)
+        for(int c = 0; c < channels; c++)
+        {
+            int32_t v = src[i * channels + c] >> shift;
+
+            if(dst[c])
+                dst[c][i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+        }
+}
+
+static void bench_ref_interleave_16(int16_t **src,volatile int16_t *dst,int channels,int frames)
+{
+    for(int i = 0; i < frames; i++)
+        for(int c = 0; c < channels; c++)
+            dst[i * channels + c] = src[c] ? src[c][i] : 0;
+}
+
+static void bench_ref_gain_16(const volatile int16_t *src,int16_t *dst,int samples,int16_t gain_q15,int shift)
+{
+    for(int i = 0; i < samples; i++)
+    {
+        int32_t v = (src[i] == -32768 && gain_q15 == -32768) ? 32767 : (((int32_t)src[i] * gain_q15) >> 15);
+
+        v *= (1 << shift);
+        dst[i] = (int16_t)(v > 32767 ? 32767 : (v < -32768 ? -32768 : v));
+    }
+}
+
+static uint32_t bench_seed = 1;
+
+static int16_t bench_rand16(void)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return (int16_t)(bench_seed >> 16);
+}
+
+static void bench_fill(int ofs,int channels,int16_t **ch0,int16_t **ch1)
+{
+    for(int i = 0; i < HAL_PCM_BENCH_FRAMES * HAL_PCM_MAX_CHANNELS + 2; i++)
+    {
+        bench_src16[i] = bench_rand16();
+        bench_src32[i] = (int32_t)(((uint32_t)(uint16_t)bench_rand16() << 16) | (uint16_t)bench_rand16());
+    }
+    bench_src16[3] = -32768;
+    memset(bench_ch,0,sizeof(bench_ch));
+    memset(bench_out,0,sizeof(bench_out));
+    for(int c = 0; c < channels; c++)
+    {
+        /*channel 1 is skipped to check the NULL entries*/
+        ch0[c] = c == 1 ? NULL : &bench_ch[0][c][ofs];
+        ch1[c] = c == 1 ? NULL : &bench_ch[1][c][ofs];
+    }
+}
+
+static int bench_compare(const char *name,int channels,int ofs,int frames)
+{
+    if(memcmp(bench_ch[0],bench_ch[1],sizeof(bench_ch[0])) || memcmp(bench_out[0],bench_out[1],sizeof(bench_out[0])))
+    {
+        printf("%s %dch offset %d frames %d: mismatch\r\n",name,channels,ofs,frames);
+        return 1;
+    }
+    return 0;
+}
+
+static int bench_check(void)
+{
+    int16_t *ch0[HAL_PCM_MAX_CHANNELS],*ch1[HAL_PCM_MAX_CHANNELS];
+    int errors = 0;
+
+    for(int channels = 2; channels <= 4; channels += 2)
+    {
+        for(int ofs = 0; ofs < 2; ofs++)
+        {
+            for(int frames = 0; frames <= 9; frames++)
+            {
+                bench_fill(ofs,channels,ch0,ch1);
+                hal_pcm_deinterleave_16(bench_src16 + ofs,ch0,channels,frames);
+                bench_ref_deinterleave_16(bench_src16 + ofs,ch1,channels,frames);
+                errors += bench_compare("deinterleave_16",channels,ofs,frames);
+
+                for(int shift = 0; shift <= 20; shift += 4)
+                {
+                    bench_fill(ofs,channels,ch0,ch1);
+                    hal_pcm_deinterleave_32_to_16(bench_src32 + ofs,ch0,channels,frames,shift);
+                    bench_ref_deinterleave_32_to_16(bench_src32 + ofs,ch1,channels,frames,shift);
+                    errors += bench_compare("deinterleave_32_to_16",channels,ofs,frames);
+                }
+
+                bench_fill(0,channels,ch0,ch1);
+                hal_pcm_interleave_16(ch0,bench_out[0] + ofs,channels,frames);
+                bench_ref_interleave_16(ch1,bench_out[1] + ofs,channels,frames);
+                errors += bench_compare("interleave_16",channels,ofs,frames);
+            }
+        }
+    }
+
+    for(int ofs = 0; ofs < 2; ofs++)
+    {
+        for(int shift = 0; shift <= 15; shift += 3)
+        {
+            int16_t gain = shift & 1 ? -32768 : 23170;
+
+            bench_fill(0,2,ch0,ch1);
+            hal_pcm_gain_16(bench_src16 + ofs,bench_out[0] + ofs,33,gain,shift);
+            bench_ref_gain_16(bench_src16 + ofs,bench_out[1] + ofs,33,gain,shift);
+            errors += bench_compare("gain_16",1,ofs,33);
+        }
+    }
+
+    return errors;
+}
+
+static void bench_report(const char *name,int channels,uint64_t ref,uint64_t opt)
+{
+    uint64_t samples = (uint64_t)HAL_PCM_BENCH_LOOPS * HAL_PCM_BENCH_FRAMES * channels;
+
+    printf("%-22s %dch: ref %lu, kernel %lu %s per 1000 samples, x%lu.%02lu\r\n",name,channels,
+           (unsigned long)(ref * 1000 / samples),(unsigned long)(opt * 1000 / samples),HAL_PCM_BENCH_UNIT,
+           (unsigned long)(opt ? ref / opt : 0),(unsigned long)(opt ? ref * 100 / opt % 100 : 0));
+}
+
+int main(void)
+{
+    int16_t *ch0[HAL_PCM_MAX_CHANNELS],*ch1[HAL_PCM_MAX_CHANNELS];
+    uint64_t t0,t1,t2;
+    int errors = bench_check();
+
+    printf("check: %d mismatches\r\n",errors);
+
+    for(int channels = 2; channels <= 4; channels += 2)
+    {
+        bench_fill(0,channels,ch0,ch1);
+        ch0[1] = &bench_ch[0][1][0];
+        ch1[1] = &bench_ch[1][1][0];
+
+        t0 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            bench_ref_deinterleave_16(bench_src16,ch1,channels,HAL_PCM_BENCH_FRAMES);
+        t1 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            hal_pcm_deinterleave_16(bench_src16,ch0,channels,HAL_PCM_BENCH_FRAMES);
+        t2 = hal_pcm_bench_now();
+        bench_report("deinterleave_16",channels,t1 - t0,t2 - t1);
+
+        t0 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            bench_ref_deinterleave_32_to_16(bench_src32,ch1,channels,HAL_PCM_BENCH_FRAMES,16);
+        t1 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            hal_pcm_deinterleave_32_to_16(bench_src32,ch0,channels,HAL_PCM_BENCH_FRAMES,16);
+        t2 = hal_pcm_bench_now();
+        bench_report("deinterleave_32_to_16",channels,t1 - t0,t2 - t1);
+
+        t0 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            bench_ref_interleave_16(ch1,bench_out[1],channels,HAL_PCM_BENCH_FRAMES);
+        t1 = hal_pcm_bench_now();
+        for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+            hal_pcm_interleave_16(ch0,bench_out[0],channels,HAL_PCM_BENCH_FRAMES);
+        t2 = hal_pcm_bench_now();
+        bench_report("interleave_16",channels,t1 - t0,t2 - t1);
+    }
+
+    t0 = hal_pcm_bench_now();
+    for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+        bench_ref_gain_16(bench_src16,bench_out[1],HAL_PCM_BENCH_FRAMES,23170,2);
+    t1 = hal_pcm_bench_now();
+    for(int n = 0; n < HAL_PCM_BENCH_LOOPS; n++)
+        hal_pcm_gain_16(bench_src16,bench_out[0],HAL_PCM_BENCH_FRAMES,23170,2);
+    t2 = hal_pcm_bench_now();
+    bench_report("gain_16",1,t1 - t0,t2 - t1);
+
+    return errors != 0;
+}
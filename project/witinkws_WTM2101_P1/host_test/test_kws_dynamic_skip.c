@@ -0,0 +1,136 @@
+// host test of kws_dynamic_skip.c on a WitinKwsDecodeOneFrame stand-in that
+// records every frame it gets. the silence pdf is index 0, the frame
+// number rides in index 1:
+//   - before the init every frame goes to the decoder alone
+//   - a skip of 2 or 4 is refused, min_skip and max_skip are 1 or 3
+//   - with the defaults frames are decoded one by one through the hangover
+//     and the ramp step to 2, then held back and passed on as groups of 3
+//     with skip3FrameFlag set and their index 0, 1, 2
+//   - speech flushes the held back frames one by one before its own
+//   - min_skip 3 groups right after the hangover
+//   - every frame reaches the decoder once, in order
+
+#include <stdio.h>
+#include <string.h>
+#include "lib_witin_kws/lib_witin_kws.h"
+#include "osal_host.h"
+
+#define TEST_DIM                    (4)
+#define TEST_MAX_FRAMES             (128)
+
+typedef struct {
+    int frame;
+    int flag;
+    int index;
+} test_call_t;
+
+static test_call_t test_calls[TEST_MAX_FRAMES];
+static int test_num_calls;
+
+int32_t WitinKwsGetNnetOutDimension(void)
+{
+    return TEST_DIM;
+}
+
+void WitinKwsDecodeOneFrame(int8_t* nnet_out, int skip3FrameFlag, int skipFrameIndex)
+{
+    test_calls[test_num_calls].frame = nnet_out[1];
+    test_calls[test_num_calls].flag = skip3FrameFlag;
+    test_calls[test_num_calls].index = skipFrameIndex;
+    test_num_calls++;
+}
+
+// silence: the silence logit far above the rest, a flat energy
+static int test_frame(int f, int vad)
+{
+    int8_t out[TEST_DIM] = { 127, (int8_t)f, 0, 0 };
+
+    return WitinKwsDecodeOneFrameDynamic(out, vad, 1000);
+}
+
+// the calls from first on are frames first, first + 1, ... in order
+static int test_in_order(int first, int frame)
+{
+    for (int i = first; i < test_num_calls; i++) {
+        if (test_calls[i].frame != frame++)
+            return 0;
+    }
+    return 1;
+}
+
+static WitinKwsSkipConfig test_cfg(int min_skip, int max_skip)
+{
+    WitinKwsSkipConfig cfg;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.min_skip = (int8_t)min_skip;
+    cfg.max_skip = (int8_t)max_skip;
+    cfg.sil_margin = 8;
+    cfg.hangover_frms = 2;
+    cfg.ramp_frms = 25;
+    cfg.energy_margin = 200;
+    return cfg;
+}
+
+int main(void)
+{
+    WitinKwsSkipConfig cfg;
+    int dense = 0, groups = 0, bad_group = 0;
+    int fail = 0;
+
+    fail |= test_frame(0, 0) != 1 || test_num_calls != 1 || test_calls[0].flag != 0;
+
+    cfg = test_cfg(2, 3);
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -2;
+    cfg = test_cfg(1, 2);
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -1;
+    cfg = test_cfg(1, 4);
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -1;
+    cfg = test_cfg(3, 1);
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -2;
+    cfg = test_cfg(1, 3);
+    cfg.ramp_frms = 0;
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -3;
+    cfg = test_cfg(1, 3);
+    cfg.sil_index = TEST_DIM;
+    fail |= WitinKwsDynamicSkipInit(&cfg) != -4;
+
+    // defaults: hangover 30, ramp 25, 3 frames from quiet frame 80 on
+    fail |= WitinKwsDynamicSkipInit(NULL) != 0;
+    test_num_calls = 0;
+    for (int f = 1; f <= 87; f++) {
+        int n = test_frame(f, 0);
+
+        fail |= f < 80 && n != 1;
+        fail |= f >= 80 && n != ((f - 79) % 3 == 0 ? 3 : 0);
+    }
+    for (int i = 0; i < test_num_calls; i++) {
+        if (test_calls[i].flag == 0) {
+            dense++;
+        } else {
+            groups += test_calls[i].index == 0;
+            bad_group += test_calls[i].index != (test_calls[i].frame - 80) % 3;
+        }
+    }
+    printf("defaults: %d frames one by one, %d groups of 3\n", dense, groups);
+    fail |= dense != 79 || groups != 2 || bad_group != 0;
+
+    // frames 86 and 87 are held back, the voice flushes them before 88
+    fail |= test_frame(88, 1) != 3;
+    fail |= test_num_calls != 88 || !test_in_order(0, 1);
+    for (int i = 85; i < 88; i++) {
+        fail |= test_calls[i].flag != 0;
+    }
+
+    // min_skip 3 holds back from the first quiet frame after the hangover
+    cfg = test_cfg(3, 3);
+    fail |= WitinKwsDynamicSkipInit(&cfg) != 0;
+    test_num_calls = 0;
+    fail |= test_frame(1, 0) != 1 || test_frame(2, 0) != 1;
+    fail |= test_frame(3, 0) != 0 || test_frame(4, 0) != 0 || test_frame(5, 0) != 3;
+    fail |= test_num_calls != 5 || !test_in_order(0, 1);
+    fail |= test_calls[2].flag != 1 || test_calls[4].flag != 1 || test_calls[4].index != 2;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
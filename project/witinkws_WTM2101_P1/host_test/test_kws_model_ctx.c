@@ -0,0 +1,211 @@
+// host test of kws_model_ctx.c. the set_kws_fst()/set_kws_acou_model()
+// stand-ins build every model into one shared descriptor and one shared
+// word hash pool, as the library rebuilds them. a small decoder reads
+// cur_fst_modu/cur_acou_model and reports a word found in the hash:
+//   - each context keeps its own word hash after the next model is built
+//   - the build ends on the model that was active, the fst change flag down
+//   - a switch from the get-words callback resets nothing inside the
+//     frame, the next frame decodes on the new model after one reset
+//   - a set_kws_module() from outside is followed on is_fst_changed()
+//   - an unknown id is refused, a second build leaks nothing
+
+#include <stdio.h>
+#include <string.h>
+#include "kws_manager.h"
+#include "HCLG.fst.h"
+#include "acou_model.h"
+#include "kws_decoder.h"
+#include "osal_host.h"
+
+#define TEST_MAX_WORDS              (4)
+
+static const uint8_t test_words[NUM_KWS_MODULES][TEST_MAX_WORDS] = { { 3 }, { 5, 6, 21 } };
+static const int test_num_words[NUM_KWS_MODULES] = { 1, 3 };
+static const int8_t test_word_str[] = "word";
+
+// the library's single model
+static KWS_FST_MODU test_lib_fst;
+static KWS_ACOU_MODU test_lib_acou;
+static kws_word_info_node_t test_lib_nodes[TEST_MAX_WORDS];
+static int test_fst_changed;
+
+static int test_resets;
+static int test_resets_in_frame;
+static int test_in_frame;
+static int test_detected;
+static int test_switch_to = -1;
+
+int32_t CUR_KWS_ID = KWS_ID_WKUP;
+KWS_FST_MODU* cur_fst_modu = NULL;
+KWS_ACOU_MODU* cur_acou_model = NULL;
+
+uint8_t wordHashIndex(uint8_t id)
+{
+    return id & 15;
+}
+
+void set_kws_fst(int id)
+{
+    memset(&test_lib_fst, 0, sizeof(test_lib_fst));
+    test_lib_fst.num_states = (int16_t)(100 + id);
+    cur_fst_modu = &test_lib_fst;
+    test_fst_changed = 1;
+}
+
+// the previous model's nodes are overwritten
+void set_kws_acou_model(int kws_id)
+{
+    memset(&test_lib_acou, 0, sizeof(test_lib_acou));
+    memset(test_lib_nodes, 0xa5, sizeof(test_lib_nodes));
+    test_lib_acou.key_words_str = test_word_str;
+    test_lib_acou.num_key_words = (int16_t)test_num_words[kws_id];
+    for (int i = 0; i < test_num_words[kws_id]; i++) {
+        kws_word_info_node_t* node = &test_lib_nodes[i];
+        kws_wordList_hash_t* list = &test_lib_acou.wordHash[wordHashIndex(test_words[kws_id][i])];
+
+        node->wordPtr = (const uint8_t*)test_word_str;
+        node->wordIndex = test_words[kws_id][i];
+        node->next = NULL;
+        if (list->head == NULL) {
+            list->head = node;
+        } else {
+            list->tail->next = (struct _kws_word_info_node*)node;
+        }
+        list->tail = node;
+    }
+    cur_acou_model = &test_lib_acou;
+}
+
+void set_kws_module(int kws_id)
+{
+    CUR_KWS_ID = kws_id;
+    set_kws_fst(kws_id);
+    set_kws_acou_model(kws_id);
+}
+
+int is_fst_changed(void)
+{
+    return test_fst_changed;
+}
+
+void clear_fst_changed_flag(void)
+{
+    test_fst_changed = 0;
+}
+
+void decode_reset(void)
+{
+    test_resets++;
+    test_resets_in_frame += test_in_frame;
+}
+
+static int test_has_word(const KWS_ACOU_MODU* acou, uint8_t word)
+{
+    const kws_word_info_node_t* p = acou->wordHash[wordHashIndex(word)].head;
+
+    while (p != NULL) {
+        if (p->wordIndex == word && p->wordPtr == (const uint8_t*)test_word_str)
+            return 1;
+        p = (const kws_word_info_node_t*)p->next;
+    }
+    return 0;
+}
+
+// the get-words callback: the wake word moves on to the commands
+static void test_on_word(uint8_t word)
+{
+    test_detected = word;
+    if (test_switch_to >= 0) {
+        kws_model_ctx_switch(test_switch_to);
+    }
+}
+
+// one frame: the decoder itself resets once on a raised flag, the nnet
+// "output" is the word it ends on
+static void test_decode_one_frame(uint8_t word)
+{
+    test_in_frame = 1;
+    if (is_fst_changed()) {
+        decode_reset();
+        clear_fst_changed_flag();
+    }
+    test_detected = 0;
+    if (test_has_word(cur_acou_model, word)) {
+        test_on_word(word);
+    }
+    test_in_frame = 0;
+}
+
+static int test_ctx_words(int kws_id)
+{
+    const KWS_MODEL_CTX* ctx = kws_model_ctx_get(kws_id);
+    int found = 0;
+
+    for (int w = 0; w < 32; w++) {
+        found += test_has_word(&ctx->acou, (uint8_t)w);
+    }
+    return found;
+}
+
+int main(void)
+{
+    const KWS_MODEL_CTX* wkup;
+    const KWS_MODEL_CTX* cmds;
+    int live;
+    int fail = 0;
+
+    fail |= kws_model_ctx_get(KWS_ID_WKUP) != NULL;
+    fail |= kws_model_ctx_switch(KWS_ID_WKUP) >= 0;
+
+    fail |= kws_model_ctx_init() != 0;
+    live = osal_host_live();
+    wkup = kws_model_ctx_get(KWS_ID_WKUP);
+    cmds = kws_model_ctx_get(KWS_ID_CMDS);
+    printf("contexts: wkup %d words, cmds %d words, %d blocks\n", test_ctx_words(KWS_ID_WKUP),
+           test_ctx_words(KWS_ID_CMDS), live);
+    fail |= test_ctx_words(KWS_ID_WKUP) != 1 || !test_has_word(&wkup->acou, 3);
+    fail |= test_ctx_words(KWS_ID_CMDS) != 3 || !test_has_word(&cmds->acou, 5) || !test_has_word(&cmds->acou, 21);
+    fail |= wkup->fst.num_states != 100 || cmds->fst.num_states != 101;
+    fail |= CUR_KWS_ID != KWS_ID_WKUP || cur_fst_modu != &wkup->fst || cur_acou_model != &wkup->acou;
+    fail |= cur_kws_ctx != wkup || is_fst_changed();
+
+    // the wake word switches from inside the frame, the frame ends on wkup
+    test_switch_to = KWS_ID_CMDS;
+    test_resets = 0;
+    fail |= kws_model_ctx_sync() != 0;
+    test_decode_one_frame(5);
+    fail |= test_detected != 0;
+    test_decode_one_frame(3);
+    fail |= test_detected != 3 || test_resets != 0;
+    fail |= CUR_KWS_ID != KWS_ID_WKUP || cur_fst_modu != &wkup->fst;
+
+    // the next frame decodes on cmds after one reset
+    test_switch_to = -1;
+    fail |= kws_model_ctx_sync() != 1;
+    fail |= CUR_KWS_ID != KWS_ID_CMDS || cur_fst_modu != &cmds->fst || cur_acou_model != &cmds->acou;
+    test_decode_one_frame(3);
+    fail |= test_detected != 0;
+    fail |= kws_model_ctx_sync() != 0;
+    test_decode_one_frame(6);
+    fail |= test_detected != 6;
+    printf("switch in the callback: %d resets, %d inside a frame\n", test_resets, test_resets_in_frame);
+    fail |= test_resets != 1 || test_resets_in_frame != 0;
+
+    // set_kws_module() rebuilds the library's model and raises the flag
+    set_kws_module(KWS_ID_WKUP);
+    fail |= kws_model_ctx_sync() != 1;
+    fail |= cur_fst_modu != &wkup->fst || cur_acou_model != &wkup->acou || is_fst_changed();
+    test_decode_one_frame(3);
+    fail |= test_detected != 3 || test_resets != 2 || test_resets_in_frame != 0;
+
+    fail |= kws_model_ctx_switch(NUM_KWS_MODULES) >= 0 || kws_model_ctx_switch(-1) >= 0;
+    fail |= kws_model_ctx_sync() != 0;
+
+    // a rebuild on cmds frees the old nodes first
+    CUR_KWS_ID = KWS_ID_CMDS;
+    fail |= kws_model_ctx_init() != 0;
+    fail |= osal_host_live() != live || cur_kws_ctx != cmds || test_ctx_words(KWS_ID_WKUP) != 1;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,148 @@
+// host test of the eps closure of kws_multi_decoder on two small graphs,
+// the nnet output goes through as the log-likelihood (LogSoftMax_f stub):
+//   - prune: state 1 appends 6 eps tokens, the 8 token capacity runs out
+//     in the middle and the early prune keeps 2. the rescan after it does
+//     not follow state 1 again, 4 emitting + 6 + 1 eps arcs are counted
+//   - viterbi: state A is expanded at -10, then B reaches it at 0. A is
+//     expanded again, so the keyword behind it ends at score 0 and is
+//     detected above min_score -5, the same on the heap token store
+//   - every OsalMalloc block is released again
+
+#include <stdio.h>
+#include <string.h>
+#include "kws_multi_decoder.h"
+#include "HCLG.fst.h"
+#include "osal_host.h"
+
+// start is not read by the decoder, ilabel 0 is the only pdf
+#define TEST_ARC(to, cost, olabel)      {0, (to), 0, (olabel), (cost)}
+
+// state 0 emits to 1..4, state 1 has 6 eps arcs to 5..10, state 2 one to 11
+static FST_ARC test_prune_arcs[] = {
+    TEST_ARC(1, 0, 0), TEST_ARC(2, 1, 0), TEST_ARC(3, 2, 0), TEST_ARC(4, 3, 0),
+    TEST_ARC(5, 10, 0), TEST_ARC(6, 11, 0), TEST_ARC(7, 12, 0), TEST_ARC(8, 13, 0),
+    TEST_ARC(9, 14, 0), TEST_ARC(10, 15, 0),
+    TEST_ARC(11, 0, 0),
+};
+
+// start_igz, len_igz, start_iez, len_iez
+static STATE_MAP test_prune_map[12] = {
+    {0, 4, 0, 4, 0, 0},
+    {4, 6, 0, 0, 4, 6},
+    {10, 1, 0, 0, 10, 1},
+};
+
+// frame 1: 0 -> S starts the word. frame 2: S -> A at cost 10 and
+// S -> B at 0. eps: A -> C is the word 7, C -> D ends it, B -> A
+enum { TEST_S = 1, TEST_A, TEST_B, TEST_C, TEST_D, TEST_VITERBI_STATES };
+
+static FST_ARC test_viterbi_arcs[] = {
+    TEST_ARC(TEST_S, 0, SIGN_START),
+    TEST_ARC(TEST_A, 10, 0), TEST_ARC(TEST_B, 0, 0),
+    TEST_ARC(TEST_C, 0, 7),
+    TEST_ARC(TEST_A, 0, 0),
+    TEST_ARC(TEST_D, 0, SIGN_END),
+};
+
+static STATE_MAP test_viterbi_map[TEST_VITERBI_STATES] = {
+    {0, 1, 0, 1, 0, 0},
+    {1, 2, 1, 2, 0, 0},     // S
+    {3, 1, 0, 0, 3, 1},     // A
+    {4, 1, 0, 0, 4, 1},     // B
+    {5, 1, 0, 0, 5, 1},     // C
+    {0, 0, 0, 0, 0, 0},     // D
+};
+
+static KWS_MODEL_CTX test_ctx[2];
+static int test_words;
+static int test_word_id;
+static float test_word_score;
+
+KWS_FST_MODU* cur_fst_modu = NULL;
+
+KWS_MODEL_CTX* kws_model_ctx_get(int kws_id)
+{
+    return &test_ctx[kws_id];
+}
+
+int get_start_id(void)
+{
+    return 0;
+}
+
+int32_t WitinKwsGetNnetOutDimension(void)
+{
+    return 1;
+}
+
+void LogSoftMax_f(int8_t* in, float* dst, uint32_t dim, uint8_t rshift)
+{
+    for (uint32_t i = 0; i < dim; i++) {
+        dst[i] = in[i];
+    }
+}
+
+const float* get_logpriors(void)
+{
+    return NULL;
+}
+
+static void test_on_words(int kws_id, const CallBackKeyWordsType* words)
+{
+    test_words++;
+    test_word_id = words->id;
+    test_word_score = words->score;
+}
+
+static void test_fst(KWS_FST_MODU* fst, STATE_MAP* map, int num_states, FST_ARC* arcs, int num_arcs)
+{
+    fst->map = map;
+    fst->arcs = arcs;
+    fst->num_states = (int16_t)num_states;
+    fst->num_arcs = (int16_t)num_arcs;
+}
+
+int main(void)
+{
+    KWS_MULTI_GRAPH_CFG cfg;
+    int8_t nnet = 0;
+    int fail = 0;
+
+    test_fst(&test_ctx[0].fst, test_prune_map, 12, test_prune_arcs, sizeof(test_prune_arcs) / sizeof(FST_ARC));
+    test_fst(&test_ctx[1].fst, test_viterbi_map, TEST_VITERBI_STATES, test_viterbi_arcs,
+             sizeof(test_viterbi_arcs) / sizeof(FST_ARC));
+    kws_multi_set_on_words(test_on_words);
+
+    // 2 tokens, capacity 8
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.kws_id = 0;
+    cfg.max_toks = 2;
+    cfg.share = 1;
+    cfg.min_score = 0;
+    fail |= kws_multi_init(&cfg, 1, 0, 0) != 0;
+    fail |= kws_multi_decode_one_frame(&nnet) != 0;
+    printf("prune in the eps closure: %u arcs\n", kws_multi_get_arcs(0));
+    fail |= kws_multi_get_arcs(0) != 4 + 6 + 1;
+
+    cfg.kws_id = 1;
+    cfg.max_toks = 16;
+    cfg.min_score = -5;
+    fail |= kws_multi_init(&cfg, 1, 0, 0) != 0;
+    fail |= kws_multi_decode_one_frame(&nnet) != 0;
+    fail |= kws_multi_decode_one_frame(&nnet) != 1;
+    printf("improved after its expansion: %d words, id %d, score %.3f\n", test_words, test_word_id, test_word_score);
+    fail |= test_words != 1 || test_word_id != 7 || test_word_score != 0.0f;
+
+    cfg.heap_toks = 1;
+    fail |= kws_multi_init(&cfg, 1, 0, 0) != 0;
+    fail |= kws_multi_decode_one_frame(&nnet) != 0;
+    fail |= kws_multi_decode_one_frame(&nnet) != 1;
+    printf("on the heap store: %d words, id %d, score %.3f\n", test_words, test_word_id, test_word_score);
+    fail |= test_words != 2 || test_word_id != 7 || test_word_score != 0.0f;
+
+    kws_multi_release();
+    fail |= osal_host_live() != 0;
+
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
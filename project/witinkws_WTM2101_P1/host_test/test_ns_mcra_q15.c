@@ -0,0 +1,149 @@
+// host test: the Q15 MCRA against a float MCRA on the same power frames.
+// a speech decision that flips right at delta * Smin gives a short local
+// difference, so the mean mask error is bounded and single bins above
+// NS_TEST_OUTLIER may make up at most NS_TEST_OUTLIER_SHARE of the bins.
+//
+// the float noise_suppress_mcra_* of Library.a is not in the tree. the
+// ctest runs against noise_suppression_mcra_host.c, the recursion of
+// noise_suppression_mcra_q15.h in float, on synthetic frames: coloured
+// noise with bursts of a harmonic talker. that checks the fixed point
+// against its own algorithm only, not against the library's.
+//
+// with arguments recorded frames are replayed (raw float32,
+// NS_MCRA_MAG_LEN per frame), scale maps the float power to uint32, keep
+// the noise floor well above 1. given masks.f32, the mask_ns the library
+// returned for the same frames with mask_nn all 1 (raw float32 dumped on
+// the device), the Q15 output is compared against those instead:
+//   test_ns_mcra_q15 <power.f32> [power scale, default 1] [mean bound] [masks.f32]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "noise_suppression_mcra.h"
+#include "noise_suppression_mcra_q15.h"
+
+#define NS_TEST_FRAMES          (1200)
+#define NS_TEST_BOUND           (0.005)
+#define NS_TEST_OUTLIER         (0.1f)
+#define NS_TEST_OUTLIER_SHARE   (0.001)
+
+static NsMcraHandle test_f;
+static NsMcraQ15Handle test_q;
+static uint32_t test_seed = 2101;
+
+static double test_uniform(void)
+{
+    test_seed = test_seed * 1103515245u + 12345u;
+    return ((test_seed >> 8) + 0.5) / (double)(1 << 24);
+}
+
+// talker at 200 Hz with its harmonics, on for 1 s of every 3
+static void test_synth(int frame, float *power)
+{
+    int talking = (frame / 100) % 3 == 1;
+
+    for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+        double noise = 20000.0 * (1.0 + 4.0 * exp(-k / 20.0));
+        double p = -log(test_uniform()) * noise;
+        if (talking && k > 0 && k % 3 == 0 && k < 100) {
+            p += 2e6 * exp(-k / 40.0) * (0.5 + test_uniform());
+        }
+        power[k] = (float)p;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    float power_f[NS_MCRA_MAG_LEN];
+    float mask_nn_f[NS_MCRA_MAG_LEN];
+    float mask_f[NS_MCRA_MAG_LEN];
+    uint32_t power_q[NS_MCRA_MAG_LEN];
+    int16_t mask_q[NS_MCRA_MAG_LEN];
+    float scale = argc > 2 ? (float)atof(argv[2]) : 1.0f;
+    double bound = argc > 3 ? atof(argv[3]) : NS_TEST_BOUND;
+    float max_err = 0.0f;
+    double sum_err = 0.0;
+    double mean_err;
+    double outlier_share;
+    long outliers = 0;
+    int frames = 0;
+    FILE *fp = NULL;
+    FILE *ref = NULL;
+    int fail;
+
+    if (argc > 1) {
+        fp = fopen(argv[1], "rb");
+        if (fp == NULL) {
+            printf("cannot open %s\n", argv[1]);
+            return 2;
+        }
+    }
+    if (argc > 4) {
+        ref = fopen(argv[4], "rb");
+        if (ref == NULL) {
+            printf("cannot open %s\n", argv[4]);
+            fclose(fp);
+            return 2;
+        }
+    }
+
+    noise_suppress_mcra_init(&test_f);
+    noise_suppress_mcra_q15_init(&test_q, &test_f.ns_param);
+    for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+        mask_nn_f[k] = 1.0f;
+    }
+
+    for (;;) {
+        if (fp != NULL) {
+            if (fread(power_f, sizeof(float), NS_MCRA_MAG_LEN, fp) != NS_MCRA_MAG_LEN)
+                break;
+        } else {
+            if (frames == NS_TEST_FRAMES)
+                break;
+            test_synth(frames, power_f);
+        }
+        for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+            float v = power_f[k] * scale;
+            power_q[k] = v <= 0.0f ? 0 : (v >= 4294967040.0f ? 0xFFFFFF00u : (uint32_t)v);
+            power_f[k] = (float)power_q[k];
+        }
+        if (ref != NULL) {
+            if (fread(mask_f, sizeof(float), NS_MCRA_MAG_LEN, ref) != NS_MCRA_MAG_LEN)
+                break;
+        } else {
+            noise_suppress_mcra_process(&test_f, power_f, mask_nn_f, frames, mask_f);
+        }
+        noise_suppress_mcra_q15_process(&test_q, power_q, NULL, frames, mask_q);
+
+        for (int k = 0; k < NS_MCRA_MAG_LEN; k++) {
+            float e = fabsf(mask_f[k] - mask_q[k] / 32768.0f);
+            if (e > max_err) {
+                max_err = e;
+            }
+            if (e > NS_TEST_OUTLIER) {
+                outliers++;
+            }
+            sum_err += e;
+        }
+        frames++;
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    if (ref != NULL) {
+        fclose(ref);
+    }
+
+    if (frames == 0) {
+        printf("no frames in %s\n", argv[1]);
+        return 2;
+    }
+    mean_err = sum_err / ((double)frames * NS_MCRA_MAG_LEN);
+    outlier_share = (double)outliers / ((double)frames * NS_MCRA_MAG_LEN);
+    printf("mcra q15 vs %s: %d frames, mean mask error %f (bound %f), max %f, %ld bins above %.2f\n",
+           ref != NULL ? "library masks" : "host float", frames, mean_err, bound, max_err, outliers, NS_TEST_OUTLIER);
+
+    fail = mean_err > bound || outlier_share > NS_TEST_OUTLIER_SHARE;
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
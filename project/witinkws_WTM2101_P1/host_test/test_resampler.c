@@ -0,0 +1,201 @@
+// host test of the 48 -> 16 kHz decimator, its folded 3:1 kernel and the
+// 44.1 -> 16 kHz rational resampler:
+//   - the folded kernel matches the generic one bit for bit
+//   - the rational output does not depend on how the input is cut up
+//   - tones up to 0.4 of 16 kHz keep their level, tones that would alias
+//     into it (from RESAMPLER_TEST_STOP_HZ) come out at least
+//     RESAMPLER_TEST_STOP_DB down
+//   - time per 10 ms of output against real time
+
+#include <math.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "resampler.h"
+
+#define RESAMPLER_TEST_SECONDS      (2)
+#define RESAMPLER_TEST_STOP_DB      (55.0)
+#define RESAMPLER_TEST_PASS_DB      (0.1)
+#define RESAMPLER_TEST_PASS_HZ      (6400.0f)
+#define RESAMPLER_TEST_STOP_HZ      (9700.0f)
+#define RESAMPLER_TEST_BENCH_LOOPS  (50)
+
+static int16_t test_in[48000 * RESAMPLER_TEST_SECONDS];
+static int16_t test_out[16000 * RESAMPLER_TEST_SECONDS + 16];
+static int16_t test_ref[16000 * RESAMPLER_TEST_SECONDS + 16];
+static int16_t test_coeffs[RESAMPLER_RATIONAL_COEFF_LEN(160, RESAMPLER_PHASE_TAPS)];
+static resampler_decim_t test_dec;
+static resampler_rational_t test_rs;
+
+static double test_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static void test_tone(uint32_t rate, float freq, uint32_t num)
+{
+    for (uint32_t i = 0; i < num; i++) {
+        test_in[i] = (int16_t)lround(16384.0 * sin(6.283185307179586 * fmod((double)freq * i / rate, 1.0)));
+    }
+}
+
+// rms of the output after the filter has settled, in dB against the input tone
+static double test_level(const int16_t *out, int count)
+{
+    double sum = 0.0;
+    int skip = count / 4;
+
+    for (int i = skip; i < count; i++) {
+        sum += (double)out[i] * out[i];
+    }
+    sum /= count - skip;
+    return 10.0 * log10(sum / (16384.0 * 16384.0 / 2.0) + 1e-20);
+}
+
+static int test_decim(resampler_decim_t *dec, int num)
+{
+    int count = 0;
+
+    resampler_decim_reset(dec);
+    for (int i = 0; i + dec->block <= num; i += dec->block) {
+        count += resampler_decim_process(dec, test_in + i, test_out + count);
+    }
+    return count;
+}
+
+static int test_rational(resampler_rational_t *rs, int num, uint32_t seed)
+{
+    int count = 0;
+    int i = 0;
+
+    resampler_rational_reset(rs);
+    while (i < num) {
+        int len = 441;
+
+        if (seed != 0) {
+            seed = seed * 1664525u + 1013904223u;
+            len = 1 + (seed >> 8) % RESAMPLER_MAX_BLOCK;
+        }
+        if (len > num - i) {
+            len = num - i;
+        }
+        count += resampler_rational_process(rs, test_in + i, len, test_out + count);
+        i += len;
+    }
+    return count;
+}
+
+// sweeps tones through run() and checks the pass band and the aliasing
+static int test_response(const char *name, uint32_t rate, int (*run)(int), uint32_t num)
+{
+    double pass_min = 0.0, pass_max = -200.0, stop_max = -200.0;
+    float stop_at = 0.0f;
+    int errors = 0;
+
+    for (float f = 100.0f; f < rate * 0.5f; f += 100.0f) {
+        int count;
+        double level;
+
+        if (f > RESAMPLER_TEST_PASS_HZ && f < RESAMPLER_TEST_STOP_HZ)
+            continue;
+        test_tone(rate, f, num);
+        count = run(num);
+        level = test_level(test_out, count);
+        if (f <= RESAMPLER_TEST_PASS_HZ) {
+            pass_min = level < pass_min ? level : pass_min;
+            pass_max = level > pass_max ? level : pass_max;
+        } else if (level > stop_max) {
+            stop_max = level;
+            stop_at = f;
+        }
+    }
+    if (pass_min < -RESAMPLER_TEST_PASS_DB || pass_max > RESAMPLER_TEST_PASS_DB || stop_max > -RESAMPLER_TEST_STOP_DB) {
+        errors++;
+    }
+    printf("%-20s pass band %+.3f .. %+.3f dB, alias %.1f dB at %.0f Hz %s\n", name, pass_min, pass_max,
+           stop_max, stop_at, errors ? "FAIL" : "ok");
+    return errors;
+}
+
+static int test_run_decim(int num)
+{
+    return test_decim(&test_dec, num);
+}
+
+static int test_run_rational(int num)
+{
+    return test_rational(&test_rs, num, 0);
+}
+
+static void test_bench(const char *name, uint32_t rate, int (*run)(int), uint32_t num)
+{
+    double t0 = test_now();
+    double t;
+
+    for (int n = 0; n < RESAMPLER_TEST_BENCH_LOOPS; n++) {
+        run(num);
+    }
+    t = (test_now() - t0) / RESAMPLER_TEST_BENCH_LOOPS;
+    printf("%-20s %.2f us per 10 ms, x%.0f real time\n", name,
+           t * 1e6 / (num * 100.0 / rate), (double)num / rate / t);
+}
+
+int main(void)
+{
+    uint32_t n48 = 48000 * RESAMPLER_TEST_SECONDS;
+    uint32_t n44 = 44100 * RESAMPLER_TEST_SECONDS;
+    uint32_t seed = 7;
+    int errors = 0;
+    int count, ref_count;
+
+    if (resampler_decim_init(&test_dec, 3, 480, NULL, 0) != 0 || !test_dec.fast ||
+        resampler_rational_init(&test_rs, 44100, 16000, 0, test_coeffs, sizeof(test_coeffs) / sizeof(test_coeffs[0])) != 0) {
+        printf("init failed\n");
+        return 2;
+    }
+    printf("3:1 %d taps, 44.1 -> 16 kHz %d/%d, %d taps per phase, %u coefficients\n", test_dec.taps,
+           test_rs.up, test_rs.down, test_rs.taps, (unsigned)RESAMPLER_RATIONAL_COEFF_LEN(test_rs.up, test_rs.taps));
+
+    // folded against generic on full scale noise
+    for (uint32_t i = 0; i < n48; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        test_in[i] = (int16_t)(seed >> 16);
+    }
+    count = test_decim(&test_dec, n48);
+    memcpy(test_ref, test_out, count * sizeof(int16_t));
+    test_dec.fast = 0;
+    test_decim(&test_dec, n48);
+    test_dec.fast = 1;
+    if (memcmp(test_ref, test_out, count * sizeof(int16_t)) != 0) {
+        printf("folded 3:1 differs from the generic decimator\n");
+        errors++;
+    }
+
+    // any cut of the input gives the same output
+    ref_count = test_rational(&test_rs, n44, 0);
+    memcpy(test_ref, test_out, ref_count * sizeof(int16_t));
+    count = test_rational(&test_rs, n44, 12345);
+    if (count != ref_count || memcmp(test_ref, test_out, count * sizeof(int16_t)) != 0) {
+        printf("rational output depends on the block size\n");
+        errors++;
+    }
+    if (ref_count != 16000 * RESAMPLER_TEST_SECONDS) {
+        printf("rational gave %d outputs\n", ref_count);
+        errors++;
+    }
+
+    errors += test_response("48 -> 16 kHz", 48000, test_run_decim, n48);
+    errors += test_response("44.1 -> 16 kHz", 44100, test_run_rational, n44);
+
+    test_bench("3:1 folded", 48000, test_run_decim, n48);
+    test_dec.fast = 0;
+    test_bench("3:1 generic", 48000, test_run_decim, n48);
+    test_dec.fast = 1;
+    test_bench("160/441 rational", 44100, test_run_rational, n44);
+
+    return errors != 0;
+}
@@ -0,0 +1,187 @@
+/*
+ * host stress test: a producer and a consumer thread move a byte counter
+ * through a small ring with random chunk sizes and offsets, half of the
+ * transfers through push/pop and half through peek/commit, and the consumer
+ * checks every byte. before that the init size rules: a given buffer must
+ * be a power of two, a malloced one is rounded up to the next.
+ *
+ *   test_spsc_ring [megabytes] [ring bytes]
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sched.h>
+#include "spsc_ring.h"
+#include "osal_host.h"
+
+static Spsc_Ring stress_ring;
+static uint64_t stress_total;
+
+static uint32_t stress_rand(uint32_t *seed)
+{
+    *seed = *seed * 1664525u + 1013904223u;
+    return *seed >> 8;
+}
+
+static void *stress_producer(void *arg)
+{
+    uint8_t chunk[300];
+    uint32_t seed = 1;
+    uint64_t sent = 0;
+
+    (void)arg;
+    while (sent < stress_total)
+    {
+        uint32_t ofs = stress_rand(&seed) & 0x03;
+        uint32_t len = 1 + stress_rand(&seed) % (sizeof(chunk) - 4);
+
+        if (len > stress_ring.size)
+        {
+            len = stress_ring.size;
+        }
+        if (len > stress_total - sent)
+        {
+            len = (uint32_t)(stress_total - sent);
+        }
+
+        if (stress_rand(&seed) & 0x01)
+        {
+            for (uint32_t i = 0; i < len; i++)
+            {
+                chunk[ofs + i] = (uint8_t)(sent + i);
+            }
+            while (Spsc_Ring_Push(&stress_ring, chunk + ofs, len) == 0)
+            {
+                sched_yield();
+            }
+        }
+        else
+        {
+            Spsc_Ring_Span span;
+            uint32_t n = Spsc_Ring_Write_Peek(&stress_ring, &span);
+
+            if (n == 0)
+            {
+                sched_yield();
+                continue;
+            }
+            if (len > n)
+            {
+                len = n;
+            }
+            for (uint32_t i = 0; i < len; i++)
+            {
+                uint8_t *p = i < span.len[0] ? span.ptr[0] + i : span.ptr[1] + i - span.len[0];
+                *p = (uint8_t)(sent + i);
+            }
+            Spsc_Ring_Write_Commit(&stress_ring, len);
+        }
+        sent += len;
+    }
+    return NULL;
+}
+
+static void *stress_consumer(void *arg)
+{
+    uint8_t chunk[300];
+    uint32_t seed = 2;
+    uint64_t got = 0;
+    uint64_t *errors = (uint64_t *)arg;
+
+    while (got < stress_total)
+    {
+        uint32_t ofs = stress_rand(&seed) & 0x03;
+        uint32_t len = 1 + stress_rand(&seed) % (sizeof(chunk) - 4);
+        uint32_t n;
+
+        if (stress_rand(&seed) & 0x01)
+        {
+            n = Spsc_Ring_Pop(&stress_ring, chunk + ofs, len);
+            for (uint32_t i = 0; i < n; i++)
+            {
+                *errors += chunk[ofs + i] != (uint8_t)(got + i);
+            }
+        }
+        else
+        {
+            Spsc_Ring_Span span;
+
+            n = Spsc_Ring_Read_Peek(&stress_ring, &span);
+            if (n > len)
+            {
+                n = len;
+            }
+            for (uint32_t i = 0; i < n; i++)
+            {
+                const uint8_t *p = i < span.len[0] ? span.ptr[0] + i : span.ptr[1] + i - span.len[0];
+                *errors += *p != (uint8_t)(got + i);
+            }
+            Spsc_Ring_Read_Commit(&stress_ring, n);
+        }
+        if (n == 0)
+        {
+            sched_yield();
+        }
+        got += n;
+    }
+    return NULL;
+}
+
+/* hal_audio_open asks for Buffer_Ram_Length * 8 = 1280 bytes */
+static int stress_init_sizes(void)
+{
+    static uint8_t buffer[1280];
+    Spsc_Ring ring;
+    int fail = 0;
+
+    if (Spsc_Ring_Init(&ring, buffer, sizeof(buffer)) != -1)
+    {
+        printf("a 1280 byte buffer was accepted\n");
+        fail = 1;
+    }
+    if (Spsc_Ring_Init(&ring, NULL, sizeof(buffer)) != 0x01 || ring.size != 2048)
+    {
+        printf("malloced 1280 bytes: size %u, expected 2048\n", ring.size);
+        fail = 1;
+    }
+    Spsc_Ring_Deinit(&ring);
+    if (osal_host_live() != 0)
+    {
+        printf("%d blocks left after deinit\n", osal_host_live());
+        fail = 1;
+    }
+    return fail;
+}
+
+int main(int argc, char **argv)
+{
+    pthread_t producer, consumer;
+    uint64_t errors = 0;
+    uint32_t left;
+    uint32_t size = argc > 2 ? (uint32_t)atoi(argv[2]) : 512;
+
+    if (stress_init_sizes() != 0)
+    {
+        return 1;
+    }
+
+    stress_total = (uint64_t)(argc > 1 ? atoi(argv[1]) : 16) << 20;
+    if (Spsc_Ring_Init(&stress_ring, NULL, size) <= 0)
+    {
+        printf("init failed\n");
+        return 2;
+    }
+
+    pthread_create(&producer, NULL, stress_producer, NULL);
+    pthread_create(&consumer, NULL, stress_consumer, &errors);
+    pthread_join(producer, NULL);
+    pthread_join(consumer, NULL);
+
+    left = Spsc_Ring_Used(&stress_ring);
+    printf("%llu bytes through a %u byte ring, %llu errors, %u left\n",
+           (unsigned long long)stress_total, stress_ring.size, (unsigned long long)errors, left);
+    Spsc_Ring_Deinit(&stress_ring);
+
+    return errors != 0 || left != 0;
+}
@@ -7,6 +7,7 @@ extern uint32_t audio_get_pcm_freq(void);
 extern void audio_start(void);
 extern void audio_stop(void);
 extern void audio_open(void);
+extern int audio_set_analog_gain(int code);
 
 
 #endif
@@ -0,0 +1,38 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FBANK_AEC_H
+#define _FBANK_AEC_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+#include "fbank_config.h"
+#include "aec_nlms.h"
+
+/*
+ * fbank_calculate with the echo taken off between the fft and the mel
+ * stage. the block runs the window and fft of the microphone frame, the
+ * frame it would transform for the features anyway, and of the aligned
+ * reference frame (echo_ref_read). aec_nlms cancels on the microphone
+ * spectrum in place and the block finishes it with sqrt, mel and log.
+ * the features have the fbank_calculate layout, one fft more per frame.
+ */
+
+/**
+* @brief  features of one frame with the echo cancelled
+* @param  aec: from aec_nlms_init
+* @param  mic: _NFFT words of microphone pcm as fbank_calculate takes them, the spectrum is left in it
+* @param  ref: _NFFT words of reference pcm, the spectrum is left in it
+* @param  feature: _NUM_MEL_BINS / 4 words
+* @param  adapt: 0 only cancels, e.g. while the playback is silent
+* @retval 0 success, -1 bad arguments
+*/
+extern int fbank_aec_calculate(aec_nlms_t *aec, uint32_t *mic, uint32_t *ref, uint32_t *feature, int adapt);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -11,6 +11,23 @@ extern "C" {
 
 #define BSP_FFT_INTERRUPT_LEVEL 3
 
+typedef void (*fft_done_callback_t)(void);
+
+extern volatile uint8_t fft_interrupt_flag;
+
+/**
+* @brief  set a callback run from FFT_IRQHandler when the FBANK block finishes
+* @param  callback: NULL to disable
+* @retval void
+*/
+extern void fft_set_done_callback(fft_done_callback_t callback);
+
+/**
+* @brief  sleep until the running fft/ifft/fbank calculation finishes
+* @retval void
+*/
+extern void fft_wait_done(void);
+
 /**
 * @brief  fft calculation
 * @param  data_write: the source data to write into the fft sram
@@ -0,0 +1,75 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FBANK_DMA_H
+#define _FBANK_DMA_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include "fbank_config.h"
+#include "dma.h"
+
+/*
+ * DMA variants of fbank_config.c: one LLP chain uploads the input to the
+ * FBANK sram and starts the block by writing FBANK_CONTROL/FBANK_EN, the
+ * FBANK interrupt launches a second chain that downloads the result.
+ * the CPU copies nothing, completion is reported by callback.
+ *
+ * channels 0..4 are taken by audio, i2s, uart and spi in the shipped
+ * configs, 5 is the free one. override it in the config header if needed.
+ */
+
+#ifndef FBANK_DMA_CHANNEL
+#define FBANK_DMA_CHANNEL           DMA_CHANNEL5
+#endif
+
+#if defined(AUDIO_DMA_CHANNEL) && (FBANK_DMA_CHANNEL == AUDIO_DMA_CHANNEL)
+#error "FBANK_DMA_CHANNEL conflicts with AUDIO_DMA_CHANNEL"
+#endif
+
+typedef void (*fbank_dma_callback_t)(uint32_t *data_read);
+
+/**
+* @brief  fft calculation by DMA
+* @param  data_write: the source data to write into the fft sram, 512 words
+* @param  data_read: the result data to read from the fft sram, 512 words
+* @param  callback: run from the DMA interrupt when data_read is filled,
+*         NULL to sleep until then
+* @retval 0 success, <0 a calculation is still running
+*/
+extern int fft_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+
+/**
+* @brief  ifft calculation by DMA, same as fft_calculate_dma
+*/
+extern int ifft_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+
+/**
+* @brief  fbank calculations by DMA, data_read sizes as the cpu versions
+*/
+extern int fbank_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+extern int fbank_calculate_win_fft_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+extern int fbank_calculate_sqrt_mel_log_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+extern int fbank_calculate_sqrt_mel_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback);
+
+/**
+* @brief  1 while a DMA calculation is running
+*/
+extern int fbank_dma_busy(void);
+
+/**
+* @brief  call from DMA_IRQHandler when the FBANK_DMA_CHANNEL bit of
+*         DMA_Get_Transfer_Interrupt_Status is set
+*/
+extern void fbank_dma_irq_handler(void);
+
+/**
+  * @}
+  */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
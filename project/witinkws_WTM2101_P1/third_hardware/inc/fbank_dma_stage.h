@@ -0,0 +1,104 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FBANK_DMA_STAGE_H
+#define _FBANK_DMA_STAGE_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+
+/*
+ * stage machine of fbank_dma.c, kept free of register accesses so the
+ * host tests can drive it. a calculation goes
+ *
+ *   begin -> (UP_DONE and FBANK_DONE, either order) -> downloading
+ *         -> FINISH -> end
+ *
+ * the upload DMA interrupt and the FBANK interrupt may come in either
+ * order, the second one starts the download. callers run the events with
+ * MIE cleared, the merge is a read-modify-write of the shared stage byte.
+ */
+
+// the two events that must both happen before the download can start
+#define FBANK_DMA_UP_DONE           (0x01)
+#define FBANK_DMA_FBANK_DONE        (0x02)
+
+typedef enum
+{
+    FBANK_DMA_ACT_NONE = 0,         // nothing to do
+    FBANK_DMA_ACT_DOWNLOAD,         // start the download chain
+    FBANK_DMA_ACT_FINISH,           // data_read is filled, report it
+} fbank_dma_act_t;
+
+typedef struct
+{
+    uint8_t running;
+    uint8_t stage;
+    uint8_t downloading;
+} fbank_dma_stage_t;
+
+/**
+* @brief  arm the machine for a new calculation
+* @retval 0 success, <0 a calculation is still running
+*/
+static inline int fbank_dma_stage_begin(fbank_dma_stage_t *s)
+{
+    if (s->running)
+        return -1;
+    s->running = 1;
+    s->stage = 0;
+    s->downloading = 0;
+    return 0;
+}
+
+/**
+* @brief  FBANK interrupt, the result sits in the FBANK sram
+*/
+static inline fbank_dma_act_t fbank_dma_stage_fbank_done(fbank_dma_stage_t *s)
+{
+    if (!s->running || s->downloading || (s->stage & FBANK_DMA_FBANK_DONE))
+        return FBANK_DMA_ACT_NONE;
+    s->stage |= FBANK_DMA_FBANK_DONE;
+    if (s->stage != (FBANK_DMA_UP_DONE | FBANK_DMA_FBANK_DONE))
+        return FBANK_DMA_ACT_NONE;
+    s->downloading = 1;
+    return FBANK_DMA_ACT_DOWNLOAD;
+}
+
+/**
+* @brief  transfer interrupt of the fbank DMA channel, ends the upload chain
+*         or the download chain
+*/
+static inline fbank_dma_act_t fbank_dma_stage_dma_done(fbank_dma_stage_t *s)
+{
+    if (!s->running)
+        return FBANK_DMA_ACT_NONE;
+    if (s->downloading) {
+        s->downloading = 0;
+        return FBANK_DMA_ACT_FINISH;
+    }
+    if (s->stage & FBANK_DMA_UP_DONE)
+        return FBANK_DMA_ACT_NONE;
+    s->stage |= FBANK_DMA_UP_DONE;
+    if (s->stage != (FBANK_DMA_UP_DONE | FBANK_DMA_FBANK_DONE))
+        return FBANK_DMA_ACT_NONE;
+    s->downloading = 1;
+    return FBANK_DMA_ACT_DOWNLOAD;
+}
+
+/**
+* @brief  release the machine once FINISH has been handled, the block clock
+*         is off and the next calculation may begin
+*/
+static inline void fbank_dma_stage_end(fbank_dma_stage_t *s)
+{
+    s->running = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FBANK_FRAME_RING_H
+#define _FBANK_FRAME_RING_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+#include "fbank_config.h"
+#include "feature_tools.h"
+
+/*
+ * 400/160 framing without re-copying the overlap: audio blocks go once
+ * into a power of two sample ring, a frame is a start index into it, and
+ * povey_win_signed is applied while the frame is written into the FBANK
+ * sram. per frame only the 160 new samples are copied.
+ */
+
+#define FBANK_RING_SIZE             (1024)  /*!< samples, power of two */
+#define FBANK_RING_MASK             (FBANK_RING_SIZE - 1)
+
+typedef struct
+{
+    const int16_t *ring;                /*!< FBANK_RING_SIZE samples */
+    uint32_t start;                     /*!< first sample of the window, already masked */
+} fbank_frame_view_t;
+
+/**
+* @brief  drop all samples, the next frame starts at the next pushed sample
+* @retval void
+*/
+extern void fbank_ring_reset(void);
+
+/**
+* @brief  append one audio block
+* @param  pcm: samples, e.g. a DMA block
+* @param  num: samples in pcm
+* @retval samples dropped because the ring was full, 0 normally
+*/
+extern uint32_t fbank_ring_push(const int16_t *pcm, uint32_t num);
+
+/**
+* @brief  frames that can be taken now
+*/
+extern uint32_t fbank_ring_frames(void);
+
+/**
+* @brief  take the next _WIN_SIZE window and advance by _UPDATE_SIZE
+* @param  view: the window, valid until FBANK_RING_SIZE - _WIN_SIZE more
+*         samples are pushed
+* @retval 0 success, -1 no full window yet
+*/
+extern int fbank_ring_get_frame(fbank_frame_view_t *view);
+
+/**
+* @brief  sample i of a window, 0 <= i < _WIN_SIZE
+*/
+static inline int16_t fbank_ring_sample(const fbank_frame_view_t *view, uint32_t i)
+{
+    return view->ring[(view->start + i) & FBANK_RING_MASK];
+}
+
+/**
+* @brief  window the frame into the FBANK sram, zero pad to 512 and start
+*         the fft, as fft_calculate_part1. read the spectrum back with
+*         fft_wait_done and fft_calculate_part2
+* @param  view: from fbank_ring_get_frame
+* @retval void
+*/
+extern void fbank_ring_fft_start(const fbank_frame_view_t *view);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
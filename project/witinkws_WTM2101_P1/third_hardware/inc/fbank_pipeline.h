@@ -0,0 +1,99 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FBANK_PIPELINE_H
+#define _FBANK_PIPELINE_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+#include "fbank_config.h"
+
+/*
+ * three stage frame pipeline on top of fft_calculate_part1/part2:
+ *
+ *   FBANK block : fft of frame N
+ *   CPU         : mel/log of frame N-1
+ *   NPU         : stacked window ending at frame N-2
+ *
+ * the fft and the nnet run in hardware while the CPU works on the frame
+ * between them, so a frame costs about the longest stage instead of the
+ * sum. the nnet is started right after the mel of its last frame and is
+ * only waited for when the next window is due.
+ */
+
+#define FBANK_PIPE_MAX_FEAT_DIM     (64)
+#define FBANK_PIPE_MAX_CONTEXT      (32)
+
+/**
+* @brief  mel/log stage, spectrum is the fft read back of one frame
+*/
+typedef void (*fbank_pipe_mel_func_t)(const uint32_t *spectrum, uint8_t *feature);
+
+/**
+* @brief  start the nnet on num_frames frames (oldest first) and return
+*         while the NPU runs, e.g. wnpu_send_feature() then kick the rounds
+* @note   features stay valid until the matching wait returns
+*/
+typedef void (*fbank_pipe_nnet_start_func_t)(const uint8_t *features, int num_frames);
+
+/**
+* @brief  sleep until the nnet started last has finished and take its
+*         result, e.g. wnpu_wfi_wait() then wnpu_get_infer_result()
+*/
+typedef void (*fbank_pipe_nnet_wait_func_t)(void);
+
+typedef struct
+{
+    fbank_pipe_mel_func_t  mel_log;
+    fbank_pipe_nnet_start_func_t nnet_start;  /*!< NULL: features only */
+    fbank_pipe_nnet_wait_func_t  nnet_wait;   /*!< required with nnet_start */
+    uint16_t feat_dim;                 /*!< bytes per frame feature */
+    uint16_t context;                  /*!< frames stacked per nnet run */
+    uint16_t nnet_step;                /*!< run the nnet every nnet_step frames */
+} fbank_pipe_cfg_t;
+
+typedef struct
+{
+    uint32_t frames;
+    uint64_t fft_wait_cycles;          /*!< cpu time left waiting for the fft */
+    uint64_t io_cycles;                /*!< sram read back and upload */
+    uint64_t mel_cycles;
+    uint64_t nnet_cycles;              /*!< cpu time starting the nnet */
+    uint64_t nnet_wait_cycles;         /*!< cpu time left waiting for the nnet */
+} fbank_pipe_stats_t;
+
+/**
+* @brief  init the pipeline
+* @param  cfg: pipeline config, mel_log is required
+* @retval 0 success, <0 bad config
+*/
+extern int fbank_pipe_init(const fbank_pipe_cfg_t *cfg);
+
+/**
+* @brief  push one windowed fft input frame (512 words, as fft_calculate)
+* @param  fft_in: may be reused as soon as the call returns
+* @retval 1 the nnet was started in this call, 0 otherwise
+*/
+extern int fbank_pipe_push(uint32_t *fft_in);
+
+/**
+* @brief  drain the frame still in the FBANK block and wait for the nnet
+* @retval 1 the nnet was started in this call, 0 otherwise
+*/
+extern int fbank_pipe_flush(void);
+
+/**
+* @brief  latest feature written by the mel/log stage, NULL before the first
+*/
+extern const uint8_t *fbank_pipe_last_feature(void);
+
+extern void fbank_pipe_get_stats(fbank_pipe_stats_t *stats);
+extern void fbank_pipe_print_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,36 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FEATURE_FRONTEND_HW_H
+#define _FEATURE_FRONTEND_HW_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+#include "fbank_config.h"
+#include "feature_frontend.h"
+
+/*
+ * feature_frontend_t on the FBANK block. feature_frontend_default runs the
+ * whole chain in the block as fbank_calculate, a generated descriptor is
+ * windowed on the cpu, goes through the block fft (a 256 point frame zero
+ * padded to 512) and gets its own mel bins and log on the cpu.
+ */
+
+/**
+* @brief  features of one frame
+* @param  fe: feature_frontend_default or from feature_frontend_generate
+* @param  frame: fe->win_size samples
+* @param  words: _NFFT words of scratch
+* @param  out: fe->num_mel_bins bytes
+* @retval 0 success, -1 bad arguments
+*/
+extern int feature_frontend_compute_hw(const feature_frontend_t *fe, const int16_t *frame,
+                                       uint32_t *words, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -414,6 +414,27 @@ void _agc_config(void)
 }
 #endif
 
+// analog mic gain code of the table above, e.g. steered by digital_agc.
+// the hardware AGC owns it when USE_AGC is set
+int audio_set_analog_gain(int code)
+{
+#if defined(USE_AMIC) && !defined(USE_AGC)
+    uint32_t reg;
+
+    if (code < 0 || code > 63)
+        return -1;
+
+    reg = AUD->ANA7CFG;
+    reg &= ~AUDIO_ANA7CFG_CH0_AGC_GAIN_FORCE_O_Msk;
+    reg |= AUDIO_ANA7CFG_CH0_AGC_GAIN_FORCE_O_Msk & ((uint32_t)code << AUDIO_ANA7CFG_CH0_AGC_GAIN_FORCE_O_Pos);
+    AUD->ANA7CFG = reg;
+    return 0;
+#else
+    (void)code;
+    return -2;
+#endif
+}
+
 static void _audio_config(void)
 {
     RCC_Peri_Rst(RCC_AUD_RSTN);
@@ -0,0 +1,17 @@
+#include <stddef.h>
+#include "fbank_aec.h"
+
+int fbank_aec_calculate(aec_nlms_t *aec, uint32_t *mic, uint32_t *ref, uint32_t *feature, int adapt)
+{
+    if (aec == NULL || mic == NULL || ref == NULL || feature == NULL) {
+        return -1;
+    }
+
+    // the split entries of fbank_calculate, the spectra are 1/512 scaled
+    // re/im pairs of bins 0..255 as aec_nlms_process takes them
+    fbank_calculate_win_fft(mic, mic);
+    fbank_calculate_win_fft(ref, ref);
+    aec_nlms_process(aec, (int32_t *)mic, (const int32_t *)ref, adapt);
+    fbank_calculate_sqrt_mel_log(mic, feature);
+    return 0;
+}
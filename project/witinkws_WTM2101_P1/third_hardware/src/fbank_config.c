@@ -4,10 +4,38 @@
 #include "rcc.h"
 
 volatile uint8_t fft_interrupt_flag = 0; 
+static fft_done_callback_t fft_done_callback = NULL;
+
 void FFT_IRQHandler(void)
 {
     FBANK_Clear_Interrupt_Cmd(FBANK,FBANK_INT);
     fft_interrupt_flag = 1;
+    if (fft_done_callback != NULL) {
+        fft_done_callback();
+    }
+}
+
+void fft_set_done_callback(fft_done_callback_t callback)
+{
+    fft_done_callback = callback;
+}
+
+// sleep until the FBANK interrupt instead of spinning, the flag is left
+// set for the *_part2 read back. irqs are masked around the check so the
+// interrupt cannot slip in between the check and the WFI, a pending irq
+// still wakes the core. the caller may be running with irqs masked, so
+// MIE is put back the way it was found.
+void fft_wait_done(void)
+{
+    rv_csr_t mstatus;
+
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    while (!fft_interrupt_flag) {
+        __WFI();
+        __RV_CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+        __RV_CSR_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    }
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
 }
 
 
@@ -69,7 +97,7 @@ void fft_calculate(uint32_t *data_write,uint32_t *data_read)
 
     //t1 = __get_rv_cycle();
 
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
 
     //t2 = __get_rv_cycle();
@@ -158,7 +186,7 @@ void fft_calculate_part1(uint32_t* data_write)
 
 void fft_calculate_part2(uint32_t* data_read)
 {
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
 
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -251,7 +279,7 @@ void ifft_calculate(uint32_t *data_write,uint32_t *data_read)
 
     //t1 = __get_rv_cycle();
 
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
 
     //t2 = __get_rv_cycle();
@@ -340,7 +368,7 @@ void ifft_calculate_part1(uint32_t* data_write)
 
 void ifft_calculate_part2(uint32_t* data_read)
 {
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -394,7 +422,7 @@ void fbank_calculate(uint32_t *data_write,uint32_t *data_read)
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, DISABLE);
     FBANK_Enable_Cmd(FBANK, ENABLE);
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -431,7 +459,7 @@ void fbank_calculate_0516(uint32_t *data_write,uint32_t *data_read)
     PMU_Standby_Mode_Cmd(PMU);
 
     __WFI();
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
         
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -463,7 +491,7 @@ void fbank_calculate_win_fft(uint32_t *data_write,uint32_t *data_read)
     PMU_Standby_Mode_Cmd(PMU);
 
     __WFI();
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -495,7 +523,7 @@ void fbank_calculate_sqrt_mel_log(uint32_t *data_write,uint32_t *data_read)
     FBANK_Enable_Cmd(FBANK, ENABLE);
     PMU_Standby_Mode_Cmd(PMU);
     __WFI();
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -527,7 +555,7 @@ void fbank_calculate_sqrt_mel(uint32_t *data_write,uint32_t *data_read)
     PMU_Standby_Mode_Cmd(PMU);
 
     __WFI();
-    while(!fft_interrupt_flag);
+    fft_wait_done();
     fft_interrupt_flag = 0;
     
     FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <string.h>
+#include "WTM2101.h"
+#include "rcc.h"
+#include "dma.h"
+#include "wtm2101_mmap.h"
+#include "fbank_dma.h"
+#include "fbank_dma_stage.h"
+
+// the DMA block size field is 8 bits wide
+#define FBANK_DMA_BLOCK_WORDS       (128)
+#define FBANK_DMA_SRAM_WORDS        (512)
+#define FBANK_DMA_DATA_LLP          (FBANK_DMA_SRAM_WORDS / FBANK_DMA_BLOCK_WORDS)
+
+// sqrt_mel keeps every other word of the first 80, as FBANK_Read_Sram_Data_CP2
+#define FBANK_DMA_READ_CP2          (0x80000000U)
+
+typedef struct
+{
+    uint32_t ctl;           // FBANK_Ctl_Cmd flags of the calculation
+    uint8_t addr_sel;       // SRAM_ADDR_SEL while uploading
+    uint8_t read_addr_sel;  // SRAM_ADDR_SEL while downloading
+    uint32_t read_words;    // words read back, may carry FBANK_DMA_READ_CP2
+} fbank_dma_op_t;
+
+static const fbank_dma_op_t fbank_dma_op_fft = {
+    DO_RFFT_HCLK | DO_CFFT_HCLK | FFT_ENABLE, 1, 0, 512 };
+static const fbank_dma_op_t fbank_dma_op_ifft = {
+    DO_CFFT_HCLK | DO_BITREVERSE | IFFT_ENABLE, 0, 0, 512 };
+static const fbank_dma_op_t fbank_dma_op_fbank = {
+    DO_CFFT_HCLK | DO_RFFT_HCLK | DO_WINDOW | DO_BITREVERSE | LOG_ENABLE | SQRT_ENABLE | MELFILTER_ENABLE | FFT_ENABLE, 0, 0, 10 };
+static const fbank_dma_op_t fbank_dma_op_win_fft = {
+    DO_CFFT_HCLK | DO_RFFT_HCLK | DO_WINDOW | DO_BITREVERSE | FFT_ENABLE, 0, 0, 512 };
+static const fbank_dma_op_t fbank_dma_op_sqrt_mel_log = {
+    LOG_ENABLE | SQRT_ENABLE | MELFILTER_ENABLE, 0, 0, 10 };
+static const fbank_dma_op_t fbank_dma_op_sqrt_mel = {
+    SQRT_ENABLE | MELFILTER_ENABLE, 0, 0, 80 | FBANK_DMA_READ_CP2 };
+
+// upload: data blocks, FBANK_CONTROL, FBANK_EN
+static DMA_LlpTypeDef fbank_dma_llp_up[FBANK_DMA_DATA_LLP + 2];
+// download: FBANK_CONTROL, data blocks
+static DMA_LlpTypeDef fbank_dma_llp_down[FBANK_DMA_DATA_LLP + 1];
+// register values written by the chains: run ctl, enable, read ctl
+static uint32_t fbank_dma_reg[3];
+static uint32_t fbank_dma_cp2_buf[80];
+
+static volatile fbank_dma_stage_t fbank_dma_stage;
+static volatile uint8_t fbank_dma_done = 0;
+static uint32_t *fbank_dma_read_ptr = NULL;
+static uint32_t fbank_dma_read_words = 0;
+static fbank_dma_callback_t fbank_dma_user_cb = NULL;
+
+// item control words, taken from CTLn after DMA_Init as the other LLP users do
+static uint32_t fbank_dma_ctl_inc;      // incrementing block, chain continues
+static uint32_t fbank_dma_ctl_fixed;    // single register word, chain continues
+
+static void fbank_dma_channel_init(void)
+{
+    DMA_InitTypeDef init;
+
+    memset(&init, 0, sizeof(init));
+    init.llp_src_en           = ENABLE;
+    init.llp_dst_en           = ENABLE;
+    init.direction            = MEM_TO_MEM_FLOW_CTOL_DMA;
+    init.src_msize            = DMA_MSIZE1;
+    init.dst_msize            = DMA_MSIZE1;
+    init.src_addr_type        = DMA_ADDRESS_INCREASE;
+    init.dst_addr_type        = DMA_ADDRESS_INCREASE;
+    init.src_width            = DMA_WIDTH32;
+    init.dst_width            = DMA_WIDTH32;
+    init.src_per              = OTHER_REQ;
+    init.dst_per              = OTHER_REQ;
+    init.src_handshaking_type = DMA_HW_HANDSHAKE;
+    init.dst_handshaking_type = DMA_HW_HANDSHAKE;
+    init.chanel_priority      = DMA_PRIORITY0;
+    init.int_en               = ENABLE;
+    DMA_Init(DMA, FBANK_DMA_CHANNEL, &init);
+}
+
+static void fbank_dma_ctl_cache(void)
+{
+    uint32_t ctl0_cache;
+
+    // let compiler optimize this code.
+    switch (FBANK_DMA_CHANNEL) {
+        case DMA_CHANNEL0:ctl0_cache = (uint32_t)DMA->CTL0; break;
+        case DMA_CHANNEL1:ctl0_cache = (uint32_t)DMA->CTL1; break;
+        case DMA_CHANNEL2:ctl0_cache = (uint32_t)DMA->CTL2; break;
+        case DMA_CHANNEL3:ctl0_cache = (uint32_t)DMA->CTL3; break;
+        case DMA_CHANNEL4:ctl0_cache = (uint32_t)DMA->CTL4; break;
+        default:          ctl0_cache = (uint32_t)DMA->CTL5; break;
+    }
+    // the interrupt is only wanted on the last item of a chain
+    fbank_dma_ctl_inc = ctl0_cache & ~DMAC_CTL0_INT_EN_Msk;
+    fbank_dma_ctl_fixed = (fbank_dma_ctl_inc & ~(DMAC_CTL0_SINC_Msk | DMAC_CTL0_DINC_Msk)) |
+                          (DMA_ADDRESS_NO_CHANGE << DMAC_CTL0_SINC_Pos) |
+                          (DMA_ADDRESS_NO_CHANGE << DMAC_CTL0_DINC_Pos);
+}
+
+// the last item stops the chain and raises the transfer interrupt
+static uint32_t fbank_dma_ctl_last(uint32_t ctl)
+{
+    return (ctl & ~(DMAC_CTL0_LLP_SRC_EN_Msk | DMAC_CTL0_LLP_DST_EN_Msk)) | DMAC_CTL0_INT_EN_Msk;
+}
+
+static void fbank_dma_llp_set(DMA_LlpTypeDef *llp, uint32_t src, uint32_t dst, uint32_t words, uint32_t ctl_low, DMA_LlpTypeDef *next)
+{
+    llp->src          = mmap_to_sys(src);
+    llp->dst          = mmap_to_sys(dst);
+    llp->ctl_reg_high = words;
+    llp->ctl_reg_low  = next ? ctl_low : fbank_dma_ctl_last(ctl_low);
+    llp->llp          = next ? mmap_to_sys((uint32_t)next) : 0;
+}
+
+static int fbank_dma_build_data(DMA_LlpTypeDef *llp, uint32_t src, uint32_t dst, uint32_t words, DMA_LlpTypeDef *next)
+{
+    int n = 0;
+
+    while (words > 0) {
+        uint32_t len = words > FBANK_DMA_BLOCK_WORDS ? FBANK_DMA_BLOCK_WORDS : words;
+        DMA_LlpTypeDef *follow = (words == len) ? next : &llp[n + 1];
+        fbank_dma_llp_set(&llp[n], src, dst, len, fbank_dma_ctl_inc, follow);
+        src += len * 4;
+        dst += len * 4;
+        words -= len;
+        n++;
+    }
+    return n;
+}
+
+// DMA_Init restores the chained CTLn the previous chain's last item cleared
+static void fbank_dma_channel_start(DMA_LlpTypeDef *first)
+{
+    fbank_dma_channel_init();
+    DMA_Set_Addr(DMA, FBANK_DMA_CHANNEL, 0, 0, 0, mmap_to_sys((uint32_t)first));
+    DMA_Set_Channel_Enable_Cmd(DMA, FBANK_DMA_CHANNEL, ENABLE);
+}
+
+// the upload chain ends with the FBANK_EN write, so both its transfer
+// interrupt and the FBANK interrupt come in. whichever is second starts the
+// download. the DMA irq level belongs to whoever else uses the controller,
+// so the stage update runs with MIE cleared instead of relying on the two
+// irqs sharing a level.
+
+// FBANK interrupt: the result is ready
+static void fbank_dma_on_fbank_done(void)
+{
+    rv_csr_t mstatus;
+    fbank_dma_act_t act;
+
+    fft_interrupt_flag = 0;
+    fft_set_done_callback(NULL);
+
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    act = fbank_dma_stage_fbank_done((fbank_dma_stage_t *)&fbank_dma_stage);
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    if (act == FBANK_DMA_ACT_DOWNLOAD) {
+        fbank_dma_channel_start(&fbank_dma_llp_down[0]);
+    }
+}
+
+void fbank_dma_irq_handler(void)
+{
+    rv_csr_t mstatus;
+    fbank_dma_act_t act;
+
+    DMA_Clear_Transfer_Interrupt_Cmd(DMA, FBANK_DMA_CHANNEL);
+    DMA_Clear_Block_Interrupt_Cmd(DMA, FBANK_DMA_CHANNEL);
+
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    act = fbank_dma_stage_dma_done((fbank_dma_stage_t *)&fbank_dma_stage);
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    if (act == FBANK_DMA_ACT_DOWNLOAD) {
+        fbank_dma_channel_start(&fbank_dma_llp_down[0]);
+        return;
+    }
+    if (act != FBANK_DMA_ACT_FINISH)
+        return;
+
+    if (fbank_dma_read_words & FBANK_DMA_READ_CP2) {
+        uint32_t n = fbank_dma_read_words & ~FBANK_DMA_READ_CP2;
+        for (uint32_t i = 0; i < n / 2; i++) {
+            fbank_dma_read_ptr[i] = fbank_dma_cp2_buf[2 * i];
+        }
+    }
+
+    ECLIC_ClearPendingIRQ(FBANK_IRQn);
+    ECLIC_DisableIRQ(FBANK_IRQn);
+    RCC_CLK_EN_Ctl(RCC_FFT_CLKEN, DISABLE);
+
+    fbank_dma_stage_end((fbank_dma_stage_t *)&fbank_dma_stage);
+    fbank_dma_done = 1;
+    if (fbank_dma_user_cb != NULL) {
+        fbank_dma_user_cb(fbank_dma_read_ptr);
+    }
+}
+
+static int fbank_dma_start(const fbank_dma_op_t *op, uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    uint32_t ctl;
+    uint32_t read_words = op->read_words & ~FBANK_DMA_READ_CP2;
+    uint32_t read_dst = (op->read_words & FBANK_DMA_READ_CP2) ? (uint32_t)fbank_dma_cp2_buf : (uint32_t)data_read;
+    rv_csr_t mstatus;
+    int n;
+
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    n = fbank_dma_stage_begin((fbank_dma_stage_t *)&fbank_dma_stage);
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+    if (n < 0)
+        return -1;
+    fbank_dma_done = 0;
+    fbank_dma_read_ptr = data_read;
+    fbank_dma_read_words = op->read_words;
+    fbank_dma_user_cb = callback;
+
+    RCC_CLK_EN_Ctl(RCC_FFT_CLKEN, ENABLE);
+    RCC_CLK_EN_Ctl(RCC_DMA_CLKEN, ENABLE);
+    ECLIC_ClearPendingIRQ(FBANK_IRQn);
+    ECLIC_SetPriorityIRQ(FBANK_IRQn, 1);
+    ECLIC_SetTrigIRQ(FBANK_IRQn, ECLIC_POSTIVE_EDGE_TRIGGER);
+    ECLIC_EnableIRQ(FBANK_IRQn);
+    ECLIC_EnableIRQ(DMA_IRQn);
+
+    FBANK_Set_Interrupt_Cmd(FBANK, FBANK_INT, ENABLE);
+
+    // same register sequence as the cpu versions, then snapshot it so the
+    // chains only have to write whole words
+    FBANK_Ctl_Cmd(FBANK, 0xffff, DISABLE);
+    FBANK_Ctl_Cmd(FBANK, op->ctl, ENABLE);
+    FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
+    FBANK_Ctl_Cmd(FBANK, SRAM_ADDR_SEL, op->addr_sel ? ENABLE : DISABLE);
+    ctl = FBANK->FBANK_CONTROL;
+
+    fbank_dma_reg[0] = ctl & ~FBANK_FBANK_CONTROL_FBANK_DATA_RAM_SEL_Msk;
+    fbank_dma_reg[1] = FBANK->FBANK_EN | FBANK_FBANK_EN_FBANK_EN_Msk;
+    fbank_dma_reg[2] = fbank_dma_reg[0] | FBANK_FBANK_CONTROL_FBANK_DATA_RAM_SEL_Msk;
+    if (op->read_addr_sel) {
+        fbank_dma_reg[2] |= FBANK_FBANK_CONTROL_SRAM_ADDR_SEL_Msk;
+    } else {
+        fbank_dma_reg[2] &= ~FBANK_FBANK_CONTROL_SRAM_ADDR_SEL_Msk;
+    }
+
+    fbank_dma_channel_init();
+    fbank_dma_ctl_cache();
+
+    n = fbank_dma_build_data(fbank_dma_llp_up, (uint32_t)data_write, (uint32_t)FBANK->SRAM, FBANK_DMA_SRAM_WORDS,
+                             &fbank_dma_llp_up[FBANK_DMA_DATA_LLP]);
+    fbank_dma_llp_set(&fbank_dma_llp_up[n], (uint32_t)&fbank_dma_reg[0], (uint32_t)&FBANK->FBANK_CONTROL, 1,
+                      fbank_dma_ctl_fixed, &fbank_dma_llp_up[n + 1]);
+    fbank_dma_llp_set(&fbank_dma_llp_up[n + 1], (uint32_t)&fbank_dma_reg[1], (uint32_t)&FBANK->FBANK_EN, 1,
+                      fbank_dma_ctl_fixed, NULL);
+
+    fbank_dma_llp_set(&fbank_dma_llp_down[0], (uint32_t)&fbank_dma_reg[2], (uint32_t)&FBANK->FBANK_CONTROL, 1,
+                      fbank_dma_ctl_fixed, &fbank_dma_llp_down[1]);
+    fbank_dma_build_data(&fbank_dma_llp_down[1], (uint32_t)FBANK->SRAM, read_dst, read_words, NULL);
+
+    // only this channel's flags, the other channels own theirs
+    DMA_Clear_Transfer_Interrupt_Cmd(DMA, FBANK_DMA_CHANNEL);
+    DMA_Clear_Block_Interrupt_Cmd(DMA, FBANK_DMA_CHANNEL);
+    DMA_Set_Enable_Cmd(DMA, ENABLE);
+    DMA_Set_Transfer_Interrupt_Cmd(DMA, FBANK_DMA_CHANNEL, ENABLE);
+
+    fft_interrupt_flag = 0;
+    fft_set_done_callback(fbank_dma_on_fbank_done);
+    fbank_dma_channel_start(&fbank_dma_llp_up[0]);
+
+    if (callback == NULL) {
+        mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+        while (!fbank_dma_done) {
+            __WFI();
+            __RV_CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+            __RV_CSR_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+        }
+        __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+    }
+    return 0;
+}
+
+int fbank_dma_busy(void)
+{
+    return fbank_dma_stage.running;
+}
+
+int fft_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_fft, data_write, data_read, callback);
+}
+
+int ifft_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_ifft, data_write, data_read, callback);
+}
+
+int fbank_calculate_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_fbank, data_write, data_read, callback);
+}
+
+int fbank_calculate_win_fft_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_win_fft, data_write, data_read, callback);
+}
+
+int fbank_calculate_sqrt_mel_log_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_sqrt_mel_log, data_write, data_read, callback);
+}
+
+int fbank_calculate_sqrt_mel_dma(uint32_t *data_write, uint32_t *data_read, fbank_dma_callback_t callback)
+{
+    return fbank_dma_start(&fbank_dma_op_sqrt_mel, data_write, data_read, callback);
+}
@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <string.h>
+#include "WTM2101.h"
+#include "rcc.h"
+#include "fbank_frame_ring.h"
+
+#if (FBANK_RING_SIZE & FBANK_RING_MASK) || (FBANK_RING_SIZE < _WIN_SIZE)
+#error "FBANK_RING_SIZE must be a power of two not less than _WIN_SIZE"
+#endif
+
+static int16_t ring_buf[FBANK_RING_SIZE];
+// free running sample counters, only the low bits index the ring
+static uint32_t ring_wr = 0;
+static uint32_t ring_rd = 0;
+
+void fbank_ring_reset(void)
+{
+    ring_wr = 0;
+    ring_rd = 0;
+}
+
+uint32_t fbank_ring_push(const int16_t *pcm, uint32_t num)
+{
+    uint32_t dropped = 0;
+    uint32_t avail, pos, first;
+
+    // more than a ring in one block, only its tail can be kept
+    if (num > FBANK_RING_SIZE) {
+        pcm += num - FBANK_RING_SIZE;
+        ring_wr += num - FBANK_RING_SIZE;
+        num = FBANK_RING_SIZE;
+    }
+
+    // a full ring drops the oldest samples, frames keep their 160 grid
+    avail = ring_wr - ring_rd;
+    if (avail + num > FBANK_RING_SIZE) {
+        dropped = avail + num - FBANK_RING_SIZE;
+        dropped = (dropped + _UPDATE_SIZE - 1) / _UPDATE_SIZE * _UPDATE_SIZE;
+        ring_rd += dropped;
+    }
+
+    pos = ring_wr & FBANK_RING_MASK;
+    first = FBANK_RING_SIZE - pos;
+    if (first > num) {
+        first = num;
+    }
+    memcpy(&ring_buf[pos], pcm, first * sizeof(int16_t));
+    memcpy(&ring_buf[0], pcm + first, (num - first) * sizeof(int16_t));
+    ring_wr += num;
+    return dropped;
+}
+
+uint32_t fbank_ring_frames(void)
+{
+    uint32_t avail = ring_wr - ring_rd;
+
+    if (avail < _WIN_SIZE)
+        return 0;
+    return (avail - _WIN_SIZE) / _UPDATE_SIZE + 1;
+}
+
+int fbank_ring_get_frame(fbank_frame_view_t *view)
+{
+    if (ring_wr - ring_rd < _WIN_SIZE)
+        return -1;
+
+    view->ring = ring_buf;
+    view->start = ring_rd & FBANK_RING_MASK;
+    ring_rd += _UPDATE_SIZE;
+    return 0;
+}
+
+void fbank_ring_fft_start(const fbank_frame_view_t *view)
+{
+    volatile uint32_t *pDst = FBANK->SRAM;
+    const int16_t *ring = view->ring;
+    uint32_t pos = view->start;
+    uint32_t first = FBANK_RING_SIZE - pos;
+    int i;
+
+    RCC_CLK_EN_Ctl(RCC_FFT_CLKEN, ENABLE);
+    ECLIC_ClearPendingIRQ(FBANK_IRQn);
+    ECLIC_SetPriorityIRQ(FBANK_IRQn, 1);
+    ECLIC_SetTrigIRQ(FBANK_IRQn, ECLIC_POSTIVE_EDGE_TRIGGER);
+    ECLIC_EnableIRQ(FBANK_IRQn);
+
+    FBANK_Set_Interrupt_Cmd(FBANK,FBANK_INT,ENABLE);
+
+    FBANK_Ctl_Cmd(FBANK, 0xffff, DISABLE);
+    FBANK_Ctl_Cmd(FBANK, DO_RFFT_HCLK | DO_CFFT_HCLK | FFT_ENABLE, ENABLE);
+    FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, ENABLE);
+    FBANK_Ctl_Cmd(FBANK, SRAM_ADDR_SEL, ENABLE);
+
+    // the window wraps at most once, two straight loops instead of a
+    // mask per sample
+    if (first > _WIN_SIZE) {
+        first = _WIN_SIZE;
+    }
+    for (i = 0; i < (int)first; i++) {
+        *pDst++ = (uint32_t)(((int32_t)ring[pos + i] * povey_win_signed[i]) >> 15);
+    }
+    for (; i < _WIN_SIZE; i++) {
+        *pDst++ = (uint32_t)(((int32_t)ring[i - first] * povey_win_signed[i]) >> 15);
+    }
+    for (; i < _NFFT; i++) {
+        *pDst++ = 0;
+    }
+
+    fft_interrupt_flag = 0;
+    FBANK_Ctl_Cmd(FBANK, DATA_SRAM_SEL, DISABLE);
+    FBANK_Enable_Cmd(FBANK, ENABLE);
+}
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <string.h>
+#include "WTM2101.h"
+#include "rcc.h"
+#include "fbank_pipeline.h"
+
+static fbank_pipe_cfg_t pipe_cfg;
+static fbank_pipe_stats_t pipe_stats;
+
+// one read back buffer is enough: frame N-1 leaves the FBANK sram
+// before frame N is uploaded
+static uint32_t pipe_spectrum[512];
+
+// every feature is written twice, context frames apart, so the window
+// ending at any frame is contiguous for the nnet. the window the NPU reads
+// is copied out first, the ring moves on while the nnet runs.
+static uint8_t pipe_feats[2 * FBANK_PIPE_MAX_CONTEXT * FBANK_PIPE_MAX_FEAT_DIM];
+static uint8_t pipe_nnet_in[FBANK_PIPE_MAX_CONTEXT * FBANK_PIPE_MAX_FEAT_DIM];
+static uint16_t pipe_feat_pos = 0;
+static uint32_t pipe_feat_cnt = 0;
+static uint16_t pipe_step_cnt = 0;
+static uint8_t pipe_fft_busy = 0;
+static uint8_t pipe_nnet_busy = 0;
+
+static void pipe_nnet_wait(void)
+{
+    uint64_t t0;
+
+    if (!pipe_nnet_busy)
+        return;
+    t0 = __get_rv_cycle();
+    pipe_cfg.nnet_wait();
+    pipe_stats.nnet_wait_cycles += __get_rv_cycle() - t0;
+    pipe_nnet_busy = 0;
+}
+
+int fbank_pipe_init(const fbank_pipe_cfg_t *cfg)
+{
+    if (cfg == NULL || cfg->mel_log == NULL)
+        return -1;
+    if (cfg->feat_dim == 0 || cfg->feat_dim > FBANK_PIPE_MAX_FEAT_DIM)
+        return -2;
+    if (cfg->context == 0 || cfg->context > FBANK_PIPE_MAX_CONTEXT)
+        return -3;
+    if (cfg->nnet_start != NULL && cfg->nnet_wait == NULL)
+        return -4;
+
+    if (pipe_fft_busy) {
+        fft_calculate_part2(pipe_spectrum);
+        pipe_fft_busy = 0;
+    }
+    pipe_nnet_wait();
+
+    pipe_cfg = *cfg;
+    if (pipe_cfg.nnet_step == 0) {
+        pipe_cfg.nnet_step = 1;
+    }
+    memset(&pipe_stats, 0, sizeof(pipe_stats));
+    pipe_feat_pos = 0;
+    pipe_feat_cnt = 0;
+    pipe_step_cnt = 0;
+    return 0;
+}
+
+static int pipe_feature_stage(void)
+{
+    uint64_t t0, t1;
+    uint8_t *feat = &pipe_feats[pipe_feat_pos * pipe_cfg.feat_dim];
+
+    t0 = __get_rv_cycle();
+    pipe_cfg.mel_log(pipe_spectrum, feat);
+    memcpy(feat + pipe_cfg.context * pipe_cfg.feat_dim, feat, pipe_cfg.feat_dim);
+    pipe_feat_pos++;
+    if (pipe_feat_pos >= pipe_cfg.context) {
+        pipe_feat_pos = 0;
+    }
+    pipe_feat_cnt++;
+    t1 = __get_rv_cycle();
+    pipe_stats.mel_cycles += t1 - t0;
+
+    if (pipe_cfg.nnet_start == NULL || pipe_feat_cnt < pipe_cfg.context)
+        return 0;
+    if (++pipe_step_cnt < pipe_cfg.nnet_step)
+        return 0;
+    pipe_step_cnt = 0;
+
+    // the previous window has had a whole frame of fft and mel to finish
+    pipe_nnet_wait();
+
+    // oldest frame of the window sits at the next write position
+    t1 = __get_rv_cycle();
+    memcpy(pipe_nnet_in, &pipe_feats[pipe_feat_pos * pipe_cfg.feat_dim], pipe_cfg.context * pipe_cfg.feat_dim);
+    pipe_cfg.nnet_start(pipe_nnet_in, pipe_cfg.context);
+    pipe_nnet_busy = 1;
+    pipe_stats.nnet_cycles += __get_rv_cycle() - t1;
+    return 1;
+}
+
+static void pipe_collect(void)
+{
+    uint64_t t0, t1;
+
+    t0 = __get_rv_cycle();
+    fft_wait_done();
+    t1 = __get_rv_cycle();
+    // the flag is already set, part2 only reads back
+    fft_calculate_part2(pipe_spectrum);
+    pipe_stats.fft_wait_cycles += t1 - t0;
+    pipe_stats.io_cycles += __get_rv_cycle() - t1;
+    pipe_fft_busy = 0;
+}
+
+int fbank_pipe_push(uint32_t *fft_in)
+{
+    uint8_t have_prev = pipe_fft_busy;
+    uint64_t t0;
+
+    if (have_prev) {
+        pipe_collect();
+    }
+
+    t0 = __get_rv_cycle();
+    fft_calculate_part1(fft_in);
+    pipe_fft_busy = 1;
+    pipe_stats.io_cycles += __get_rv_cycle() - t0;
+    pipe_stats.frames++;
+
+    // the FBANK block now transforms frame N on its own
+    if (!have_prev)
+        return 0;
+    return pipe_feature_stage();
+}
+
+int fbank_pipe_flush(void)
+{
+    int ran = 0;
+
+    if (pipe_fft_busy) {
+        pipe_collect();
+        ran = pipe_feature_stage();
+    }
+    pipe_nnet_wait();
+    return ran;
+}
+
+const uint8_t *fbank_pipe_last_feature(void)
+{
+    uint16_t pos;
+
+    if (pipe_feat_cnt == 0)
+        return NULL;
+    pos = pipe_feat_pos ? pipe_feat_pos - 1 : pipe_cfg.context - 1;
+    return &pipe_feats[pos * pipe_cfg.feat_dim];
+}
+
+void fbank_pipe_get_stats(fbank_pipe_stats_t *stats)
+{
+    *stats = pipe_stats;
+}
+
+void fbank_pipe_print_stats(void)
+{
+    uint32_t n = pipe_stats.frames ? pipe_stats.frames : 1;
+
+    printf(" %-10s: %8d frames\r\n", "> pipe", pipe_stats.frames);
+    printf(" %-10s: %8d cycles/frame\r\n", "> fft.wait", (uint32_t)(pipe_stats.fft_wait_cycles / n));
+    printf(" %-10s: %8d cycles/frame\r\n", "> fft.io", (uint32_t)(pipe_stats.io_cycles / n));
+    printf(" %-10s: %8d cycles/frame\r\n", "> mel", (uint32_t)(pipe_stats.mel_cycles / n));
+    printf(" %-10s: %8d cycles/frame\r\n", "> nnet", (uint32_t)(pipe_stats.nnet_cycles / n));
+    printf(" %-10s: %8d cycles/frame\r\n", "> nnet.wait", (uint32_t)(pipe_stats.nnet_wait_cycles / n));
+}
@@ -0,0 +1,30 @@
+#include <string.h>
+#include "feature_frontend_hw.h"
+
+int feature_frontend_compute_hw(const feature_frontend_t *fe, const int16_t *frame,
+                                uint32_t *words, uint8_t *out)
+{
+    if (fe == NULL || frame == NULL || words == NULL || out == NULL) {
+        return -1;
+    }
+
+    if (fe->hw_fbank) {
+        uint32_t feat[_NUM_MEL_BINS / 4];
+        int n;
+
+        for (n = 0; n < _WIN_SIZE; n++) {
+            words[n] = (uint32_t)(int32_t)frame[n];
+        }
+        for (; n < _NFFT; n++) {
+            words[n] = 0;
+        }
+        fbank_calculate(words, feat);
+        memcpy(out, feat, _NUM_MEL_BINS);
+        return 0;
+    }
+
+    feature_frontend_window(fe, frame, (int32_t *)words);
+    fft_calculate(words, words);
+    feature_frontend_mel_log(fe, (const int32_t *)words, out);
+    return 0;
+}
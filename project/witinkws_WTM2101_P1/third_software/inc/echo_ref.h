@@ -0,0 +1,74 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _ECHO_REF_H
+#define _ECHO_REF_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+#include "hal_i2s.h"
+
+/*
+ * playback reference for the echo canceller, lined up with the capture.
+ *
+ * the tx tap of hal_i2s copies every block queued for the speaker into a
+ * ring, indexed by its place in the tx stream. for each captured block the
+ * dma stamps of both directions give the tx frame that went out while the
+ * last frame of the block came in, the difference is the offset of the two
+ * streams. the reference block is the played frames that many frames back
+ * plus delay_frames for the codec and the air. the offset is only moved
+ * when its smoothed estimate is more than ECHO_REF_SLACK frames away, so
+ * interrupt jitter does not shift the reference under the adaptive filter.
+ *
+ * the two instances may be the same (send and receive type) or two with a
+ * common clock. wiring with the fbank pipeline:
+ *
+ *   capture block      hal_i2s_read(rx, mic...), echo_ref_read(ref, n)
+ *   frame              the mic and the ref frame as fbank_calculate words
+ *   features           fbank_aec_calculate(aec, mic, ref, feature, played > 0):
+ *                      block window and fft of both, aec_nlms_process on
+ *                      the mic spectrum, block sqrt/mel/log of it
+ */
+
+#define ECHO_REF_SLACK          (4)         /*!< frames the offset may drift before it is moved */
+
+typedef struct
+{
+    uint32_t tapped;                        /*!< frames from the tx tap */
+    uint32_t dropped;                       /*!< tapped with the ring full */
+    uint32_t gaps;                          /*!< tx blocks not contiguous, the ring was flushed */
+    uint32_t blocks;                        /*!< reference blocks read */
+    uint32_t silent_frames;                 /*!< read as zeros, not played yet or gone */
+    uint32_t realigns;
+    int32_t offset;                         /*!< rx frame minus tx frame at the same time, in use */
+} echo_ref_stats_t;
+
+/**
+* @brief  init the reference, called after hal_i2s_init of both instances
+* @param  tx: the playing instance, its tx tap is taken
+* @param  rx: the capturing instance, may be tx
+* @param  ring: storage, a power of two bytes, 2 bytes per frame
+* @param  delay_frames: codec and acoustic delay, the adaptive filter covers the rest
+* @param  channel: 0 left, 1 right channel of the playback
+* @retval 0 success, -1 bad arguments, -2 ring not a power of two
+*/
+extern int echo_ref_init(Hal_I2s_InitTypeDef *tx, Hal_I2s_InitTypeDef *rx, uint8_t *ring, uint32_t ring_bytes,
+                         uint16_t delay_frames, int channel);
+
+/**
+* @brief  reference of the block just read from rx, once per captured block in order
+* @param  ref: frames samples
+* @retval the frames that were played audio, the others are zeros, -1 before echo_ref_init
+*/
+extern int echo_ref_read(int16_t *ref, int frames);
+
+extern void echo_ref_get_stats(echo_ref_stats_t *stats);
+extern void echo_ref_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
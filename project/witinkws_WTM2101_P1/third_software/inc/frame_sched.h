@@ -0,0 +1,105 @@
+/** Define to Prevent Recursive Inclusion */
+#ifndef _FRAME_SCHED_H
+#define _FRAME_SCHED_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/** Includes */
+#include <stdint.h>
+
+/*
+ * tick driven frame scheduler: the audio interrupt (DMA block, RAM valid
+ * or a hal_audio async callback) calls frame_sched_tick() once per frame,
+ * the main loop calls frame_sched_run(), which sleeps with WFI until a tick
+ * is pending and then runs the registered stages in order.
+ *
+ * per frame it records the cycles of every stage, the time slept before
+ * the frame and whether it finished within its deadline, one frame period
+ * after the tick, into a ring of FRAME_SCHED_LOG_DEPTH records. the ring
+ * and a summary are printed with printf, so they go to UART or RTT as
+ * retarget is set up. the idle ratio at a given PLL/NPU clock pair shows
+ * how much lower the clocks can go.
+ *
+ * with FRAME_SCHED_ENABLE defined audio_handle.c ticks it from the audio
+ * RAM frame valid interrupt. the KWS frame loop registers its stages
+ * (fbank, nnet, decoder) once and calls frame_sched_run() in place of its
+ * own wait on audio_ram_buffer_write_flag.
+ */
+
+#define FRAME_SCHED_MAX_STAGES      (8)
+#define FRAME_SCHED_LOG_DEPTH       (32)
+
+/**
+* @brief  one stage of a frame, a negative return skips the rest of the frame
+*/
+typedef int (*frame_sched_stage_func_t)(void *arg);
+
+typedef struct
+{
+    uint32_t frame;                                 /*!< tick number of the frame */
+    uint32_t idle_cycles;                           /*!< slept before the frame */
+    uint32_t busy_cycles;                           /*!< all stages */
+    uint32_t latency_cycles;                        /*!< tick to the end of the last stage */
+    uint32_t stage_cycles[FRAME_SCHED_MAX_STAGES];
+    uint8_t backlog;                                /*!< ticks still pending after this frame */
+    uint8_t late;                                   /*!< latency over the frame period */
+} frame_sched_record_t;
+
+typedef struct
+{
+    uint32_t frames;
+    uint32_t misses;                                /*!< frames over the deadline */
+    uint32_t dropped;                               /*!< ticks lost to a full backlog */
+    uint64_t idle_cycles;
+    uint64_t busy_cycles;
+    uint32_t max_latency_cycles;
+    uint64_t stage_cycles[FRAME_SCHED_MAX_STAGES];
+    uint32_t stage_max_cycles[FRAME_SCHED_MAX_STAGES];
+} frame_sched_stats_t;
+
+/**
+* @brief  init the scheduler, call after the clock setup
+* @param  frame_us: the frame period, 10000 for a 160 sample shift at 16 kHz
+* @retval 0 success, <0 bad period
+*/
+extern int frame_sched_init(uint32_t frame_us);
+
+/**
+* @brief  append a stage, stages run in the order they were added
+* @param  name: printed in the summary
+* @retval the stage index, -1 when FRAME_SCHED_MAX_STAGES are added
+*/
+extern int frame_sched_add(const char *name, frame_sched_stage_func_t func, void *arg);
+
+/**
+* @brief  a frame is ready, call from the interrupt
+*/
+extern void frame_sched_tick(void);
+
+/**
+* @brief  sleep until a tick is pending and run one frame through all stages
+* @retval the tick number of the frame
+*/
+extern uint32_t frame_sched_run(void);
+
+/**
+* @brief  copy out up to max records oldest first, they are removed from the ring
+* @retval the number of records
+*/
+extern int frame_sched_log_read(frame_sched_record_t *records, int max);
+
+extern void frame_sched_get_stats(frame_sched_stats_t *stats);
+extern void frame_sched_reset_stats(void);
+
+/**
+* @brief  print the records in the ring and the summary
+*/
+extern void frame_sched_print(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
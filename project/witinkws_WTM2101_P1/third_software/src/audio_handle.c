@@ -7,6 +7,10 @@
 
 #include "stdio.h"
 #include "config_common.h"
+#include "fbank_dma.h"
+#ifdef FRAME_SCHED_ENABLE
+#include "frame_sched.h"
+#endif
 
 //#ifdef USE_I2S_IN
 //extern volatile uint32_t iis0_ram_buffer_write_flag;
@@ -24,6 +28,9 @@ void audio_ram_vld_callback(void)
 		ECLIC_ClearPendingIRQ(AUDIO_IRQn);
         AUDIO_Clear_Ram_Interrupt(AUD,AUDIO_CHANNEL0,AUDIO_RAM_FRAME_VLD_INTERRUPT);
         ++audio_ram_buffer_write_flag;
+#ifdef FRAME_SCHED_ENABLE
+        frame_sched_tick();
+#endif
     }
     
 }
@@ -52,6 +59,12 @@ void DMA_IRQHandler(void)
     /*The hal i2s instance*/
     Hal_I2s_InitTypeDef* hal_i2s_instance= hal_i2s_instance_get(HAL_I2S_INSTANCE0);
     Hal_I2s_InitTypeDef* hal_i2s_instance1= hal_i2s_instance_get(HAL_I2S_INSTANCE1);
+    /*The fbank sram load/unload chain, transfer interrupt only*/
+    if(DMA_Get_Transfer_Interrupt_Status(DMA) & FBANK_DMA_CHANNEL)
+    {
+        fbank_dma_irq_handler();
+    }
+
     block_int_flag = DMA_Get_Block_Interrupt_Status(DMA);
    
     do
@@ -0,0 +1,194 @@
+#include <stdio.h>
+#include <string.h>
+#include "WTM2101.h"
+#include "rcc.h"
+#include "spsc_ring.h"
+#include "echo_ref.h"
+
+static Hal_I2s_InitTypeDef *ref_tx = NULL;
+static Hal_I2s_InitTypeDef *ref_rx = NULL;
+static Spsc_Ring ref_ring;
+static int ref_channel = 0;
+static uint16_t ref_delay = 0;
+static uint32_t ref_cycles_q8 = 0;                 // core cycles per frame, Q8
+
+// written by the tx tap only
+static volatile uint32_t ref_head_frame = 0;       // tx frame of the next sample into the ring
+static volatile uint32_t ref_gap_seq = 0;
+static volatile uint8_t ref_started = 0;
+
+// written by echo_ref_read only
+static uint32_t ref_gap_seen = 0;
+static uint32_t ref_rx_read = 0;                   // rx frames read so far
+static int32_t ref_offset_q4 = 0;                  // smoothed offset estimate
+static uint8_t ref_aligned = 0;
+
+static echo_ref_stats_t ref_stats;
+
+// one block queued for the speaker, in the dma interrupt
+static void echo_ref_tap(struct Hal_I2s_InitTypeDef *i2s_instance, const void *frames, int count, uint32_t first_frame)
+{
+    int16_t mono[16];
+    int n = count > 16 ? 16 : count;
+
+    if (!ref_started || first_frame != ref_head_frame) {
+        // a restart of the stream, the ring no longer lines up
+        if (ref_started) {
+            ref_stats.gaps++;
+        }
+        ref_gap_seq++;
+        ref_started = 1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (i2s_instance->width_word == HAL_I2S_16BITS_WIDTH_WORD) {
+            mono[i] = ((const int16_t *)frames)[i * 2 + ref_channel];
+        } else {
+            mono[i] = (int16_t)(((const int32_t *)frames)[i * 2 + ref_channel] >> 16);
+        }
+    }
+
+    if (Spsc_Ring_Push(&ref_ring, mono, n * sizeof(int16_t)) == 0) {
+        ref_stats.dropped += n;
+        ref_gap_seq++;
+    }
+    ref_stats.tapped += n;
+    ref_head_frame = first_frame + n;
+}
+
+int echo_ref_init(Hal_I2s_InitTypeDef *tx, Hal_I2s_InitTypeDef *rx, uint8_t *ring, uint32_t ring_bytes,
+                  uint16_t delay_frames, int channel)
+{
+    uint32_t core_hz;
+
+    if (tx == NULL || rx == NULL || ring == NULL || channel < 0 || channel > 1 || tx->lrclk_frequency <= 0)
+        return -1;
+    if (Spsc_Ring_Init(&ref_ring, ring, ring_bytes) != 0x01)
+        return -2;
+
+    core_hz = RCC_Get_SYSClk() / (RCC_AHB_Get_ClkDiv() + 1);
+    ref_cycles_q8 = (uint32_t)(((uint64_t)core_hz << 8) / tx->lrclk_frequency);
+    ref_tx = tx;
+    ref_rx = rx;
+    ref_channel = channel;
+    ref_delay = delay_frames;
+    ref_head_frame = 0;
+    ref_gap_seq = 0;
+    ref_started = 0;
+    ref_gap_seen = 0;
+    ref_rx_read = 0;
+    ref_offset_q4 = 0;
+    ref_aligned = 0;
+    memset(&ref_stats, 0, sizeof(ref_stats));
+
+    if (hal_i2s_tx_tap_config(tx, echo_ref_tap) <= 0)
+        return -1;
+    return 0;
+}
+
+// rx frame minus tx frame at the time rx_end came in, Q4
+static int32_t echo_ref_measure(uint32_t rx_end)
+{
+    Hal_I2s_Stamp_Typedef tx_stamp, rx_stamp;
+    int64_t t;
+
+    hal_i2s_stamp_get(ref_rx, &rx_stamp);
+    hal_i2s_stamp_get(ref_tx, &tx_stamp);
+
+    t = (int64_t)rx_stamp.rx_timestamp - (((int64_t)(int32_t)(rx_stamp.rx_frames - rx_end) * ref_cycles_q8) >> 8);
+    return (int32_t)(rx_end - tx_stamp.tx_frames) * 16 -
+           (int32_t)(((t - (int64_t)tx_stamp.tx_timestamp) * 4096) / ref_cycles_q8);
+}
+
+static void echo_ref_align(int32_t measured_q4)
+{
+    int32_t estimate;
+
+    if (!ref_aligned) {
+        ref_offset_q4 = measured_q4;
+        ref_stats.offset = (measured_q4 + 8) >> 4;
+        ref_aligned = 1;
+        return;
+    }
+
+    ref_offset_q4 += (measured_q4 - ref_offset_q4) / 8;
+    estimate = (ref_offset_q4 + 8) >> 4;
+    if (estimate > ref_stats.offset + ECHO_REF_SLACK || estimate < ref_stats.offset - ECHO_REF_SLACK) {
+        ref_stats.offset = estimate;
+        ref_stats.realigns++;
+    }
+}
+
+int echo_ref_read(int16_t *ref, int frames)
+{
+    uint32_t rx_end, head, used, gap, tail, start;
+    int32_t ahead;
+    int n = 0, played = 0;
+    rv_csr_t mstatus;
+
+    if (ref == NULL || frames <= 0 || ref_tx == NULL)
+        return -1;
+
+    ref_rx_read += frames;
+    rx_end = ref_rx_read;
+    ref_stats.blocks++;
+
+    // the tap state in one go, the caller may have the interrupts masked already
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    head = ref_head_frame;
+    used = Spsc_Ring_Used(&ref_ring) / sizeof(int16_t);
+    gap = ref_gap_seq;
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    if (gap != ref_gap_seen) {
+        Spsc_Ring_Read_Commit(&ref_ring, used * sizeof(int16_t));
+        ref_gap_seen = gap;
+        used = 0;
+        ref_aligned = 0;
+    }
+
+    if (used > 0) {
+        echo_ref_align(echo_ref_measure(rx_end));
+
+        // tx frame of the first reference sample
+        start = rx_end - ref_stats.offset - ref_delay - frames;
+        tail = head - used;
+        ahead = (int32_t)(start - tail);
+        if (ahead > 0) {
+            uint32_t drop = (uint32_t)ahead < used ? (uint32_t)ahead : used;
+
+            Spsc_Ring_Read_Commit(&ref_ring, drop * sizeof(int16_t));
+            tail += drop;
+            used -= drop;
+        }
+
+        // older than the ring, already gone
+        while (n < frames && (int32_t)(start + n - tail) < 0) {
+            ref[n++] = 0;
+        }
+        played = (int)(used < (uint32_t)(frames - n) ? used : (uint32_t)(frames - n));
+        Spsc_Ring_Pop(&ref_ring, ref + n, played * sizeof(int16_t));
+        n += played;
+    }
+
+    // not played yet
+    while (n < frames) {
+        ref[n++] = 0;
+    }
+    ref_stats.silent_frames += frames - played;
+    return played;
+}
+
+void echo_ref_get_stats(echo_ref_stats_t *stats)
+{
+    *stats = ref_stats;
+}
+
+void echo_ref_print(void)
+{
+    printf("echo ref: offset %ld + %u, tapped %lu, dropped %lu, gaps %lu, blocks %lu, silent %lu, realigns %lu\r\n",
+           (long)ref_stats.offset, ref_delay, (unsigned long)ref_stats.tapped,
+           (unsigned long)ref_stats.dropped, (unsigned long)ref_stats.gaps,
+           (unsigned long)ref_stats.blocks, (unsigned long)ref_stats.silent_frames,
+           (unsigned long)ref_stats.realigns);
+}
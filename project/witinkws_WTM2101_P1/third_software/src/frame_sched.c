@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <string.h>
+#include "WTM2101.h"
+#include "rcc.h"
+#include "frame_sched.h"
+
+// tick stamps kept for frames not run yet, an older backlog is dropped
+#define FRAME_SCHED_TICK_DEPTH      (4)
+
+typedef struct
+{
+    const char *name;
+    frame_sched_stage_func_t func;
+    void *arg;
+} frame_sched_stage_t;
+
+static frame_sched_stage_t sched_stages[FRAME_SCHED_MAX_STAGES];
+static int sched_num_stages = 0;
+static uint32_t sched_period_cycles = 0;
+static uint32_t sched_core_hz = 0;
+
+// sched_ticks and the stamps are written by the interrupt only,
+// sched_done by frame_sched_run only
+static volatile uint32_t sched_ticks = 0;
+static volatile uint32_t sched_tick_stamp[FRAME_SCHED_TICK_DEPTH];
+static uint32_t sched_done = 0;
+
+static frame_sched_record_t sched_log[FRAME_SCHED_LOG_DEPTH];
+static uint16_t sched_log_pos = 0;                 // next record to write
+static uint16_t sched_log_count = 0;
+static frame_sched_stats_t sched_stats;
+
+static uint32_t sched_now(void)
+{
+    return (uint32_t)__get_rv_cycle();
+}
+
+int frame_sched_init(uint32_t frame_us)
+{
+    if (frame_us == 0)
+        return -1;
+
+    sched_core_hz = RCC_Get_SYSClk() / (RCC_AHB_Get_ClkDiv() + 1);
+    sched_period_cycles = (uint32_t)((uint64_t)sched_core_hz * frame_us / 1000000);
+    sched_num_stages = 0;
+    sched_done = sched_ticks;
+    sched_log_pos = 0;
+    sched_log_count = 0;
+    memset(&sched_stats, 0, sizeof(sched_stats));
+    return 0;
+}
+
+int frame_sched_add(const char *name, frame_sched_stage_func_t func, void *arg)
+{
+    if (func == NULL || sched_num_stages >= FRAME_SCHED_MAX_STAGES)
+        return -1;
+
+    sched_stages[sched_num_stages].name = name;
+    sched_stages[sched_num_stages].func = func;
+    sched_stages[sched_num_stages].arg = arg;
+    return sched_num_stages++;
+}
+
+void frame_sched_tick(void)
+{
+    uint32_t n = sched_ticks;
+
+    sched_tick_stamp[n % FRAME_SCHED_TICK_DEPTH] = sched_now();
+    sched_ticks = n + 1;
+}
+
+static void sched_record(const frame_sched_record_t *rec)
+{
+    sched_log[sched_log_pos] = *rec;
+    sched_log_pos = (sched_log_pos + 1) % FRAME_SCHED_LOG_DEPTH;
+    if (sched_log_count < FRAME_SCHED_LOG_DEPTH) {
+        sched_log_count++;
+    }
+
+    sched_stats.frames++;
+    sched_stats.misses += rec->late;
+    sched_stats.idle_cycles += rec->idle_cycles;
+    sched_stats.busy_cycles += rec->busy_cycles;
+    if (rec->latency_cycles > sched_stats.max_latency_cycles) {
+        sched_stats.max_latency_cycles = rec->latency_cycles;
+    }
+    for (int i = 0; i < sched_num_stages; i++) {
+        sched_stats.stage_cycles[i] += rec->stage_cycles[i];
+        if (rec->stage_cycles[i] > sched_stats.stage_max_cycles[i]) {
+            sched_stats.stage_max_cycles[i] = rec->stage_cycles[i];
+        }
+    }
+}
+
+uint32_t frame_sched_run(void)
+{
+    frame_sched_record_t rec;
+    uint32_t t0 = sched_now();
+    uint32_t t1, ticks, pending, stamp;
+    rv_csr_t mstatus;
+
+    // a tick between the check and the wfi still wakes it, the
+    // interrupt is taken once they are enabled again. the stages run
+    // with MIE as the caller had it
+    mstatus = __RV_CSR_READ_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    while (sched_done == sched_ticks) {
+        __WFI();
+        __RV_CSR_SET(CSR_MSTATUS, MSTATUS_MIE);
+        __RV_CSR_CLEAR(CSR_MSTATUS, MSTATUS_MIE);
+    }
+    __RV_CSR_SET(CSR_MSTATUS, mstatus & MSTATUS_MIE);
+
+    memset(&rec, 0, sizeof(rec));
+    t1 = sched_now();
+    rec.idle_cycles = t1 - t0;
+
+    ticks = sched_ticks;
+    if (ticks - sched_done > FRAME_SCHED_TICK_DEPTH) {
+        sched_stats.dropped += ticks - sched_done - FRAME_SCHED_TICK_DEPTH;
+        sched_done = ticks - FRAME_SCHED_TICK_DEPTH;
+    }
+    rec.frame = sched_done;
+    // the next tick reuses this slot once the backlog is full, so take
+    // the stamp before the stages run
+    stamp = sched_tick_stamp[rec.frame % FRAME_SCHED_TICK_DEPTH];
+
+    for (int i = 0; i < sched_num_stages; i++) {
+        int ret = sched_stages[i].func(sched_stages[i].arg);
+        uint32_t t = sched_now();
+
+        rec.stage_cycles[i] = t - t1;
+        t1 = t;
+        if (ret < 0)
+            break;
+    }
+
+    rec.busy_cycles = t1 - t0 - rec.idle_cycles;
+    rec.latency_cycles = t1 - stamp;
+    rec.late = rec.latency_cycles > sched_period_cycles;
+    sched_done++;
+    pending = sched_ticks - sched_done;
+    rec.backlog = pending > 0xFF ? 0xFF : (uint8_t)pending;
+
+    sched_record(&rec);
+    return rec.frame;
+}
+
+int frame_sched_log_read(frame_sched_record_t *records, int max)
+{
+    int n = 0;
+
+    while (n < max && sched_log_count > 0) {
+        int pos = (sched_log_pos + FRAME_SCHED_LOG_DEPTH - sched_log_count) % FRAME_SCHED_LOG_DEPTH;
+
+        records[n++] = sched_log[pos];
+        sched_log_count--;
+    }
+    return n;
+}
+
+void frame_sched_get_stats(frame_sched_stats_t *stats)
+{
+    *stats = sched_stats;
+}
+
+void frame_sched_reset_stats(void)
+{
+    memset(&sched_stats, 0, sizeof(sched_stats));
+}
+
+void frame_sched_print(void)
+{
+    frame_sched_record_t rec;
+    uint64_t total = sched_stats.idle_cycles + sched_stats.busy_cycles;
+    uint32_t mhz = sched_core_hz / 1000000;
+
+    while (frame_sched_log_read(&rec, 1) == 1) {
+        printf("frame %lu idle %lu busy %lu lat %lu",
+               (unsigned long)rec.frame, (unsigned long)rec.idle_cycles,
+               (unsigned long)rec.busy_cycles, (unsigned long)rec.latency_cycles);
+        for (int i = 0; i < sched_num_stages; i++) {
+            printf(" %lu", (unsigned long)rec.stage_cycles[i]);
+        }
+        printf(" backlog %u%s\r\n", rec.backlog, rec.late ? " LATE" : "");
+    }
+
+    if (sched_stats.frames == 0 || mhz == 0)
+        return;
+    printf("core %lu MHz, period %lu us, frames %lu, misses %lu, dropped %lu, idle %lu/1000, max latency %lu us\r\n",
+           (unsigned long)mhz, (unsigned long)(sched_period_cycles / mhz),
+           (unsigned long)sched_stats.frames, (unsigned long)sched_stats.misses,
+           (unsigned long)sched_stats.dropped,
+           (unsigned long)(total ? sched_stats.idle_cycles * 1000 / total : 0),
+           (unsigned long)(sched_stats.max_latency_cycles / mhz));
+    for (int i = 0; i < sched_num_stages; i++) {
+        printf("  %-8s avg %lu us, max %lu us\r\n",
+               sched_stages[i].name ? sched_stages[i].name : "-",
+               (unsigned long)(sched_stats.stage_cycles[i] / sched_stats.frames / mhz),
+               (unsigned long)(sched_stats.stage_max_cycles[i] / mhz));
+    }
+}